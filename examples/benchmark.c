@@ -1,193 +1,813 @@
 #include "../src/core/floyd_warshall.h"
+#include "../src/core/solver.h"
 #include "../src/utils/memory_manager.h"
-#include "../src/utils/file_io.h"
+#include "../src/utils/trace.h"
+#include "../src/utils/graph_generator.h"
 #include <stdio.h>
 #include <stdlib.h>
-#include <time.h>
+#include <string.h>
+#include <stdint.h>
 #include <math.h>
 
-/* Create a random graph for benchmarking */
-Graph* create_random_graph(int vertices, double density) {
-    Graph *graph = graph_create(vertices);
-    if (!graph) {
+/* Limits for list-valued command line options */
+#define BENCH_MAX_LIST 32
+#define BENCH_MAX_REPS 1000
+#define BENCH_MAX_ROWS 4096
+
+/* Tolerance used when checking engines against the reference kernel */
+#define BENCH_AGREEMENT_TOLERANCE 1e-6
+
+/* Output formats */
+typedef enum {
+    FORMAT_TABLE,
+    FORMAT_CSV,
+    FORMAT_JSON
+} OutputFormat;
+
+/* Benchmark configuration parsed from the command line */
+typedef struct {
+    int sizes[BENCH_MAX_LIST];
+    int size_count;
+    double densities[BENCH_MAX_LIST];
+    int density_count;
+    char families[BENCH_MAX_LIST][32];
+    int family_count;
+    FloydWarshallEngine engines[FW_ENGINE_COUNT];
+    int engine_count;
+    unsigned long long seed;
+    int warmup;
+    int repetitions;
+    OutputFormat format;
+    const char *output_file;
+    const char *baseline_file;
+    double regression_threshold;
+    int batch_count;
+    bool use_solver;
+    FloydWarshallEngine solver_engine;   /* FW_ENGINE_COUNT: the solver's own choice */
+} BenchConfig;
+
+/* One measured configuration */
+typedef struct {
+    char family[32];
+    int vertices;
+    double density;
+    char engine[32];
+    int edges;
+    double median_s;
+    double p95_s;
+    double min_s;
+    double relaxations_per_s;
+    double effective_gbps;
+    bool has_throughput;        /* The relaxation model below applies to the kernel that ran */
+    bool agrees;
+} BenchRow;
+
+/* Baseline entry loaded from a previous CSV run */
+typedef struct {
+    char family[32];
+    int vertices;
+    double density;
+    char engine[32];
+    double median_s;
+} BaselineRow;
+
+/* Build a benchmark graph with the library generator; the seed makes every run identical */
+static Graph* create_benchmark_graph(const char *family, int vertices, double density,
+                                     unsigned long long seed, int *edges) {
+    GraphGeneratorConfig generator;
+    graph_generator_default_config(&generator, graph_family_from_name(family), vertices, density);
+    generator.seed = seed;
+
+    EdgeList list;
+    if (graph_generate_edges(&generator, &list) != SUCCESS) {
         return NULL;
     }
 
-    srand((unsigned int)time(NULL));
-
-    for (int i = 0; i < vertices; i++) {
-        for (int j = 0; j < vertices; j++) {
-            if (i != j && (double)rand() / RAND_MAX < density) {
-                double weight = (double)(rand() % 100 + 1);
-                graph_add_edge(graph, i, j, weight);
-            }
+    Graph *graph = graph_create(vertices);
+    if (graph) {
+        for (int64_t e = 0; e < list.count; e++) {
+            graph_add_edge(graph, list.edges[e].from, list.edges[e].to, list.edges[e].weight);
         }
+        *edges = (int)list.count;
     }
 
+    edge_list_free(&list);
     return graph;
 }
 
-/* Benchmark performance for different graph sizes */
-void benchmark_performance(void) {
-    int sizes[] = {10, 25, 50, 100, 200};
-    int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
-    double density = 0.3; /* 30% edge density */
+static bool is_known_family(const char *family) {
+    return graph_family_from_name(family) != GRAPH_FAMILY_COUNT;
+}
 
-    printf("Floyd-Warshall Algorithm Performance Benchmark\n");
-    printf("==============================================\n\n");
-    printf("Graph Density: %.1f%%\n", density * 100);
-    printf("%-10s %-15s %-15s %-15s %-15s\n",
-           "Vertices", "Std Time(s)", "Opt Time(s)", "Memory(KB)", "Iterations");
-    printf("-----------------------------------------------------------------------\n");
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
 
-    for (int i = 0; i < num_sizes; i++) {
-        reset_memory_tracking();
+/* Nearest-rank percentile of an already sorted sample */
+static double percentile(const double *sorted, int count, double p) {
+    int rank = (int)ceil(p * count);
+    if (rank < 1) {
+        rank = 1;
+    }
+    if (rank > count) {
+        rank = count;
+    }
+    return sorted[rank - 1];
+}
 
-        /* Create random graph */
-        Graph *graph1 = create_random_graph(sizes[i], density);
-        Graph *graph2 = graph_copy(graph1); /* Copy for optimized version */
+static double median(const double *sorted, int count) {
+    if (count % 2 == 1) {
+        return sorted[count / 2];
+    }
+    return 0.5 * (sorted[count / 2 - 1] + sorted[count / 2]);
+}
 
-        if (!graph1 || !graph2) {
-            printf("Failed to create graph with %d vertices\n", sizes[i]);
-            continue;
+static bool distances_agree(const Graph *reference, const Graph *candidate) {
+    int n = reference->vertices;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            double expected = reference->distance[i][j];
+            double actual = candidate->distance[i][j];
+            bool expected_inf = expected >= INFINITY_VALUE;
+            bool actual_inf = actual >= INFINITY_VALUE;
+
+            if (expected_inf != actual_inf) {
+                return false;
+            }
+            if (!expected_inf && fabs(expected - actual) > BENCH_AGREEMENT_TOLERANCE) {
+                return false;
+            }
         }
+    }
+    return true;
+}
 
-        /* Benchmark standard algorithm */
-        FloydWarshallResult std_result = floyd_warshall_execute(graph1);
-
-        /* Benchmark optimized algorithm */
-        FloydWarshallResult opt_result = floyd_warshall_execute_optimized(graph2);
+/*
+ * Kernel an engine actually runs on this graph: the specialized engines hand
+ * graphs outside their precondition (and negative cycles) to the reference
+ * kernel, and the row is then labelled with both names.
+ */
+static FloydWarshallEngine executed_engine(FloydWarshallEngine engine, const Graph *base, bool negative_cycle) {
+    switch (engine) {
+        case FW_ENGINE_DAG:
+            return floyd_warshall_topological_order(base, NULL) ? engine : FW_ENGINE_STANDARD;
+        case FW_ENGINE_BFS:
+            return floyd_warshall_uniform_weight(base, NULL) ? engine : FW_ENGINE_STANDARD;
+        case FW_ENGINE_SMALL:
+            return base->vertices <= FW_SMALL_MAX_VERTICES ? engine : FW_ENGINE_STANDARD;
+        case FW_ENGINE_INTEGER:
+            return floyd_warshall_integral_weights(base) && !negative_cycle ? engine : FW_ENGINE_STANDARD;
+        case FW_ENGINE_MIXED:
+        case FW_ENGINE_SCC:
+            return negative_cycle ? FW_ENGINE_STANDARD : engine;
+        default:
+            return engine;
+    }
+}
 
-        size_t memory_used = get_memory_usage() / 1024; /* Convert to KB */
+/*
+ * Kernels doing n^3 relaxations. Squaring does n^3 per squaring, and scc,
+ * dag and bfs follow the edges instead, so a relaxation rate for them would
+ * not compare with the others.
+ */
+static bool engine_is_cubic(FloydWarshallEngine engine) {
+    return engine != FW_ENGINE_SQUARING && engine != FW_ENGINE_SCC &&
+           engine != FW_ENGINE_DAG && engine != FW_ENGINE_BFS;
+}
 
-        printf("%-10d %-15.6f %-15.6f %-15zu %-15d\n",
-               sizes[i], std_result.execution_time, opt_result.execution_time,
-               memory_used, std_result.iterations);
+/* Kernels that skip relaxations (finite lists, empty tiles, infinite rows, early exit) and count the ones they do */
+static bool engine_skips_work(FloydWarshallEngine engine) {
+    return engine == FW_ENGINE_OPTIMIZED || engine == FW_ENGINE_PRUNED ||
+           engine == FW_ENGINE_BLOCKED || engine == FW_ENGINE_MIXED;
+}
 
-        graph_destroy(graph1);
-        graph_destroy(graph2);
+/*
+ * Throughput model: every relaxation streams one distance element in and
+ * writes it back (2 * n^2 elements per full pivot). The cubic kernels do
+ * n^3 relaxations; the work-skipping ones report their own count, which
+ * saturates at INT_MAX, and a saturated count gives no rate.
+ */
+static void set_throughput(BenchRow *row, FloydWarshallEngine executed, int vertices, int reported) {
+    double n = (double)vertices;
+    double relaxations = n * n * n;
+    size_t element = executed == FW_ENGINE_MIXED ? sizeof(float) : sizeof(double);
+
+    if (!engine_is_cubic(executed)) {
+        return;
     }
-
-    printf("\nBenchmark completed.\n");
+    if (engine_skips_work(executed)) {
+        if (reported >= INT_MAX) {
+            return;
+        }
+        relaxations = (double)reported;
+    }
+    row->has_throughput = true;
+    row->relaxations_per_s = row->median_s > 0.0 ? relaxations / row->median_s : 0.0;
+    row->effective_gbps = row->median_s > 0.0 ? relaxations * 2.0 * element / row->median_s / 1e9 : 0.0;
 }
 
-/* Test algorithm correctness with known results */
-void test_correctness(void) {
-    printf("\nAlgorithm Correctness Test\n");
-    printf("==========================\n");
+/* Measure one engine on one graph; returns false if the engine failed */
+static bool measure_engine(const BenchConfig *config, const Graph *base, const Graph *reference,
+                           FloydWarshallEngine engine, BenchRow *row) {
+    double samples[BENCH_MAX_REPS];
+    Graph *work = NULL;
+    int reported = 0;
+    bool reference_has_cycle = floyd_warshall_detect_negative_cycle(reference);
+
+    for (int run = 0; run < config->warmup + config->repetitions; run++) {
+        graph_destroy(work);
+        work = graph_copy(base);
+        if (!work) {
+            return false;
+        }
+
+        uint64_t start = trace_now_ns();
+        FloydWarshallResult result = floyd_warshall_execute_engine(work, engine);
+        uint64_t end = trace_now_ns();
 
-    /* Test case 1: Simple 4-vertex graph */
-    Graph *graph = graph_create(4);
-    graph_add_edge(graph, 0, 1, 3.0);
-    graph_add_edge(graph, 0, 3, 7.0);
-    graph_add_edge(graph, 1, 0, 8.0);
-    graph_add_edge(graph, 1, 2, 2.0);
-    graph_add_edge(graph, 2, 0, 5.0);
-    graph_add_edge(graph, 2, 3, 1.0);
-    graph_add_edge(graph, 3, 0, 2.0);
+        if (!result.success) {
+            graph_destroy(work);
+            return false;
+        }
+        if (run >= config->warmup) {
+            samples[run - config->warmup] = (double)(end - start) / 1e9;
+        }
+        reported = result.iterations;
+    }
 
-    FloydWarshallResult result = floyd_warshall_execute(graph);
+    /* Distances are undefined under negative cycles, so only the flag is compared */
+    if (reference_has_cycle) {
+        row->agrees = floyd_warshall_detect_negative_cycle(work);
+    } else {
+        row->agrees = distances_agree(reference, work);
+    }
+    graph_destroy(work);
 
-    if (result.success) {
-        printf("Test passed: Standard algorithm\n");
+    qsort(samples, (size_t)config->repetitions, sizeof(double), compare_doubles);
+    row->median_s = median(samples, config->repetitions);
+    row->p95_s = percentile(samples, config->repetitions, 0.95);
+    row->min_s = samples[0];
 
-        /* Verify some known shortest distances */
-        double dist_0_2 = floyd_warshall_get_distance(graph, 0, 2);
-        double dist_1_3 = floyd_warshall_get_distance(graph, 1, 3);
+    FloydWarshallEngine executed = executed_engine(engine, base, reference_has_cycle);
+    set_throughput(row, executed, base->vertices, reported);
+    if (executed == engine) {
+        snprintf(row->engine, sizeof(row->engine), "%s", floyd_warshall_engine_name(engine));
+    } else {
+        snprintf(row->engine, sizeof(row->engine), "%s(%s)", floyd_warshall_engine_name(engine),
+                 floyd_warshall_engine_name(executed));
+    }
+    return true;
+}
 
-        printf("Distance 0->2: %.2f (expected: 5.00)\n", dist_0_2);
-        printf("Distance 1->3: %.2f (expected: 3.00)\n", dist_1_3);
+/* Batch timing also covers the graph_create/execute/destroy loop it replaces */
+typedef struct {
+    double batch_graphs_per_s;
+    double loop_graphs_per_s;
+} BatchThroughput;
+
+/*
+ * Measure the batched engine on config->batch_count graphs of one
+ * configuration (graph g uses seed + g). Every graph is checked against the
+ * reference kernel; the row reports time per graph.
+ */
+static bool measure_batch(const BenchConfig *config, const char *family, int vertices, double density,
+                          unsigned long long seed, BenchRow *row, BatchThroughput *throughput) {
+    int count = config->batch_count;
+    GraphBatch *pristine = graph_batch_create(vertices, count);
+    GraphBatch *work = graph_batch_create(vertices, count);
+    Graph **graphs = (Graph**)calloc((size_t)count, sizeof(Graph*));
+    bool ok = pristine && work && graphs;
+
+    for (int g = 0; ok && g < count; g++) {
+        int edges = 0;
+        graphs[g] = create_benchmark_graph(family, vertices, density, seed + (unsigned long long)g, &edges);
+        ok = graphs[g] && graph_batch_set_graph(pristine, g, graphs[g]) == SUCCESS;
+    }
 
-        if (!result.has_negative_cycle) {
-            printf("No negative cycle detected (correct)\n");
+    size_t elements = (size_t)pristine->groups * vertices * vertices * FW_BATCH_LANES;
+    double batch_samples[BENCH_MAX_REPS];
+    double loop_samples[BENCH_MAX_REPS];
+    for (int run = 0; ok && run < config->warmup + config->repetitions; run++) {
+        memcpy(work->distance, pristine->distance, elements * sizeof(double));
+        memcpy(work->next, pristine->next, elements * sizeof(int64_t));
+        FloydWarshallBatchResult result = floyd_warshall_execute_batch(work);
+        ok = result.success;
+
+        /* The per-graph loop the batch replaces, allocation included */
+        uint64_t start = trace_now_ns();
+        for (int g = 0; ok && g < count; g++) {
+            Graph *single = graph_copy(graphs[g]);
+            ok = single && floyd_warshall_execute_auto(single).success;
+            graph_destroy(single);
         }
-    } else {
-        printf("Test failed: Algorithm execution error\n");
+        uint64_t end = trace_now_ns();
+
+        if (run >= config->warmup) {
+            batch_samples[run - config->warmup] = result.execution_time;
+            loop_samples[run - config->warmup] = (double)(end - start) / 1e9;
+        }
+    }
+
+    row->agrees = ok;
+    for (int g = 0; ok && g < count && row->agrees; g++) {
+        floyd_warshall_execute(graphs[g]);
+        Graph *solved = graph_batch_extract_graph(work, g);
+        if (floyd_warshall_detect_negative_cycle(graphs[g])) {
+            row->agrees = work->negative_cycle[g];
+        } else {
+            row->agrees = solved && distances_agree(graphs[g], solved);
+        }
+        graph_destroy(solved);
     }
 
-    graph_destroy(graph);
+    for (int g = 0; graphs && g < count; g++) {
+        graph_destroy(graphs[g]);
+    }
+    free(graphs);
+    graph_batch_destroy(pristine);
+    graph_batch_destroy(work);
+    if (!ok) {
+        return false;
+    }
 
-    /* Test case 2: Graph with negative cycle */
-    printf("\nTesting negative cycle detection...\n");
-    Graph *neg_graph = graph_create(3);
-    graph_add_edge(neg_graph, 0, 1, 1.0);
-    graph_add_edge(neg_graph, 1, 2, -3.0);
-    graph_add_edge(neg_graph, 2, 0, 1.0);
+    qsort(batch_samples, (size_t)config->repetitions, sizeof(double), compare_doubles);
+    qsort(loop_samples, (size_t)config->repetitions, sizeof(double), compare_doubles);
+    row->median_s = median(batch_samples, config->repetitions) / count;
+    row->p95_s = percentile(batch_samples, config->repetitions, 0.95) / count;
+    row->min_s = batch_samples[0] / count;
+    set_throughput(row, FW_ENGINE_STANDARD, vertices, 0);
+    throughput->batch_graphs_per_s = row->median_s > 0.0 ? 1.0 / row->median_s : 0.0;
+    double loop_median = median(loop_samples, config->repetitions);
+    throughput->loop_graphs_per_s = loop_median > 0.0 ? count / loop_median : 0.0;
+
+    strncpy(row->engine, "batch", sizeof(row->engine) - 1);
+    row->engine[sizeof(row->engine) - 1] = '\0';
+    return true;
+}
 
-    FloydWarshallResult neg_result = floyd_warshall_execute(neg_graph);
+/* Solver timing also covers the copy/execute/destroy loop it replaces */
+typedef struct {
+    double solver_s;
+    double loop_s;
+} SolverLatency;
+
+/*
+ * Measure repeated runs through one persistent Solver: each repetition
+ * reloads base and solves it in place. The comparison loop does what a
+ * caller without the solver does per run: graph_copy, execute, destroy.
+ */
+static bool measure_solver(const BenchConfig *config, const Graph *base, const Graph *reference,
+                           BenchRow *row, SolverLatency *latency) {
+    Solver *solver = solver_create(base->vertices, config->solver_engine);
+    if (!solver) {
+        return false;
+    }
 
-    if (neg_result.success && neg_result.has_negative_cycle) {
-        printf("Negative cycle correctly detected\n");
+    double solver_samples[BENCH_MAX_REPS];
+    double loop_samples[BENCH_MAX_REPS];
+    int reported = 0;
+    bool ok = true;
+    for (int run = 0; ok && run < config->warmup + config->repetitions; run++) {
+        FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
+        uint64_t start = trace_now_ns();
+        ok = solver_load_graph(solver, base) == SUCCESS;
+        if (ok) {
+            result = solver_run(solver);
+        }
+        uint64_t middle = trace_now_ns();
+        ok = ok && result.success;
+        reported = result.iterations;
+
+        Graph *single = graph_copy(base);
+        ok = ok && single && floyd_warshall_execute_engine(single, solver->engine).success;
+        graph_destroy(single);
+        uint64_t end = trace_now_ns();
+
+        if (run >= config->warmup) {
+            solver_samples[run - config->warmup] = (double)(middle - start) / 1e9;
+            loop_samples[run - config->warmup] = (double)(end - middle) / 1e9;
+        }
+    }
+
+    bool reference_has_cycle = floyd_warshall_detect_negative_cycle(reference);
+    if (reference_has_cycle) {
+        row->agrees = ok && floyd_warshall_detect_negative_cycle(solver_graph(solver));
     } else {
-        printf("Failed to detect negative cycle\n");
+        row->agrees = ok && distances_agree(reference, solver_graph(solver));
+    }
+    snprintf(row->engine, sizeof(row->engine), "solver-%s", floyd_warshall_engine_name(solver->engine));
+    FloydWarshallEngine executed = executed_engine(solver->engine, base, reference_has_cycle);
+    solver_destroy(solver);
+    if (!ok) {
+        return false;
     }
 
-    graph_destroy(neg_graph);
+    qsort(solver_samples, (size_t)config->repetitions, sizeof(double), compare_doubles);
+    qsort(loop_samples, (size_t)config->repetitions, sizeof(double), compare_doubles);
+    row->median_s = median(solver_samples, config->repetitions);
+    row->p95_s = percentile(solver_samples, config->repetitions, 0.95);
+    row->min_s = solver_samples[0];
+    set_throughput(row, executed, base->vertices, reported);
+    latency->solver_s = row->median_s;
+    latency->loop_s = median(loop_samples, config->repetitions);
+    return true;
 }
 
-/* Compare standard vs optimized algorithm */
-void compare_algorithms(void) {
-    printf("\nAlgorithm Comparison\n");
-    printf("===================\n");
+static int load_baseline(const char *filename, BaselineRow *rows, int max_rows) {
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        fprintf(stderr, "Error: Cannot open baseline file %s\n", filename);
+        return -1;
+    }
 
-    int test_size = 50;
-    double density = 0.4;
+    char line[MAX_LINE_LENGTH];
+    int count = 0;
+    while (count < max_rows && fgets(line, sizeof(line), file)) {
+        BaselineRow *row = &rows[count];
+        /* Column order matches print_csv_header */
+        if (sscanf(line, "%31[^,],%d,%lf,%31[^,],%*d,%*[^,],%*d,%lf",
+                   row->family, &row->vertices, &row->density, row->engine,
+                   &row->median_s) == 5) {
+            count++;
+        }
+    }
 
-    Graph *graph1 = create_random_graph(test_size, density);
-    Graph *graph2 = graph_copy(graph1);
+    fclose(file);
+    return count;
+}
 
-    if (!graph1 || !graph2) {
-        printf("Failed to create test graphs\n");
-        return;
+static const BaselineRow* find_baseline(const BaselineRow *rows, int count, const BenchRow *row) {
+    for (int i = 0; i < count; i++) {
+        if (rows[i].vertices == row->vertices &&
+            fabs(rows[i].density - row->density) < 1e-9 &&
+            strcmp(rows[i].family, row->family) == 0 &&
+            strcmp(rows[i].engine, row->engine) == 0) {
+            return &rows[i];
+        }
     }
+    return NULL;
+}
 
-    printf("Graph size: %d vertices, %.1f%% density\n", test_size, density * 100);
+static void print_csv_header(FILE *out) {
+    fprintf(out, "family,vertices,density,engine,edges,seed,repetitions,"
+                 "median_s,p95_s,min_s,relaxations_per_s,effective_gbps,agrees\n");
+}
 
-    /* Run standard algorithm */
-    FloydWarshallResult std_result = floyd_warshall_execute(graph1);
+/* Throughput columns; empty (CSV), null (JSON) or "-" (table) when the n^3 model does not apply */
+static void format_throughput(const BenchConfig *config, const BenchRow *row,
+                              char *relaxations, char *gbps, size_t size) {
+    if (row->has_throughput) {
+        snprintf(relaxations, size, config->format == FORMAT_TABLE ? "%.3e" : "%.6e", row->relaxations_per_s);
+        snprintf(gbps, size, config->format == FORMAT_TABLE ? "%.3f" : "%.4f", row->effective_gbps);
+    } else {
+        const char *missing = config->format == FORMAT_CSV ? "" : config->format == FORMAT_JSON ? "null" : "-";
+        snprintf(relaxations, size, "%s", missing);
+        snprintf(gbps, size, "%s", missing);
+    }
+}
 
-    /* Run optimized algorithm */
-    FloydWarshallResult opt_result = floyd_warshall_execute_optimized(graph2);
+static void print_row(FILE *out, const BenchConfig *config, const BenchRow *row, bool first) {
+    char relaxations[32];
+    char gbps[32];
+    format_throughput(config, row, relaxations, gbps, sizeof(relaxations));
+
+    switch (config->format) {
+        case FORMAT_CSV:
+            fprintf(out, "%s,%d,%.4f,%s,%d,%llu,%d,%.9f,%.9f,%.9f,%s,%s,%s\n",
+                    row->family, row->vertices, row->density, row->engine, row->edges,
+                    config->seed, config->repetitions, row->median_s, row->p95_s, row->min_s,
+                    relaxations, gbps, row->agrees ? "yes" : "no");
+            break;
+        case FORMAT_JSON:
+            fprintf(out, "%s  {\"family\": \"%s\", \"vertices\": %d, \"density\": %.4f, "
+                         "\"engine\": \"%s\", \"edges\": %d, \"seed\": %llu, \"repetitions\": %d, "
+                         "\"median_s\": %.9f, \"p95_s\": %.9f, \"min_s\": %.9f, "
+                         "\"relaxations_per_s\": %s, \"effective_gbps\": %s, \"agrees\": %s}",
+                    first ? "" : ",\n", row->family, row->vertices, row->density, row->engine,
+                    row->edges, config->seed, config->repetitions, row->median_s, row->p95_s,
+                    row->min_s, relaxations, gbps, row->agrees ? "true" : "false");
+            break;
+        default:
+            fprintf(out, "%-8s %-8d %-8.3f %-16s %-12.6f %-12.6f %-12s %-8s %-6s\n",
+                    row->family, row->vertices, row->density, row->engine, row->median_s,
+                    row->p95_s, relaxations, gbps, row->agrees ? "yes" : "NO");
+            break;
+    }
+}
 
-    printf("\nResults comparison:\n");
-    printf("Standard algorithm:\n");
-    printf("  Time: %.6f seconds\n", std_result.execution_time);
-    printf("  Iterations: %d\n", std_result.iterations);
+static void print_usage(const char *program_name) {
+    printf("Usage: %s [options]\n", program_name);
+    printf("Options:\n");
+    printf("  --sizes <list>       Vertex counts, comma separated (default 64,128,256)\n");
+    printf("  --densities <list>   Edge densities in [0,1] (default 0.1,0.3)\n");
+    printf("  --families <list>    Graph families: er, grid, rmat, dag, negcycle (default er)\n");
+    printf("  --engines <list>     Engines to run, or 'all' (default all but optimized, whose early\n");
+    printf("                       exit is known to disagree with the reference)\n");
+    printf("  --seed <n>           Generator seed (default 42)\n");
+    printf("  --warmup <n>         Untimed warmup runs per engine (default 1)\n");
+    printf("  --reps <n>           Timed repetitions per engine (default 5)\n");
+    printf("  --format <fmt>       table, csv or json (default table)\n");
+    printf("  --output <file>      Write results to file instead of stdout\n");
+    printf("  --baseline <file>    Compare medians against a previous CSV run\n");
+    printf("  --threshold <frac>   Allowed slowdown vs baseline (default 0.10)\n");
+    printf("  --batch <count>      Also run the batched engine on <count> graphs per configuration\n");
+    printf("                       (times are per graph; graphs/s is reported on stderr)\n");
+    printf("  --solver <engine>    Also time repeated runs through a persistent solver (auto, standard,\n");
+    printf("                       optimized, blocked or small; latency vs copy+execute on stderr)\n");
+    printf("\nEngines that hand a graph to the reference kernel are shown as engine(standard).\n");
+    printf("Relax/s and GB/s count n^3 relaxations (optimized, pruned, blocked and mixed: the ones\n");
+    printf("they report doing) and are left out for squaring, scc, dag and bfs.\n");
+    printf("Exit status is non-zero if an engine disagrees with the reference\n");
+    printf("kernel or regresses beyond the threshold.\n");
+}
 
-    printf("Optimized algorithm:\n");
-    printf("  Time: %.6f seconds\n", opt_result.execution_time);
-    printf("  Iterations: %d\n", opt_result.iterations);
+static int parse_int_list(char *text, int *values, int max_values) {
+    int count = 0;
+    for (char *token = strtok(text, ","); token && count < max_values; token = strtok(NULL, ",")) {
+        values[count++] = atoi(token);
+    }
+    return count;
+}
 
-    if (opt_result.execution_time > 0) {
-        double speedup = std_result.execution_time / opt_result.execution_time;
-        printf("  Speedup: %.2fx\n", speedup);
+static int parse_double_list(char *text, double *values, int max_values) {
+    int count = 0;
+    for (char *token = strtok(text, ","); token && count < max_values; token = strtok(NULL, ",")) {
+        values[count++] = atof(token);
     }
+    return count;
+}
 
-    /* Verify results are identical */
-    bool results_match = true;
-    for (int i = 0; i < graph1->vertices && results_match; i++) {
-        for (int j = 0; j < graph1->vertices && results_match; j++) {
-            if (fabs(graph1->distance[i][j] - graph2->distance[i][j]) > EPSILON) {
-                results_match = false;
+static ReturnCode parse_arguments(int argc, char *argv[], BenchConfig *config) {
+    for (int i = 1; i < argc; i++) {
+        const char *option = argv[i];
+        char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(option, "-h") == 0 || strcmp(option, "--help") == 0) {
+            print_usage(argv[0]);
+            exit(0);
+        }
+        if (!value) {
+            fprintf(stderr, "Error: Missing value for %s\n", option);
+            return ERROR_INVALID_INPUT;
+        }
+        i++;
+
+        if (strcmp(option, "--sizes") == 0) {
+            config->size_count = parse_int_list(value, config->sizes, BENCH_MAX_LIST);
+        } else if (strcmp(option, "--densities") == 0) {
+            config->density_count = parse_double_list(value, config->densities, BENCH_MAX_LIST);
+        } else if (strcmp(option, "--families") == 0) {
+            config->family_count = 0;
+            for (char *token = strtok(value, ","); token && config->family_count < BENCH_MAX_LIST;
+                 token = strtok(NULL, ",")) {
+                if (!is_known_family(token)) {
+                    fprintf(stderr, "Error: Unknown graph family '%s'\n", token);
+                    return ERROR_INVALID_INPUT;
+                }
+                strncpy(config->families[config->family_count], token, 31);
+                config->families[config->family_count][31] = '\0';
+                config->family_count++;
+            }
+        } else if (strcmp(option, "--engines") == 0) {
+            config->engine_count = 0;
+            if (strcmp(value, "all") == 0) {
+                for (int e = 0; e < FW_ENGINE_COUNT; e++) {
+                    config->engines[config->engine_count++] = (FloydWarshallEngine)e;
+                }
+                continue;
+            }
+            for (char *token = strtok(value, ","); token && config->engine_count < FW_ENGINE_COUNT;
+                 token = strtok(NULL, ",")) {
+                FloydWarshallEngine engine = floyd_warshall_engine_from_name(token);
+                if (engine == FW_ENGINE_COUNT) {
+                    fprintf(stderr, "Error: Unknown engine '%s'\n", token);
+                    return ERROR_INVALID_INPUT;
+                }
+                config->engines[config->engine_count++] = engine;
             }
+        } else if (strcmp(option, "--seed") == 0) {
+            config->seed = strtoull(value, NULL, 10);
+        } else if (strcmp(option, "--warmup") == 0) {
+            config->warmup = atoi(value);
+        } else if (strcmp(option, "--reps") == 0) {
+            config->repetitions = atoi(value);
+        } else if (strcmp(option, "--format") == 0) {
+            if (strcmp(value, "csv") == 0) {
+                config->format = FORMAT_CSV;
+            } else if (strcmp(value, "json") == 0) {
+                config->format = FORMAT_JSON;
+            } else if (strcmp(value, "table") == 0) {
+                config->format = FORMAT_TABLE;
+            } else {
+                fprintf(stderr, "Error: Unknown format '%s'\n", value);
+                return ERROR_INVALID_INPUT;
+            }
+        } else if (strcmp(option, "--output") == 0) {
+            config->output_file = value;
+        } else if (strcmp(option, "--baseline") == 0) {
+            config->baseline_file = value;
+        } else if (strcmp(option, "--threshold") == 0) {
+            config->regression_threshold = atof(value);
+        } else if (strcmp(option, "--batch") == 0) {
+            config->batch_count = atoi(value);
+        } else if (strcmp(option, "--solver") == 0) {
+            config->use_solver = true;
+            config->solver_engine = strcmp(value, "auto") == 0 ? FW_ENGINE_COUNT
+                                                               : floyd_warshall_engine_from_name(value);
+            if (config->solver_engine == FW_ENGINE_COUNT && strcmp(value, "auto") != 0) {
+                fprintf(stderr, "Error: Unknown engine '%s'\n", value);
+                return ERROR_INVALID_INPUT;
+            }
+        } else {
+            fprintf(stderr, "Error: Unknown option '%s'\n", option);
+            return ERROR_INVALID_INPUT;
         }
     }
 
-    printf("Results match: %s\n", results_match ? "Yes" : "No");
+    if (config->batch_count < 0) {
+        fprintf(stderr, "Error: Batch count must be non-negative\n");
+        return ERROR_INVALID_INPUT;
+    }
+    if (config->warmup < 0 || config->repetitions < 1 || config->repetitions > BENCH_MAX_REPS) {
+        fprintf(stderr, "Error: Repetitions must be in 1-%d and warmup non-negative\n", BENCH_MAX_REPS);
+        return ERROR_INVALID_INPUT;
+    }
+    for (int s = 0; s < config->size_count; s++) {
+        if (config->sizes[s] <= 0 || config->sizes[s] > MAX_VERTICES) {
+            fprintf(stderr, "Error: Size %d outside 1-%d\n", config->sizes[s], MAX_VERTICES);
+            return ERROR_INVALID_INPUT;
+        }
+    }
+    for (int d = 0; d < config->density_count; d++) {
+        if (config->densities[d] < 0.0 || config->densities[d] > 1.0) {
+            fprintf(stderr, "Error: Density %.3f outside [0,1]\n", config->densities[d]);
+            return ERROR_INVALID_INPUT;
+        }
+    }
 
-    graph_destroy(graph1);
-    graph_destroy(graph2);
+    return SUCCESS;
 }
 
-int main(void) {
-    printf("Floyd-Warshall Algorithm Benchmark Suite\n");
-    printf("========================================\n\n");
+int main(int argc, char *argv[]) {
+    BenchConfig config = {
+        {64, 128, 256}, 3,
+        {0.1, 0.3}, 2,
+        {"er"}, 1,
+        {FW_ENGINE_STANDARD}, 0,
+        42ULL, 1, 5, FORMAT_TABLE, NULL, NULL, 0.10, 0, false, FW_ENGINE_COUNT
+    };
+    for (int e = 0; e < FW_ENGINE_COUNT; e++) {
+        if (e != FW_ENGINE_OPTIMIZED) {
+            config.engines[config.engine_count++] = (FloydWarshallEngine)e;
+        }
+    }
 
-    /* Run tests */
-    test_correctness();
-    benchmark_performance();
-    compare_algorithms();
+    if (parse_arguments(argc, argv, &config) != SUCCESS) {
+        print_usage(argv[0]);
+        return 1;
+    }
 
-    printf("\nBenchmark suite completed.\n");
-    return 0;
-}
\ No newline at end of file
+    static BaselineRow baseline[BENCH_MAX_ROWS];
+    int baseline_count = 0;
+    if (config.baseline_file) {
+        baseline_count = load_baseline(config.baseline_file, baseline, BENCH_MAX_ROWS);
+        if (baseline_count < 0) {
+            return 1;
+        }
+    }
+
+    FILE *out = stdout;
+    if (config.output_file) {
+        out = fopen(config.output_file, "w");
+        if (!out) {
+            fprintf(stderr, "Error: Cannot open output file %s\n", config.output_file);
+            return 1;
+        }
+    }
+
+    if (config.format == FORMAT_CSV) {
+        print_csv_header(out);
+    } else if (config.format == FORMAT_JSON) {
+        fprintf(out, "[\n");
+    } else {
+        fprintf(out, "Floyd-Warshall Benchmark (seed %llu, warmup %d, reps %d)\n",
+                config.seed, config.warmup, config.repetitions);
+        fprintf(out, "%-8s %-8s %-8s %-16s %-12s %-12s %-12s %-8s %-6s\n",
+                "Family", "Vertices", "Density", "Engine", "Median(s)", "P95(s)",
+                "Relax/s", "GB/s", "Agree");
+        fprintf(out, "--------------------------------------------------------------------------------------------\n");
+    }
+
+    int disagreements = 0;
+    int regressions = 0;
+    bool first_row = true;
+
+    for (int f = 0; f < config.family_count; f++) {
+        for (int s = 0; s < config.size_count; s++) {
+            for (int d = 0; d < config.density_count; d++) {
+                int edges = 0;
+                /* Seed is mixed with the configuration so each graph is independent but reproducible */
+                unsigned long long graph_seed = config.seed ^ ((unsigned long long)config.sizes[s] << 32)
+                                                ^ (unsigned long long)(config.densities[d] * 1e6) ^ (unsigned long long)f;
+                Graph *base = create_benchmark_graph(config.families[f], config.sizes[s],
+                                                     config.densities[d], graph_seed, &edges);
+                Graph *reference = graph_copy(base);
+                if (!base || !reference) {
+                    fprintf(stderr, "Error: Failed to create %s graph with %d vertices\n",
+                            config.families[f], config.sizes[s]);
+                    graph_destroy(base);
+                    graph_destroy(reference);
+                    continue;
+                }
+                floyd_warshall_execute_engine(reference, FW_ENGINE_STANDARD);
+
+                /* The batched engine and the solver, if requested, are extra rows after the engines */
+                int batch_rows = config.batch_count > 0 ? 1 : 0;
+                int row_count = config.engine_count + batch_rows + (config.use_solver ? 1 : 0);
+                for (int e = 0; e < row_count; e++) {
+                    bool batched = batch_rows && e == config.engine_count;
+                    bool solved = e == config.engine_count + batch_rows;
+                    BenchRow row;
+                    BatchThroughput throughput = {0.0, 0.0};
+                    SolverLatency latency = {0.0, 0.0};
+                    memset(&row, 0, sizeof(row));
+                    strncpy(row.family, config.families[f], sizeof(row.family) - 1);
+                    row.vertices = config.sizes[s];
+                    row.density = config.densities[d];
+                    row.edges = edges;
+
+                    bool measured;
+                    if (batched) {
+                        measured = measure_batch(&config, config.families[f], config.sizes[s], config.densities[d],
+                                                 graph_seed, &row, &throughput);
+                    } else if (solved) {
+                        measured = measure_solver(&config, base, reference, &row, &latency);
+                    } else {
+                        measured = measure_engine(&config, base, reference, config.engines[e], &row);
+                    }
+                    if (!measured) {
+                        fprintf(stderr, "Error: Engine %s failed on %s/%d/%.3f\n",
+                                batched ? "batch" : solved ? "solver" : floyd_warshall_engine_name(config.engines[e]),
+                                row.family, row.vertices, row.density);
+                        disagreements++;
+                        continue;
+                    }
+
+                    print_row(out, &config, &row, first_row);
+                    first_row = false;
+
+                    if (batched) {
+                        fprintf(stderr, "batch %s/%d/%.3f: %.0f graphs/s (per-graph loop %.0f graphs/s, %.2fx)\n",
+                                row.family, row.vertices, row.density, throughput.batch_graphs_per_s,
+                                throughput.loop_graphs_per_s,
+                                throughput.loop_graphs_per_s > 0.0
+                                    ? throughput.batch_graphs_per_s / throughput.loop_graphs_per_s : 0.0);
+                    }
+                    if (solved) {
+                        fprintf(stderr, "%s %s/%d/%.3f: %.1f us/run (copy+execute loop %.1f us/run, %.2fx)\n",
+                                row.engine, row.family, row.vertices, row.density, latency.solver_s * 1e6,
+                                latency.loop_s * 1e6, latency.solver_s > 0.0 ? latency.loop_s / latency.solver_s : 0.0);
+                    }
+
+                    if (!row.agrees) {
+                        disagreements++;
+                    }
+
+                    const BaselineRow *previous = find_baseline(baseline, baseline_count, &row);
+                    if (previous && previous->median_s > 0.0) {
+                        double ratio = row.median_s / previous->median_s;
+                        bool regressed = ratio > 1.0 + config.regression_threshold;
+                        fprintf(stderr, "%s %s/%d/%.3f: %.3fx of baseline median%s\n",
+                                row.engine, row.family, row.vertices, row.density, ratio,
+                                regressed ? " (REGRESSION)" : "");
+                        if (regressed) {
+                            regressions++;
+                        }
+                    }
+                }
+
+                graph_destroy(base);
+                graph_destroy(reference);
+            }
+        }
+    }
+
+    if (config.format == FORMAT_JSON) {
+        fprintf(out, "\n]\n");
+    }
+    if (out != stdout) {
+        fclose(out);
+    }
+
+    if (disagreements > 0) {
+        fprintf(stderr, "%d engine result(s) disagree with the reference kernel\n", disagreements);
+    }
+    if (regressions > 0) {
+        fprintf(stderr, "%d configuration(s) regressed beyond %.0f%%\n",
+                regressions, config.regression_threshold * 100.0);
+    }
+
+    return (disagreements > 0 || regressions > 0) ? 1 : 0;
+}
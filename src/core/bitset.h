@@ -0,0 +1,41 @@
+#ifndef BITSET_H
+#define BITSET_H
+
+#include <stdint.h>
+
+/*
+ * Word helpers for the 64-bit bitset rows shared by the reachability matrix,
+ * the BFS engine and the negative-cycle marks. GCC and Clang get the
+ * builtins (popcnt/tzcnt where the target has them); other compilers a
+ * portable loop.
+ */
+
+/* Number of set bits */
+static inline int bitset_popcount(uint64_t word) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(word);
+#else
+    int count = 0;
+    while (word) {
+        word &= word - 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+/* Index of the lowest set bit; word must not be 0 */
+static inline int bitset_lowest_bit(uint64_t word) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    int bit = 0;
+    while (!(word & 1ULL)) {
+        word >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+#endif /* BITSET_H */
@@ -11,6 +11,30 @@
 /* Infinity representation for unreachable vertices */
 #define INFINITY_VALUE 1e9
 
+/* Tile edge length (in vertices) used by the blocked engine */
+#define FW_TILE_SIZE 64
+
+/* Largest leaf tile edge of the recursive engine (three tiles fit in L1/L2) */
+#define FW_RECURSIVE_BASE 32
+
+/* Graphs interleaved per group by the batched engine (one SIMD lane each) */
+#define FW_BATCH_LANES 8
+
+/* Largest vertex count handled by the compile-time specialized small kernels */
+#define FW_SMALL_MAX_VERTICES 64
+
+/* Bound on |shortest path length| for the int32 kernel (sums of two stay well inside int32) */
+#define FW_INTEGER_PATH_LIMIT (1 << 28)
+
+/* Upper bound on worker processes of the distributed engine */
+#define FW_DISTRIBUTED_MAX_PROCESSES 64
+
+/* Default wall time between checkpoints (seconds) */
+#define FW_CHECKPOINT_INTERVAL 60.0
+
+/* Minimum time between progress reports on the command line (milliseconds) */
+#define FW_PROGRESS_INTERVAL_MS 500
+
 /* Epsilon for floating point comparisons */
 #define EPSILON 1e-9
 
@@ -27,7 +51,8 @@ typedef enum {
     ERROR_INVALID_INPUT = -2,
     ERROR_FILE_IO = -3,
     ERROR_NEGATIVE_CYCLE = -4,
-    ERROR_NULL_POINTER = -5
+    ERROR_NULL_POINTER = -5,
+    ERROR_COMMUNICATION = -6
 } ReturnCode;
 
 /* Boolean type for older C standards */
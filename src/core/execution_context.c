@@ -0,0 +1,118 @@
+#include "execution_context.h"
+#include "../utils/trace.h"
+#include <stddef.h>
+
+#if defined(__GNUC__)
+__thread ExecutionContext *execution_current = NULL;
+#define CANCEL_LOAD(flag) __atomic_load_n(&(flag), __ATOMIC_ACQUIRE)
+#define CANCEL_STORE(flag) __atomic_store_n(&(flag), 1, __ATOMIC_RELEASE)
+#else
+ExecutionContext *execution_current = NULL;
+#define CANCEL_LOAD(flag) (flag)
+#define CANCEL_STORE(flag) ((flag) = 1)
+#endif
+
+void execution_context_init(ExecutionContext *context, ExecutionProgressCallback progress,
+                            void *user_data, int progress_interval_ms) {
+    if (!context) {
+        return;
+    }
+
+    context->progress = progress;
+    context->user_data = user_data;
+    context->progress_interval_ms = progress_interval_ms > 0 ? progress_interval_ms : 0;
+    context->cancel_requested = 0;
+    context->parent = NULL;
+    context->status = EXECUTION_COMPLETE;
+    context->pivots_done = 0;
+    context->pivots_total = 0;
+    context->start_ns = 0;
+    context->last_report_ns = 0;
+    context->first_pivot = -1;
+    context->stopped = false;
+}
+
+void execution_context_cancel(ExecutionContext *context) {
+    if (context) {
+        CANCEL_STORE(context->cancel_requested);
+    }
+}
+
+bool execution_context_cancelled(const ExecutionContext *context) {
+    for (; context; context = context->parent) {
+        if (CANCEL_LOAD(context->cancel_requested)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void execution_begin(ExecutionContext *context) {
+    context->status = EXECUTION_COMPLETE;
+    context->pivots_done = 0;
+    context->pivots_total = 0;
+    context->stopped = false;
+    context->start_ns = trace_now_ns();
+    context->last_report_ns = context->start_ns;
+    context->first_pivot = -1;
+    execution_current = context;
+}
+
+static void invoke_progress(ExecutionContext *context, uint64_t now, long long relaxations) {
+    ExecutionProgress progress;
+    progress.pivots_done = context->pivots_done;
+    progress.pivots_total = context->pivots_total;
+    progress.relaxations = relaxations;
+    progress.elapsed_seconds = (double)(now - context->start_ns) / 1e9;
+    progress.relaxations_per_second = progress.elapsed_seconds > 0.0 ?
+                                      (double)relaxations / progress.elapsed_seconds : 0.0;
+
+    /* Pivots cost about the same, so the time per pivot so far extrapolates */
+    int measured = context->pivots_done - (context->first_pivot > 0 ? context->first_pivot : 0);
+    progress.eta_seconds = -1.0;
+    if (measured > 0) {
+        progress.eta_seconds = progress.elapsed_seconds / measured *
+                               (context->pivots_total - context->pivots_done);
+    }
+
+    context->last_report_ns = now;
+    context->progress(&progress, context->user_data);
+}
+
+bool execution_report(ExecutionContext *context, int pivots_done, int pivots_total, long long relaxations) {
+    if (context->first_pivot < 0) {
+        context->first_pivot = pivots_done;
+    }
+    context->pivots_done = pivots_done;
+    context->pivots_total = pivots_total;
+
+    if (context->progress) {
+        uint64_t now = trace_now_ns();
+        if (now - context->last_report_ns >= (uint64_t)context->progress_interval_ms * 1000000ULL) {
+            invoke_progress(context, now, relaxations);
+        }
+    }
+
+    if (pivots_done < pivots_total && execution_context_cancelled(context)) {
+        context->stopped = true;
+        return true;
+    }
+    return false;
+}
+
+void execution_end(ExecutionContext *context, bool success, long long relaxations) {
+    execution_current = NULL;
+
+    if (!success) {
+        context->status = EXECUTION_FAILED;
+    } else if (context->stopped) {
+        context->status = EXECUTION_CANCELLED;
+    } else {
+        /* Early-terminating engines finish before their last pivot */
+        context->status = EXECUTION_COMPLETE;
+        context->pivots_done = context->pivots_total;
+        if (context->progress) {
+            invoke_progress(context, trace_now_ns(), relaxations);
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#ifndef EXECUTION_CONTEXT_H
+#define EXECUTION_CONTEXT_H
+
+#include <stdint.h>
+#include "constants.h"
+
+/* Snapshot passed to the progress callback */
+typedef struct {
+    int pivots_done;                /* Pivots applied (squaring engine: rounds) */
+    int pivots_total;
+    long long relaxations;          /* Relaxations performed so far */
+    double elapsed_seconds;
+    double relaxations_per_second;
+    double eta_seconds;             /* Estimated time left, -1 before the first pivot */
+} ExecutionProgress;
+
+typedef void (*ExecutionProgressCallback)(const ExecutionProgress *progress, void *user_data);
+
+/* How a run under a context ended */
+typedef enum {
+    EXECUTION_COMPLETE = 0,         /* Ran to the end */
+    EXECUTION_CANCELLED,            /* Stopped at a pivot (or pivot tile/round) boundary */
+    EXECUTION_FAILED                /* The engine reported failure */
+} ExecutionStatus;
+
+/*
+ * Progress reporting and cooperative cancellation for one run. Engines poll
+ * the context only at pivot, pivot tile or round boundaries, never in their
+ * inner loops. After a cancelled run the matrices hold the state after
+ * pivots_done pivots: every distance is a real path length, shortest over
+ * paths whose intermediates are vertices 0..pivots_done-1 (for the blocked
+ * engine whole pivot tiles, for the recursive engine whole top-level
+ * k-blocks, for the squaring engine paths of at most 2^pivots_done edges;
+ * the mixed engine keeps the float kernel's paths at their exact length,
+ * and the component solver stops before writing anything). The small
+ * kernels do not poll.
+ */
+typedef struct ExecutionContext {
+    ExecutionProgressCallback progress;   /* Optional; also called once on completion */
+    void *user_data;
+    int progress_interval_ms;             /* Minimum time between callbacks */
+    volatile int cancel_requested;        /* Set through execution_context_cancel */
+    const struct ExecutionContext *parent; /* Cancelling the parent cancels this one too (may be NULL) */
+
+    /* Results, valid after the run returns */
+    ExecutionStatus status;
+    int pivots_done;
+    int pivots_total;
+
+    /* Internal */
+    uint64_t start_ns;
+    uint64_t last_report_ns;
+    int first_pivot;                      /* Pivots already done at the first report (resumed runs) */
+    bool stopped;
+} ExecutionContext;
+
+void execution_context_init(ExecutionContext *context, ExecutionProgressCallback progress,
+                            void *user_data, int progress_interval_ms);
+
+/* Request cancellation; safe from any thread and from signal handlers */
+void execution_context_cancel(ExecutionContext *context);
+bool execution_context_cancelled(const ExecutionContext *context);
+
+/* Context of the run in progress on this thread (NULL: none) */
+#if defined(__GNUC__)
+extern __thread ExecutionContext *execution_current;
+#else
+extern ExecutionContext *execution_current;
+#endif
+
+void execution_begin(ExecutionContext *context);
+void execution_end(ExecutionContext *context, bool success, long long relaxations);
+bool execution_report(ExecutionContext *context, int pivots_done, int pivots_total, long long relaxations);
+
+/*
+ * Engine hook, called between pivots with the pivots done so far. Returns
+ * true if the engine must stop. Without a context it costs one load and a
+ * branch.
+ */
+static inline bool execution_boundary(int pivots_done, int pivots_total, long long relaxations) {
+    return execution_current && execution_report(execution_current, pivots_done, pivots_total, relaxations);
+}
+
+#endif /* EXECUTION_CONTEXT_H */
@@ -1,12 +1,122 @@
 #include "floyd_warshall.h"
+#include "pivot.h"
 #include "../utils/memory_manager.h"
+#include "../utils/trace.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
 #include <math.h>
+#include <string.h>
+#include <stdarg.h>
 
+/* Reference kernel; floyd_warshall_execute_auto picks a specialized engine instead */
 FloydWarshallResult floyd_warshall_execute(Graph *graph) {
-    FloydWarshallResult result = {false, 0.0, 0, false, -1};
+    return floyd_warshall_execute_checked(graph, FW_NEGATIVE_CYCLE_COMPLETE, NULL);
+}
+
+/* Write one detection message into the caller's buffer, if there is one */
+static void set_reason(char *reason, size_t reason_size, const char *format, ...) {
+    if (!reason || reason_size == 0) {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    vsnprintf(reason, reason_size, format, args);
+    va_end(args);
+}
+
+/*
+ * Small graphs go to the specialized kernels, uniform weights to per-source
+ * BFS, acyclic graphs (every component a single vertex) to the
+ * topological-order engine, graphs that split into strongly connected
+ * components of at most half the vertices to the component solver, and
+ * integral weights to the int32 kernel; all produce the reference result.
+ */
+FloydWarshallEngine floyd_warshall_select_engine(const Graph *graph, char *reason, size_t reason_size) {
+    set_reason(reason, reason_size, "%s", "");
+    if (!graph || !graph->is_initialized) {
+        return FW_ENGINE_STANDARD;
+    }
+
+    int n = graph->vertices;
+    if (n <= FW_SMALL_MAX_VERTICES) {
+        set_reason(reason, reason_size, "Small graph detected (%d <= %d vertices)", n, FW_SMALL_MAX_VERTICES);
+        return FW_ENGINE_SMALL;
+    }
+
+    double weight;
+    if (floyd_warshall_uniform_weight(graph, &weight)) {
+        set_reason(reason, reason_size, "Uniform edge weight %g detected", weight);
+        return FW_ENGINE_BFS;
+    }
+
+    FloydWarshallEngine engine = FW_ENGINE_STANDARD;
+    SccDecomposition *scc = scc_decompose(graph);
+    if (scc && scc->count == n) {
+        set_reason(reason, reason_size, "Acyclic graph detected");
+        engine = FW_ENGINE_DAG;
+    } else if (scc && scc->largest <= n / 2) {
+        set_reason(reason, reason_size, "%d strongly connected components detected (largest %d vertices)",
+                   scc->count, scc->largest);
+        engine = FW_ENGINE_SCC;
+    }
+    scc_destroy(scc);
+    if (engine != FW_ENGINE_STANDARD) {
+        return engine;
+    }
+
+    if (floyd_warshall_integral_weights(graph)) {
+        set_reason(reason, reason_size, "Integral weights detected");
+        return FW_ENGINE_INTEGER;
+    }
+    return FW_ENGINE_STANDARD;
+}
+
+FloydWarshallResult floyd_warshall_execute_auto(Graph *graph) {
+    return floyd_warshall_execute_engine(graph, floyd_warshall_select_engine(graph, NULL, 0));
+}
+
+/*
+ * Before pivot k is applied, d[i][i] can only turn negative through
+ * d[i][k] + d[k][i], so an O(n) scan per pivot finds the first negative
+ * cycle at the moment it appears, while next still holds consistent paths.
+ * Returns the vertex closing the cycle, or -1.
+ */
+static int find_negative_closure(const Graph *graph, int k) {
+    const double *distance_k = graph->distance[k];
+    for (int i = 0; i < graph->vertices; i++) {
+        if (graph->distance[i][k] < INFINITY_VALUE && distance_k[i] < INFINITY_VALUE &&
+            graph->distance[i][k] + distance_k[i] < -EPSILON) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int floyd_warshall_relax_pivot(Graph *graph, int k) {
+    int n = graph->vertices;
+
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            /* Check for overflow and valid paths */
+            if (graph->distance[i][k] < INFINITY_VALUE &&
+                graph->distance[k][j] < INFINITY_VALUE) {
+
+                double new_distance = graph->distance[i][k] + graph->distance[k][j];
+
+                if (new_distance < graph->distance[i][j]) {
+                    graph->distance[i][j] = new_distance;
+                    graph->next[i][j] = graph->next[i][k];
+                }
+            }
+        }
+    }
+    return n * n;
+}
+
+FloydWarshallResult floyd_warshall_execute_checked(Graph *graph, NegativeCycleMode mode,
+                                                   NegativeCycleInfo *info) {
+    FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
 
     if (!graph || !graph->is_initialized) {
         return result;
@@ -19,35 +129,50 @@ FloydWarshallResult floyd_warshall_execute(Graph *graph) {
     clock_t start_time = clock();
     int n = graph->vertices;
     int iterations = 0;
+    bool watch = (mode == FW_NEGATIVE_CYCLE_ABORT || info != NULL);
+    bool found = false;
 
     /* Floyd-Warshall algorithm main loop */
     for (int k = 0; k < n; k++) {
-        for (int i = 0; i < n; i++) {
-            for (int j = 0; j < n; j++) {
-                iterations++;
-
-                /* Check for overflow and valid paths */
-                if (graph->distance[i][k] < INFINITY_VALUE &&
-                    graph->distance[k][j] < INFINITY_VALUE) {
-
-                    double new_distance = graph->distance[i][k] + graph->distance[k][j];
-
-                    if (new_distance < graph->distance[i][j]) {
-                        graph->distance[i][j] = new_distance;
-                        graph->next[i][j] = graph->next[i][k];
-                    }
+        if (execution_boundary(k, n, iterations)) {
+            break;
+        }
+        if (watch && !found) {
+            int closing = find_negative_closure(graph, k);
+            if (closing >= 0) {
+                found = true;
+                result.negative_cycle_vertex = closing;
+                if (info) {
+                    negative_cycle_extract(graph, closing, k, info);
                 }
             }
         }
+        if (found && mode == FW_NEGATIVE_CYCLE_ABORT) {
+            break;
+        }
+
+        TRACE_BEGIN(pivot_span);
+        iterations += floyd_warshall_relax_pivot(graph, k);
+        TRACE_END(pivot_span, "pivot", "kernel", "k", k);
     }
 
-    /* Check for negative cycles */
-    for (int i = 0; i < n; i++) {
-        if (graph->distance[i][i] < -EPSILON) {
-            result.has_negative_cycle = true;
-            result.negative_cycle_vertex = i;
-            break;
+    if (found && mode == FW_NEGATIVE_CYCLE_ABORT) {
+        /* Distances are partial; only the yes/no answer and the cycle are meaningful */
+        result.has_negative_cycle = true;
+    } else {
+        /* Check for negative cycles */
+        TRACE_BEGIN(scan_span);
+        for (int i = 0; i < n && !found; i++) {
+            if (graph->distance[i][i] < -EPSILON) {
+                found = true;
+                result.negative_cycle_vertex = i;
+            }
+        }
+        result.has_negative_cycle = found;
+        if (found && info) {
+            negative_cycle_mark_unbounded(graph, info);
         }
+        TRACE_END(scan_span, "negative_cycle_scan", "phase", NULL, TRACE_NO_ARG);
     }
 
     clock_t end_time = clock();
@@ -72,12 +197,12 @@ int* floyd_warshall_get_path(const Graph *graph, int start, int end, int *path_l
         return NULL;
     }
 
-    /* Count path length */
+    /* Count path length (a simple path visits at most every vertex once) */
     int count = 1;
     int current = start;
     while (current != end) {
         current = graph->next[current][end];
-        if (current == -1) {
+        if (current == -1 || count == graph->vertices) {
             *path_length = 0;
             return NULL;
         }
@@ -127,6 +252,99 @@ bool floyd_warshall_detect_negative_cycle(const Graph *graph) {
     return false;
 }
 
+/* Hop state of a vertex for one target during floyd_warshall_repair_next */
+enum { HOP_UNKNOWN = 0, HOP_WALKING, HOP_GOOD, HOP_BAD };
+
+/* Mark the hop chains towards target; returns the number of vertices that never reach it */
+static int classify_hops(const Graph *graph, int target, unsigned char *state, int *walk) {
+    int n = graph->vertices;
+    int bad = 0;
+    memset(state, HOP_UNKNOWN, (size_t)n);
+    state[target] = HOP_GOOD;
+
+    for (int v = 0; v < n; v++) {
+        if (state[v] != HOP_UNKNOWN || graph->distance[v][target] >= INFINITY_VALUE) {
+            continue;
+        }
+
+        int length = 0;
+        int current = v;
+        while (current >= 0 && state[current] == HOP_UNKNOWN &&
+               graph->distance[current][target] < INFINITY_VALUE) {
+            state[current] = HOP_WALKING;
+            walk[length++] = current;
+            current = graph->next[current][target];
+        }
+
+        unsigned char outcome = (current >= 0 && state[current] == HOP_GOOD) ? HOP_GOOD : HOP_BAD;
+        for (int w = 0; w < length; w++) {
+            state[walk[w]] = outcome;
+        }
+        bad += outcome == HOP_BAD ? length : 0;
+    }
+    return bad;
+}
+
+/*
+ * An edge i -> a is on some shortest path only if nothing beat it, so its
+ * entry was never improved: next[i][a] is still a and distance[i][a] is its
+ * weight. Every shortest path to target is made of such tight edges, so a
+ * breadth-first search backwards from the vertices whose chains already
+ * arrive reaches every vertex stuck on a zero-weight cycle, and each one
+ * points at a vertex settled before it.
+ */
+static int rehang_hops(Graph *graph, int target, unsigned char *state, int *queue) {
+    int n = graph->vertices;
+    int head = 0, tail = 0;
+    for (int v = 0; v < n; v++) {
+        if (state[v] == HOP_GOOD) {
+            queue[tail++] = v;
+        }
+    }
+
+    int repaired = 0;
+    while (head < tail) {
+        int a = queue[head++];
+        double distance_a = graph->distance[a][target];
+        for (int i = 0; i < n; i++) {
+            if (state[i] != HOP_BAD || graph->next[i][a] != a) {
+                continue;
+            }
+            double distance_i = graph->distance[i][target];
+            if (fabs(graph->distance[i][a] + distance_a - distance_i) <= EPSILON * (1.0 + fabs(distance_i))) {
+                graph->next[i][target] = a;
+                state[i] = HOP_GOOD;
+                queue[tail++] = i;
+                repaired++;
+            }
+        }
+    }
+
+    /* Left over only if rounding hid every tight edge: no path beats a hang */
+    for (int i = 0; i < n; i++) {
+        if (state[i] == HOP_BAD) {
+            graph->next[i][target] = -1;
+        }
+    }
+    return repaired;
+}
+
+int floyd_warshall_repair_next(Graph *graph) {
+    if (!graph || !graph->is_initialized || graph->vertices > MAX_VERTICES) {
+        return 0;
+    }
+
+    unsigned char state[MAX_VERTICES];
+    int scratch[MAX_VERTICES];
+    int repaired = 0;
+    for (int target = 0; target < graph->vertices; target++) {
+        if (classify_hops(graph, target, state, scratch) > 0) {
+            repaired += rehang_hops(graph, target, state, scratch);
+        }
+    }
+    return repaired;
+}
+
 void floyd_warshall_print_result(const FloydWarshallResult *result) {
     if (!result) {
         return;
@@ -137,6 +355,12 @@ void floyd_warshall_print_result(const FloydWarshallResult *result) {
     printf("Execution time: %.6f seconds\n", result->execution_time);
     printf("Iterations performed: %d\n", result->iterations);
     printf("Negative cycle detected: %s\n", result->has_negative_cycle ? "Yes" : "No");
+    if (result->tiles_skipped > 0) {
+        printf("Tile updates skipped: %d\n", result->tiles_skipped);
+    }
+    if (result->repaired_entries > 0) {
+        printf("Entries repaired in double: %d\n", result->repaired_entries);
+    }
 
     if (result->has_negative_cycle && result->negative_cycle_vertex != -1) {
         printf("Negative cycle location: vertex %d\n", result->negative_cycle_vertex);
@@ -185,7 +409,7 @@ void floyd_warshall_print_path(const Graph *graph, int start, int end) {
 }
 
 FloydWarshallResult floyd_warshall_execute_optimized(Graph *graph) {
-    FloydWarshallResult result = {false, 0.0, 0, false, -1};
+    FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
 
     if (!graph || !graph->is_initialized) {
         return result;
@@ -197,11 +421,15 @@ FloydWarshallResult floyd_warshall_execute_optimized(Graph *graph) {
 
     clock_t start_time = clock();
     int n = graph->vertices;
-    int iterations = 0;
+    long long iterations = 0;
     bool changed = true;
 
     /* Optimized version with early termination */
     for (int k = 0; k < n && changed; k++) {
+        if (execution_boundary(k, n, iterations)) {
+            break;
+        }
+        TRACE_BEGIN(pivot_span);
         changed = false;
 
         for (int i = 0; i < n; i++) {
@@ -221,9 +449,11 @@ FloydWarshallResult floyd_warshall_execute_optimized(Graph *graph) {
                 }
             }
         }
+        TRACE_END(pivot_span, "pivot", "kernel", "k", k);
     }
 
     /* Check for negative cycles */
+    TRACE_BEGIN(scan_span);
     for (int i = 0; i < n; i++) {
         if (graph->distance[i][i] < -EPSILON) {
             result.has_negative_cycle = true;
@@ -231,11 +461,174 @@ FloydWarshallResult floyd_warshall_execute_optimized(Graph *graph) {
             break;
         }
     }
+    TRACE_END(scan_span, "negative_cycle_scan", "phase", NULL, TRACE_NO_ARG);
 
     clock_t end_time = clock();
     result.execution_time = ((double)(end_time - start_time)) / CLOCKS_PER_SEC;
-    result.iterations = iterations;
+    result.iterations = iterations > INT_MAX ? INT_MAX : (int)iterations;
     result.success = true;
 
     return result;
-}
\ No newline at end of file
+}
+
+FloydWarshallResult floyd_warshall_execute_engine(Graph *graph, FloydWarshallEngine engine) {
+    switch (engine) {
+        case FW_ENGINE_STANDARD:
+            return floyd_warshall_execute_checked(graph, FW_NEGATIVE_CYCLE_COMPLETE, NULL);
+        case FW_ENGINE_OPTIMIZED:
+            return floyd_warshall_execute_optimized(graph);
+        case FW_ENGINE_PRUNED:
+            return floyd_warshall_execute_pruned(graph);
+        case FW_ENGINE_BLOCKED:
+            return floyd_warshall_execute_blocked(graph);
+        case FW_ENGINE_RECURSIVE:
+            return floyd_warshall_execute_recursive(graph);
+        case FW_ENGINE_SQUARING:
+            return floyd_warshall_execute_squaring(graph);
+        case FW_ENGINE_SMALL:
+            return floyd_warshall_execute_small(graph);
+        case FW_ENGINE_MIXED:
+            return floyd_warshall_execute_mixed(graph);
+        case FW_ENGINE_INTEGER:
+            return floyd_warshall_execute_integer(graph);
+        case FW_ENGINE_SCC:
+            return floyd_warshall_execute_scc(graph);
+        case FW_ENGINE_DAG:
+            return floyd_warshall_execute_dag(graph);
+        case FW_ENGINE_BFS:
+            return floyd_warshall_execute_bfs(graph);
+        default: {
+            FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
+            return result;
+        }
+    }
+}
+
+FloydWarshallResult floyd_warshall_execute_context(Graph *graph, FloydWarshallEngine engine,
+                                                   ExecutionContext *context) {
+    if (!context) {
+        return floyd_warshall_execute_engine(graph, engine);
+    }
+
+    /* Engines without pivot boundaries (small) only report completion */
+    execution_begin(context);
+    context->pivots_total = (graph && graph->is_initialized) ? graph->vertices : 0;
+    FloydWarshallResult result = floyd_warshall_execute_engine(graph, engine);
+    execution_end(context, result.success, result.iterations);
+    return result;
+}
+
+FloydWarshallResult floyd_warshall_execute_reduced(Graph *graph, GraphReduction *reduction,
+                                                   FloydWarshallEngine engine) {
+    FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
+
+    if (!graph || !graph->is_initialized || !reduction || reduction->vertices != graph->vertices) {
+        return result;
+    }
+
+    clock_t start_time = clock();
+    result = floyd_warshall_execute_engine(reduction->core, engine);
+
+    /* A negative cycle in the core says nothing about the removed vertices */
+    if (result.success && result.has_negative_cycle) {
+        result = floyd_warshall_execute_engine(graph, engine);
+    } else if (result.success) {
+        TRACE_BEGIN(expand_span);
+        result.success = reduction_expand(reduction, graph) == SUCCESS;
+        TRACE_END(expand_span, "reduction_expand", "phase", "steps", reduction->step_count);
+    }
+
+    result.execution_time = ((double)(clock() - start_time)) / CLOCKS_PER_SEC;
+    return result;
+}
+
+FloydWarshallResult floyd_warshall_execute_reordered(Graph *graph, const VertexOrder *order,
+                                                     FloydWarshallEngine engine) {
+    FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
+
+    clock_t start_time = clock();
+    Graph *permuted = vertex_order_apply(order, graph);
+    if (!permuted) {
+        return result;
+    }
+
+    result = floyd_warshall_execute_engine(permuted, engine);
+    if (result.success) {
+        result.success = vertex_order_restore(order, permuted, graph) == SUCCESS;
+    }
+    if (result.negative_cycle_vertex >= 0) {
+        result.negative_cycle_vertex = order->order[result.negative_cycle_vertex];
+    }
+    graph_destroy(permuted);
+
+    result.execution_time = ((double)(clock() - start_time)) / CLOCKS_PER_SEC;
+    return result;
+}
+
+FloydWarshallResult floyd_warshall_execute_csr(const CsrGraph *csr, FloydWarshallEngine engine, Graph *graph) {
+    FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
+
+    if (!csr || !graph || !graph->is_initialized || graph->vertices != csr->vertices ||
+        engine < 0 || engine > FW_ENGINE_COUNT) {
+        return result;
+    }
+
+    /* floyd_warshall_select_engine's order, with its sparse tests run on the arrays */
+    if (engine == FW_ENGINE_COUNT && csr->vertices > FW_SMALL_MAX_VERTICES) {
+        if (floyd_warshall_uniform_weight_csr(csr, NULL)) {
+            engine = FW_ENGINE_BFS;
+        } else if (floyd_warshall_topological_order_csr(csr, NULL)) {
+            engine = FW_ENGINE_DAG;
+        }
+    }
+    if (engine == FW_ENGINE_BFS) {
+        return floyd_warshall_execute_bfs_csr(csr, graph);
+    }
+    if (engine == FW_ENGINE_DAG) {
+        return floyd_warshall_execute_dag_csr(csr, graph);
+    }
+
+    TRACE_BEGIN(expand_span);
+    ReturnCode status = csr_graph_expand(csr, graph);
+    TRACE_END(expand_span, "csr_expand", "phase", "edges", csr->edges);
+    if (status != SUCCESS) {
+        return result;
+    }
+    return engine == FW_ENGINE_COUNT ? floyd_warshall_execute_auto(graph) : floyd_warshall_execute_engine(graph, engine);
+}
+
+/* Engine names used on the command line and in benchmark output */
+static const char *engine_names[FW_ENGINE_COUNT] = {
+    "standard",
+    "optimized",
+    "pruned",
+    "blocked",
+    "recursive",
+    "squaring",
+    "small",
+    "mixed",
+    "integer",
+    "scc",
+    "dag",
+    "bfs"
+};
+
+const char* floyd_warshall_engine_name(FloydWarshallEngine engine) {
+    if (engine < 0 || engine >= FW_ENGINE_COUNT) {
+        return "unknown";
+    }
+    return engine_names[engine];
+}
+
+FloydWarshallEngine floyd_warshall_engine_from_name(const char *name) {
+    if (!name) {
+        return FW_ENGINE_COUNT;
+    }
+
+    for (int e = 0; e < FW_ENGINE_COUNT; e++) {
+        if (strcmp(name, engine_names[e]) == 0) {
+            return (FloydWarshallEngine)e;
+        }
+    }
+    return FW_ENGINE_COUNT;
+}
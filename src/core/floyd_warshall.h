@@ -2,6 +2,17 @@
 #define FLOYD_WARSHALL_H
 
 #include "../data_structures/graph.h"
+#include "../data_structures/symmetric_graph.h"
+#include "../data_structures/graph_batch.h"
+#include "../data_structures/tile_summary.h"
+#include "../data_structures/csr_graph.h"
+#include "minplus_gemm.h"
+#include "negative_cycle.h"
+#include "scc.h"
+#include "reduction.h"
+#include "vertex_order.h"
+#include "execution_context.h"
+#include "../utils/transport.h"
 #include <time.h>
 
 /* Result structure for Floyd-Warshall algorithm execution */
@@ -11,10 +22,96 @@ typedef struct {
     int iterations;           /* Number of iterations performed */
     bool has_negative_cycle;  /* Flag indicating presence of negative cycle */
     int negative_cycle_vertex; /* Vertex where negative cycle is detected (-1 if none) */
+    int tiles_skipped;         /* Tile updates skipped by sparsity metadata (blocked engine) */
+    int repaired_entries;      /* Entries the double pass corrected after the float kernel (mixed engine) */
 } FloydWarshallResult;
 
+/* Result of solving a whole GraphBatch */
+typedef struct {
+    bool success;               /* Flag indicating successful execution */
+    double execution_time;      /* Wall-clock seconds for the whole batch */
+    double graphs_per_second;   /* Throughput: count / execution_time */
+    int negative_cycle_graphs;  /* Graphs flagged in batch->negative_cycle */
+} FloydWarshallBatchResult;
+
+/* Periodic checkpoints of the reference kernel (file format: see save_checkpoint_to_file) */
+typedef struct {
+    const char *path;          /* Checkpoint file, replaced atomically on every checkpoint */
+    int interval_pivots;       /* Checkpoint after this many pivots (<= 0: off) */
+    double interval_seconds;   /* ...or once this much wall time has passed (<= 0: off) */
+    int start_pivot;           /* First pivot to apply: 0, or next_pivot of a loaded checkpoint */
+    uint64_t input_hash;       /* checkpoint_input_hash of the unsolved graph, stored in every checkpoint */
+} CheckpointConfig;
+
+/* Available execution engines (all fill graph->distance and graph->next) */
+typedef enum {
+    FW_ENGINE_STANDARD = 0,    /* Reference triple loop */
+    FW_ENGINE_OPTIMIZED,       /* Early termination variant */
+    FW_ENGINE_PRUNED,          /* Iterates only finite d[i][k] rows and d[k][j] columns */
+    FW_ENGINE_BLOCKED,         /* Tiled three-phase kernel with all-infinite tile skipping */
+    FW_ENGINE_RECURSIVE,       /* Cache-oblivious Kleene closure over quadrants (Morton layout) */
+    FW_ENGINE_SQUARING,        /* Repeated min-plus squaring on the packed GEMM kernel */
+    FW_ENGINE_SMALL,           /* Unrolled kernels specialized for n <= FW_SMALL_MAX_VERTICES */
+    FW_ENGINE_MIXED,           /* float32 kernel, then verification and row repair in double */
+    FW_ENGINE_INTEGER,         /* int32 kernel for integral weights (see floyd_warshall_integral_weights) */
+    FW_ENGINE_SCC,             /* Per strongly connected component, combined over the condensation DAG */
+    FW_ENGINE_DAG,             /* Per-source relaxation in topological order (acyclic graphs) */
+    FW_ENGINE_BFS,             /* Direction-optimizing bitset BFS per source (uniform weights) */
+    FW_ENGINE_COUNT
+} FloydWarshallEngine;
+
+/* Working matrix layout of the recursive engine */
+typedef enum {
+    FW_LAYOUT_ROW_MAJOR = 0,   /* Plain row-major copy */
+    FW_LAYOUT_MORTON           /* Leaf tiles stored in Z-order, each tile row-major */
+} MatrixLayout;
+
 /* Core algorithm functions */
-FloydWarshallResult floyd_warshall_execute(Graph *graph);
+FloydWarshallResult floyd_warshall_execute(Graph *graph);    /* Reference kernel */
+
+/*
+ * Automatic engine choice used by floyd_warshall_execute_auto, the CSR entry
+ * point and the command line: small (n <= FW_SMALL_MAX_VERTICES), bfs
+ * (uniform weights), dag (acyclic), scc (largest component at most half
+ * the vertices), integer (integral weights), otherwise standard. reason
+ * (may be NULL) receives the detection message, empty for standard.
+ */
+FloydWarshallEngine floyd_warshall_select_engine(const Graph *graph, char *reason, size_t reason_size);
+
+/* floyd_warshall_select_engine, then that engine */
+FloydWarshallResult floyd_warshall_execute_auto(Graph *graph);
+FloydWarshallResult floyd_warshall_execute_engine(Graph *graph, FloydWarshallEngine engine);
+FloydWarshallResult floyd_warshall_execute_checked(Graph *graph, NegativeCycleMode mode,
+                                                   NegativeCycleInfo *info);
+
+/* Run an engine under a progress/cancellation context (context->status tells how it ended) */
+FloydWarshallResult floyd_warshall_execute_context(Graph *graph, FloydWarshallEngine engine,
+                                                   ExecutionContext *context);
+
+/*
+ * Solve the core of a reduction (see reduction.h) with engine and expand the
+ * result into graph. On a negative cycle the full graph is solved instead.
+ */
+FloydWarshallResult floyd_warshall_execute_reduced(Graph *graph, GraphReduction *reduction,
+                                                   FloydWarshallEngine engine);
+
+/* Run engine on a copy renumbered by order, then write the result back in the original numbering */
+FloydWarshallResult floyd_warshall_execute_reordered(Graph *graph, const VertexOrder *order,
+                                                     FloydWarshallEngine engine);
+
+/*
+ * Solve a sparse graph (see csr_graph.h) into graph, an initialized graph
+ * with the same vertex count whose matrices are overwritten. The dag and bfs
+ * engines read the CSR arrays in place; any other engine gets them expanded
+ * into graph first. FW_ENGINE_COUNT picks like floyd_warshall_select_engine,
+ * testing uniform weights (bfs) and acyclicity (dag) on the arrays and
+ * expanding everything else first.
+ */
+FloydWarshallResult floyd_warshall_execute_csr(const CsrGraph *csr, FloydWarshallEngine engine, Graph *graph);
+
+/* Engine registry */
+const char* floyd_warshall_engine_name(FloydWarshallEngine engine);
+FloydWarshallEngine floyd_warshall_engine_from_name(const char *name);
 
 /* Path related functions */
 int* floyd_warshall_get_path(const Graph *graph, int start, int end, int *path_length);
@@ -22,10 +119,76 @@ double floyd_warshall_get_distance(const Graph *graph, int start, int end);
 
 /* Utility functions */
 bool floyd_warshall_detect_negative_cycle(const Graph *graph);
+
+/*
+ * Re-point next hops that circle a zero-weight cycle instead of reaching
+ * their target (possible when a kernel settles ties out of pivot order);
+ * distances are left alone. Only meaningful without negative cycles.
+ * Returns the number of entries changed.
+ */
+int floyd_warshall_repair_next(Graph *graph);
 void floyd_warshall_print_result(const FloydWarshallResult *result);
 void floyd_warshall_print_path(const Graph *graph, int start, int end);
 
 /* Advanced algorithm variants */
 FloydWarshallResult floyd_warshall_execute_optimized(Graph *graph);
+FloydWarshallResult floyd_warshall_execute_pruned(Graph *graph);
+FloydWarshallResult floyd_warshall_execute_blocked(Graph *graph);
+/* Blocked kernel on a caller-owned tile summary and per-thread packing buffers (see solver.h) */
+FloydWarshallResult floyd_warshall_execute_blocked_reusing(Graph *graph, TileSummary *summary,
+                                                           MinPlusWorkspace *workspaces, int workspace_count);
+FloydWarshallResult floyd_warshall_execute_recursive(Graph *graph);
+FloydWarshallResult floyd_warshall_execute_recursive_layout(Graph *graph, MatrixLayout layout);
+FloydWarshallResult floyd_warshall_execute_squaring(Graph *graph);
+FloydWarshallResult floyd_warshall_execute_small(Graph *graph);
+FloydWarshallResult floyd_warshall_execute_mixed(Graph *graph);
+FloydWarshallResult floyd_warshall_execute_integer(Graph *graph);
+/* Integer kernel reporting the first negative cycle like floyd_warshall_execute_checked */
+FloydWarshallResult floyd_warshall_execute_integer_checked(Graph *graph, NegativeCycleInfo *info);
+
+FloydWarshallResult floyd_warshall_execute_scc(Graph *graph);
+/* Same with a decomposition the caller already has */
+FloydWarshallResult floyd_warshall_execute_components(Graph *graph, const SccDecomposition *scc);
+
+/* True if all edge weights are integers and no shortest path can reach FW_INTEGER_PATH_LIMIT */
+bool floyd_warshall_integral_weights(const Graph *graph);
+
+/* O(n·m) for acyclic graphs; graphs with a cycle go to the reference kernel */
+FloydWarshallResult floyd_warshall_execute_dag(Graph *graph);
+
+/* Same reading CSR in place; other graphs are expanded into graph for the reference kernel */
+FloydWarshallResult floyd_warshall_execute_dag_csr(const CsrGraph *csr, Graph *graph);
+
+/* True if the edges form no cycle (Kahn, O(n^2)); fills order (n entries, may be NULL) */
+bool floyd_warshall_topological_order(const Graph *graph, int *order);
+/* Same in O(n + m) */
+bool floyd_warshall_topological_order_csr(const CsrGraph *csr, int *order);
+
+/* Hop counts times the common weight; other graphs go to the reference kernel */
+FloydWarshallResult floyd_warshall_execute_bfs(Graph *graph);
+
+/* Same reading CSR in place; other graphs are expanded into graph for the reference kernel */
+FloydWarshallResult floyd_warshall_execute_bfs_csr(const CsrGraph *csr, Graph *graph);
+
+/* True if there is an edge and all edges share one weight >= 0 (stored in weight, may be NULL) */
+bool floyd_warshall_uniform_weight(const Graph *graph, double *weight);
+bool floyd_warshall_uniform_weight_csr(const CsrGraph *csr, double *weight);
+
+/* Undirected graphs (packed upper triangle, about half the work) */
+FloydWarshallResult floyd_warshall_execute_symmetric(SymmetricGraph *graph);
+int* floyd_warshall_get_path_symmetric(const SymmetricGraph *graph, int start, int end, int *path_length);
+double floyd_warshall_get_distance_symmetric(const SymmetricGraph *graph, int start, int end);
+void floyd_warshall_print_path_symmetric(const SymmetricGraph *graph, int start, int end);
+
+/* Reference kernel with asynchronous checkpoints; resumes from config->start_pivot */
+FloydWarshallResult floyd_warshall_execute_checkpointed(Graph *graph, const CheckpointConfig *config,
+                                                        int *checkpoints_written);
+
+/* Multi-process run on a 2D process grid (processes <= FW_DISTRIBUTED_MAX_PROCESSES) */
+FloydWarshallResult floyd_warshall_execute_distributed(Graph *graph, int processes, TransportKind transport);
+
+/* Many small graphs of one size, interleaved so SIMD lanes cover different graphs */
+FloydWarshallBatchResult floyd_warshall_execute_batch(GraphBatch *batch);
+int* floyd_warshall_get_path_batch(const GraphBatch *batch, int graph, int start, int end, int *path_length);
 
 #endif /* FLOYD_WARSHALL_H */
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include "floyd_warshall.h"
+#include "simd.h"
+#include "../utils/trace.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/*
+ * Each group holds FW_BATCH_LANES graphs interleaved as [i][j][lane], so one
+ * relaxation d[i][j] = min(d[i][j], d[i][k] + d[k][j]) is a single lane
+ * vector operation covering every graph of the group. Unreachable entries
+ * are HUGE_VAL, which absorbs negative addends, so no infinity checks are
+ * needed in the inner loop.
+ *
+ * The next-hop update is a select on the comparison mask, done on native
+ * vectors from simd.h (a group spans FW_BATCH_LANES / SIMD_LANES of them).
+ */
+#if FW_HAVE_VECTOR_EXTENSIONS
+#define BATCH_VECTORS (FW_BATCH_LANES / SIMD_LANES)
+
+static void solve_group(int n, double *distance, int64_t *next) {
+    SimdDoubles *d = (SimdDoubles*)distance;
+    SimdMask *hops = (SimdMask*)next;
+
+    for (int k = 0; k < n; k++) {
+        const SimdDoubles *row_k = d + (size_t)k * n * BATCH_VECTORS;
+
+        for (int i = 0; i < n; i++) {
+            SimdDoubles *row_i = d + (size_t)i * n * BATCH_VECTORS;
+            SimdMask *hops_i = hops + (size_t)i * n * BATCH_VECTORS;
+            SimdDoubles distance_ik[BATCH_VECTORS];
+            SimdMask hop_ik[BATCH_VECTORS];
+
+            /* Skip rows where no graph of the group reaches k */
+            bool reachable = false;
+            for (int v = 0; v < BATCH_VECTORS; v++) {
+                distance_ik[v] = row_i[(size_t)k * BATCH_VECTORS + v];
+                hop_ik[v] = hops_i[(size_t)k * BATCH_VECTORS + v];
+                for (int lane = 0; lane < SIMD_LANES; lane++) {
+                    reachable |= distance_ik[v][lane] < HUGE_VAL;
+                }
+            }
+            if (!reachable) {
+                continue;
+            }
+
+            for (int j = 0; j < n; j++) {
+                for (int v = 0; v < BATCH_VECTORS; v++) {
+                    size_t index = (size_t)j * BATCH_VECTORS + v;
+                    SimdDoubles candidate = distance_ik[v] + row_k[index];
+                    SimdMask better = candidate < row_i[index];
+                    row_i[index] = SIMD_SELECT_DOUBLES(better, candidate, row_i[index]);
+                    hops_i[index] = SIMD_SELECT_MASK(better, hop_ik[v], hops_i[index]);
+                }
+            }
+        }
+    }
+}
+#else
+static void solve_group(int n, double *distance, int64_t *next) {
+    for (int k = 0; k < n; k++) {
+        const double *row_k = distance + (size_t)k * n * FW_BATCH_LANES;
+
+        for (int i = 0; i < n; i++) {
+            double *row_i = distance + (size_t)i * n * FW_BATCH_LANES;
+            int64_t *hops_i = next + (size_t)i * n * FW_BATCH_LANES;
+            double distance_ik[FW_BATCH_LANES];
+            int64_t hop_ik[FW_BATCH_LANES];
+            memcpy(distance_ik, row_i + (size_t)k * FW_BATCH_LANES, sizeof(distance_ik));
+            memcpy(hop_ik, hops_i + (size_t)k * FW_BATCH_LANES, sizeof(hop_ik));
+
+            for (int j = 0; j < n; j++) {
+                for (int lane = 0; lane < FW_BATCH_LANES; lane++) {
+                    size_t index = (size_t)j * FW_BATCH_LANES + lane;
+                    double candidate = distance_ik[lane] + row_k[index];
+                    if (candidate < row_i[index]) {
+                        row_i[index] = candidate;
+                        hops_i[index] = hop_ik[lane];
+                    }
+                }
+            }
+        }
+    }
+}
+#endif
+
+FloydWarshallBatchResult floyd_warshall_execute_batch(GraphBatch *batch) {
+    FloydWarshallBatchResult result = {false, 0.0, 0.0, 0};
+
+    if (!batch || !batch->is_initialized) {
+        return result;
+    }
+
+    int n = batch->vertices;
+    size_t group_size = (size_t)n * (size_t)n * FW_BATCH_LANES;
+    uint64_t start_time = trace_now_ns();
+
+    /* Groups are independent; each thread solves whole groups */
+    TRACE_BEGIN(batch_span);
+    #pragma omp parallel for schedule(dynamic)
+    for (int group = 0; group < batch->groups; group++) {
+        solve_group(n, batch->distance + (size_t)group * group_size,
+                    batch->next + (size_t)group * group_size);
+    }
+    TRACE_END(batch_span, "batch", "kernel", "groups", batch->groups);
+
+    /* Check for negative cycles per graph */
+    int negative = 0;
+    for (int g = 0; g < batch->count; g++) {
+        batch->negative_cycle[g] = false;
+        for (int i = 0; i < n; i++) {
+            if (batch->distance[graph_batch_index(batch, g, i, i)] < -EPSILON) {
+                batch->negative_cycle[g] = true;
+                negative++;
+                break;
+            }
+        }
+    }
+
+    result.execution_time = (double)(trace_now_ns() - start_time) / 1e9;
+    result.graphs_per_second = result.execution_time > 0.0 ? batch->count / result.execution_time : 0.0;
+    result.negative_cycle_graphs = negative;
+    result.success = true;
+
+    return result;
+}
+
+int* floyd_warshall_get_path_batch(const GraphBatch *batch, int graph, int start, int end, int *path_length) {
+    if (!batch || !batch->is_initialized || !path_length ||
+        graph < 0 || graph >= batch->count ||
+        start < 0 || start >= batch->vertices ||
+        end < 0 || end >= batch->vertices) {
+        if (path_length) *path_length = 0;
+        return NULL;
+    }
+
+    *path_length = 0;
+
+    /* Check if path exists */
+    if (graph_batch_get_distance(batch, graph, start, end) >= INFINITY_VALUE) {
+        return NULL;
+    }
+
+    /* Count path length (bounded, next hops loop under a negative cycle) */
+    int count = 1;
+    int current = start;
+    while (current != end) {
+        current = (int)batch->next[graph_batch_index(batch, graph, current, end)];
+        if (current < 0 || count >= batch->vertices) {
+            return NULL;
+        }
+        count++;
+    }
+
+    int *path = (int*)malloc(count * sizeof(int));
+    if (!path) {
+        return NULL;
+    }
+
+    path[0] = start;
+    current = start;
+    for (int i = 1; i < count; i++) {
+        current = (int)batch->next[graph_batch_index(batch, graph, current, end)];
+        path[i] = current;
+    }
+
+    *path_length = count;
+    return path;
+}
@@ -0,0 +1,332 @@
+#include "floyd_warshall.h"
+#include "transitive_closure.h"
+#include "bitset.h"
+#include "../utils/trace.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * Uniform weights: when every edge costs the same w >= 0, the distance from
+ * s to v is w times the hop count, so one BFS per source replaces the pivot
+ * loop. Edges are kept as bitset rows (out-edges and in-edges, the
+ * ReachabilityMatrix layout), and each level runs in whichever direction
+ * scans fewer rows:
+ *
+ *   top-down:  every frontier vertex u ORs in out[u] & ~visited
+ *   bottom-up: every unvisited vertex v looks for a parent in in[v] & frontier,
+ *              stopping at the first one
+ *
+ * so a level costs min(|frontier|, |unvisited|) row scans of n/64 words.
+ * Sources run in parallel; cancellation is checked between blocks of
+ * BFS_SOURCE_BLOCK sources, and rows not yet solved keep their input edges.
+ * The bitsets are built from the matrix or straight from caller-owned CSR
+ * (floyd_warshall_execute_bfs_csr), which is never expanded.
+ */
+
+#define BFS_SOURCE_BLOCK 64
+
+/* Bottom-up once the unvisited vertices are fewer than this many per frontier vertex */
+#define BFS_BOTTOM_UP_FACTOR 4
+
+static const uint64_t* bitset_row(const ReachabilityMatrix *matrix, int row) {
+    return matrix->bits + (size_t)row * (size_t)matrix->words_per_row;
+}
+
+bool floyd_warshall_uniform_weight(const Graph *graph, double *weight) {
+    if (!graph || !graph->is_initialized) {
+        return false;
+    }
+
+    int n = graph->vertices;
+    double common = INFINITY_VALUE;
+    for (int i = 0; i < n; i++) {
+        const double *row = graph->distance[i];
+        for (int j = 0; j < n; j++) {
+            if (i == j || row[j] >= INFINITY_VALUE) {
+                continue;
+            }
+            if (common >= INFINITY_VALUE) {
+                common = row[j];
+            } else if (row[j] != common) {
+                return false;
+            }
+        }
+    }
+
+    /* No edges, or a negative weight (longer paths would be shorter) */
+    if (common >= INFINITY_VALUE || common < 0.0) {
+        return false;
+    }
+    if (weight) {
+        *weight = common;
+    }
+    return true;
+}
+
+bool floyd_warshall_uniform_weight_csr(const CsrGraph *csr, double *weight) {
+    if (!csr) {
+        return false;
+    }
+
+    double common = INFINITY_VALUE;
+    for (int u = 0; u < csr->vertices; u++) {
+        for (int e = csr->row_ptr[u]; e < csr->row_ptr[u + 1]; e++) {
+            double edge_weight = csr_graph_weight(csr, e);
+            if (csr->col_idx[e] == u && edge_weight >= 0.0) {
+                continue;
+            }
+            if (common >= INFINITY_VALUE) {
+                common = edge_weight;
+            } else if (edge_weight != common) {
+                return false;
+            }
+        }
+    }
+
+    if (common >= INFINITY_VALUE || common < 0.0) {
+        return false;
+    }
+    if (weight) {
+        *weight = common;
+    }
+    return true;
+}
+
+/* Per-thread BFS state, words_per_row words each */
+typedef struct {
+    uint64_t *visited;
+    uint64_t *frontier;
+    uint64_t *discovered;
+} BfsScratch;
+
+/* Distances and first hops from s; returns row words scanned */
+static long long bfs_source(Graph *graph, const ReachabilityMatrix *out, const ReachabilityMatrix *in,
+                            double weight, int s, BfsScratch *scratch) {
+    int n = graph->vertices;
+    int words = out->words_per_row;
+    double *distance_s = graph->distance[s];
+    int *next_s = graph->next[s];
+
+    for (int j = 0; j < n; j++) {
+        distance_s[j] = INFINITY_VALUE;
+        next_s[j] = -1;
+    }
+    distance_s[s] = 0.0;
+
+    /* Padding bits count as visited so they are never discovered */
+    for (int w = 0; w < words; w++) {
+        int first_bit = w * REACHABILITY_WORD_BITS;
+        scratch->visited[w] = first_bit + REACHABILITY_WORD_BITS <= n ? 0
+                            : first_bit >= n ? ~0ULL
+                            : ~0ULL << (n - first_bit);
+        scratch->frontier[w] = 0;
+    }
+    scratch->visited[s / REACHABILITY_WORD_BITS] |= 1ULL << (s % REACHABILITY_WORD_BITS);
+    scratch->frontier[s / REACHABILITY_WORD_BITS] |= 1ULL << (s % REACHABILITY_WORD_BITS);
+
+    long long scanned = 0;
+    int frontier_size = 1;
+    int unvisited = n - 1;
+    for (int level = 1; frontier_size > 0 && unvisited > 0; level++) {
+        double distance = level * weight;
+        int found = 0;
+        memset(scratch->discovered, 0, (size_t)words * sizeof(uint64_t));
+
+        if (unvisited < BFS_BOTTOM_UP_FACTOR * frontier_size) {
+            for (int w = 0; w < words; w++) {
+                for (uint64_t pending = ~scratch->visited[w]; pending; pending &= pending - 1) {
+                    int v = w * REACHABILITY_WORD_BITS + bitset_lowest_bit(pending);
+                    const uint64_t *parents = bitset_row(in, v);
+                    for (int x = 0; x < words; x++) {
+                        uint64_t hit = parents[x] & scratch->frontier[x];
+                        if (hit) {
+                            int u = x * REACHABILITY_WORD_BITS + bitset_lowest_bit(hit);
+                            distance_s[v] = distance;
+                            next_s[v] = u == s ? v : next_s[u];
+                            scratch->discovered[w] |= pending & -pending;
+                            found++;
+                            break;
+                        }
+                    }
+                    scanned += words;
+                }
+            }
+        } else {
+            for (int w = 0; w < words; w++) {
+                for (uint64_t pending = scratch->frontier[w]; pending; pending &= pending - 1) {
+                    int u = w * REACHABILITY_WORD_BITS + bitset_lowest_bit(pending);
+                    const uint64_t *children = bitset_row(out, u);
+                    int hop = u == s ? -1 : next_s[u];
+                    for (int x = 0; x < words; x++) {
+                        uint64_t fresh = children[x] & ~(scratch->visited[x] | scratch->discovered[x]);
+                        scratch->discovered[x] |= fresh;
+                        for (; fresh; fresh &= fresh - 1) {
+                            int v = x * REACHABILITY_WORD_BITS + bitset_lowest_bit(fresh);
+                            distance_s[v] = distance;
+                            next_s[v] = hop >= 0 ? hop : v;
+                            found++;
+                        }
+                    }
+                    scanned += words;
+                }
+            }
+        }
+
+        uint64_t *swap = scratch->frontier;
+        scratch->frontier = scratch->discovered;
+        scratch->discovered = swap;
+        for (int w = 0; w < words; w++) {
+            scratch->visited[w] |= scratch->frontier[w];
+        }
+        frontier_size = found;
+        unvisited -= found;
+    }
+    return scanned;
+}
+
+/* Out- and in-edge bitsets from the matrix */
+static bool edge_bitsets(const Graph *graph, ReachabilityMatrix **out, ReachabilityMatrix **in) {
+    int n = graph->vertices;
+    *out = reachability_from_graph(graph);
+    *in = reachability_create(n);
+    if (!*out || !*in) {
+        reachability_destroy(*out);
+        reachability_destroy(*in);
+        return false;
+    }
+    for (int u = 0; u < n; u++) {
+        for (int v = 0; v < n; v++) {
+            if (graph->distance[u][v] < INFINITY_VALUE) {
+                reachability_add_edge(*in, v, u);
+            }
+        }
+    }
+    return true;
+}
+
+/* Same from CSR, O(n^2 / 64 + m) */
+static bool edge_bitsets_csr(const CsrGraph *csr, ReachabilityMatrix **out, ReachabilityMatrix **in) {
+    *out = reachability_create(csr->vertices);
+    *in = reachability_create(csr->vertices);
+    if (!*out || !*in) {
+        reachability_destroy(*out);
+        reachability_destroy(*in);
+        return false;
+    }
+    for (int u = 0; u < csr->vertices; u++) {
+        for (int e = csr->row_ptr[u]; e < csr->row_ptr[u + 1]; e++) {
+            reachability_add_edge(*out, u, csr->col_idx[e]);
+            reachability_add_edge(*in, csr->col_idx[e], u);
+        }
+    }
+    return true;
+}
+
+/* All sources over prepared bitsets; after a cancellation csr (if given) fills the unsolved rows */
+static FloydWarshallResult bfs_execute(Graph *graph, ReachabilityMatrix *out, ReachabilityMatrix *in,
+                                       double weight, const CsrGraph *csr, clock_t start_time) {
+    FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
+
+    int n = graph->vertices;
+    int words = out->words_per_row;
+    long long scanned = 0;
+    int failures = 0;
+    int first = 0;
+    for (; first < n && failures == 0; first += BFS_SOURCE_BLOCK) {
+        if (execution_boundary(first, n, scanned * REACHABILITY_WORD_BITS)) {
+            break;
+        }
+        int last = first + BFS_SOURCE_BLOCK < n ? first + BFS_SOURCE_BLOCK : n;
+        TRACE_BEGIN(block_span);
+        #pragma omp parallel reduction(+:scanned, failures)
+        {
+            BfsScratch scratch;
+            scratch.visited = (uint64_t*)malloc((size_t)words * sizeof(uint64_t));
+            scratch.frontier = (uint64_t*)malloc((size_t)words * sizeof(uint64_t));
+            scratch.discovered = (uint64_t*)malloc((size_t)words * sizeof(uint64_t));
+            bool ready = scratch.visited && scratch.frontier && scratch.discovered;
+            failures += !ready;
+
+            #pragma omp for schedule(dynamic, 4)
+            for (int s = first; s < last; s++) {
+                if (ready) {
+                    scanned += bfs_source(graph, out, in, weight, s, &scratch);
+                }
+            }
+            free(scratch.visited);
+            free(scratch.frontier);
+            free(scratch.discovered);
+        }
+        TRACE_END(block_span, "source_block", "kernel", "first_source", first);
+    }
+    reachability_destroy(out);
+    reachability_destroy(in);
+
+    if (failures > 0) {
+        return result;
+    }
+    for (int s = first; csr && s < n; s++) {
+        csr_graph_expand_row(csr, graph, s);
+    }
+
+    long long relaxations = scanned * REACHABILITY_WORD_BITS;
+    clock_t end_time = clock();
+    result.execution_time = ((double)(end_time - start_time)) / CLOCKS_PER_SEC;
+    result.iterations = relaxations > INT_MAX ? INT_MAX : (int)relaxations;
+    result.success = true;
+
+    return result;
+}
+
+FloydWarshallResult floyd_warshall_execute_bfs(Graph *graph) {
+    FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
+
+    if (!graph || !graph->is_initialized) {
+        return result;
+    }
+
+    if (graph_validate(graph) != SUCCESS) {
+        return result;
+    }
+
+    /* Mixed or negative weights: the reference kernel handles them */
+    double weight;
+    if (!floyd_warshall_uniform_weight(graph, &weight)) {
+        return floyd_warshall_execute_checked(graph, FW_NEGATIVE_CYCLE_COMPLETE, NULL);
+    }
+
+    clock_t start_time = clock();
+    ReachabilityMatrix *out, *in;
+    TRACE_BEGIN(bitset_span);
+    bool ready = edge_bitsets(graph, &out, &in);
+    TRACE_END(bitset_span, "edge_bitsets", "phase", NULL, TRACE_NO_ARG);
+    if (!ready) {
+        return result;
+    }
+    return bfs_execute(graph, out, in, weight, NULL, start_time);
+}
+
+FloydWarshallResult floyd_warshall_execute_bfs_csr(const CsrGraph *csr, Graph *graph) {
+    FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
+
+    if (!csr || !graph || !graph->is_initialized || graph->vertices != csr->vertices) {
+        return result;
+    }
+
+    double weight;
+    if (!floyd_warshall_uniform_weight_csr(csr, &weight)) {
+        csr_graph_expand(csr, graph);
+        return floyd_warshall_execute_checked(graph, FW_NEGATIVE_CYCLE_COMPLETE, NULL);
+    }
+
+    clock_t start_time = clock();
+    ReachabilityMatrix *out, *in;
+    TRACE_BEGIN(bitset_span);
+    bool ready = edge_bitsets_csr(csr, &out, &in);
+    TRACE_END(bitset_span, "edge_bitsets", "phase", NULL, TRACE_NO_ARG);
+    if (!ready) {
+        return result;
+    }
+    return bfs_execute(graph, out, in, weight, csr, start_time);
+}
@@ -0,0 +1,228 @@
+#include "floyd_warshall.h"
+#include "minplus_gemm.h"
+#include "../data_structures/tile_summary.h"
+#include "../utils/trace.h"
+#include <stdlib.h>
+#include <time.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Relax tile (tile_row, tile_col) through every pivot of pivot_tile; returns relaxations done */
+static long long relax_tile(Graph *graph, int tile_size, int tile_row, int tile_col, int pivot_tile) {
+    int n = graph->vertices;
+    int row_start = tile_row * tile_size;
+    int col_start = tile_col * tile_size;
+    int k_start = pivot_tile * tile_size;
+    int row_end = row_start + tile_size < n ? row_start + tile_size : n;
+    int col_end = col_start + tile_size < n ? col_start + tile_size : n;
+    int k_end = k_start + tile_size < n ? k_start + tile_size : n;
+    long long relaxations = 0;
+
+    for (int k = k_start; k < k_end; k++) {
+        const double *distance_k = graph->distance[k];
+
+        for (int i = row_start; i < row_end; i++) {
+            double distance_ik = graph->distance[i][k];
+            if (distance_ik >= INFINITY_VALUE) {
+                continue;
+            }
+
+            double *distance_i = graph->distance[i];
+            int *next_i = graph->next[i];
+            int next_ik = next_i[k];
+            relaxations += col_end - col_start;
+
+            for (int j = col_start; j < col_end; j++) {
+                if (distance_k[j] < INFINITY_VALUE) {
+                    double new_distance = distance_ik + distance_k[j];
+                    if (new_distance < distance_i[j]) {
+                        distance_i[j] = new_distance;
+                        next_i[j] = next_ik;
+                    }
+                }
+            }
+        }
+    }
+
+    return relaxations;
+}
+
+/* Relax a tile unless its summary proves the update is a no-op */
+static long long update_tile(Graph *graph, TileSummary *summary, int tile_row, int tile_col,
+                             int pivot_tile, int *skipped) {
+    if (!tile_summary_can_improve(summary, tile_row, tile_col, pivot_tile)) {
+        (*skipped)++;
+        return 0;
+    }
+
+    long long relaxations = relax_tile(graph, summary->tile_size, tile_row, tile_col, pivot_tile);
+    tile_summary_refresh(summary, graph, tile_row, tile_col);
+    return relaxations;
+}
+
+/* Packing buffers of the calling thread, or NULL to let the kernel allocate */
+static MinPlusWorkspace* thread_workspace(MinPlusWorkspace *workspaces, int workspace_count) {
+#ifdef _OPENMP
+    int thread = omp_get_thread_num();
+#else
+    int thread = 0;
+#endif
+    return workspaces && thread < workspace_count ? &workspaces[thread] : NULL;
+}
+
+/*
+ * Phase 3 update: tile (tile_row, tile_col) only reads the finished tiles
+ * (tile_row, pivot_tile) and (pivot_tile, tile_col), so the relaxation is a
+ * plain min-plus product handed to the packed kernel.
+ */
+static long long product_tile(Graph *graph, TileSummary *summary, int tile_row, int tile_col,
+                              int pivot_tile, int *skipped, MinPlusWorkspace *workspace) {
+    if (!tile_summary_can_improve(summary, tile_row, tile_col, pivot_tile)) {
+        (*skipped)++;
+        return 0;
+    }
+
+    int n = graph->vertices;
+    int tile_size = summary->tile_size;
+    int row_start = tile_row * tile_size;
+    int col_start = tile_col * tile_size;
+    int k_start = pivot_tile * tile_size;
+    int rows = (row_start + tile_size < n ? row_start + tile_size : n) - row_start;
+    int cols = (col_start + tile_size < n ? col_start + tile_size : n) - col_start;
+    int depth = (k_start + tile_size < n ? k_start + tile_size : n) - k_start;
+
+    MinPlusView a = {graph->distance, graph->next, row_start, k_start};
+    MinPlusView b = {graph->distance, NULL, k_start, col_start};
+    MinPlusView c = {graph->distance, graph->next, row_start, col_start};
+
+    long long relaxations;
+    if (minplus_gemm_workspace(rows, cols, depth, &a, &b, &c, workspace) == SUCCESS) {
+        relaxations = (long long)rows * cols * depth;
+    } else {
+        relaxations = relax_tile(graph, tile_size, tile_row, tile_col, pivot_tile);
+    }
+
+    tile_summary_refresh(summary, graph, tile_row, tile_col);
+    return relaxations;
+}
+
+/*
+ * Three-phase blocked Floyd-Warshall. For pivot tile kt: (1) the diagonal
+ * tile, (2) the rest of pivot row and column kt, (3) every remaining tile,
+ * which only reads tiles finished in phases 1 and 2 and so is a min-plus
+ * product. Phases 2 and 3 are independent per tile and run in parallel.
+ */
+FloydWarshallResult floyd_warshall_execute_blocked(Graph *graph) {
+    FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
+
+    if (!graph || !graph->is_initialized) {
+        return result;
+    }
+
+    if (graph_validate(graph) != SUCCESS) {
+        return result;
+    }
+
+    TileSummary *summary = tile_summary_create(graph, FW_TILE_SIZE);
+    if (!summary) {
+        return result;
+    }
+
+    result = floyd_warshall_execute_blocked_reusing(graph, summary, NULL, 0);
+    tile_summary_destroy(summary);
+    return result;
+}
+
+/*
+ * The kernel itself, on caller-owned state: summary must match the current
+ * matrices and workspaces[t] holds the packing buffers of OpenMP thread t
+ * (threads without one fall back to temporary buffers).
+ */
+FloydWarshallResult floyd_warshall_execute_blocked_reusing(Graph *graph, TileSummary *summary,
+                                                           MinPlusWorkspace *workspaces, int workspace_count) {
+    FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
+
+    if (!graph || !graph->is_initialized || !summary || summary->vertices != graph->vertices) {
+        return result;
+    }
+
+    if (graph_validate(graph) != SUCCESS) {
+        return result;
+    }
+
+    clock_t start_time = clock();
+    int n = graph->vertices;
+    int tiles = summary->tiles_per_side;
+    long long relaxations = 0;
+    int skipped = 0;
+
+    for (int kt = 0; kt < tiles; kt++) {
+        if (execution_boundary(kt * FW_TILE_SIZE, n, relaxations)) {
+            break;
+        }
+        TRACE_BEGIN(round_span);
+
+        /* Phase 1: diagonal tile */
+        relaxations += update_tile(graph, summary, kt, kt, kt, &skipped);
+
+        /* Phase 2: pivot row and pivot column */
+        #pragma omp parallel for schedule(dynamic) reduction(+:relaxations, skipped)
+        for (int t = 0; t < 2 * tiles; t++) {
+            int other = t / 2;
+            if (other == kt) {
+                continue;
+            }
+            if (t % 2 == 0) {
+                relaxations += update_tile(graph, summary, kt, other, kt, &skipped);
+            } else {
+                relaxations += update_tile(graph, summary, other, kt, kt, &skipped);
+            }
+        }
+
+        /* Phase 3: remaining tiles */
+        #pragma omp parallel for schedule(dynamic) reduction(+:relaxations, skipped)
+        for (int t = 0; t < tiles * tiles; t++) {
+            int tile_row = t / tiles;
+            int tile_col = t % tiles;
+            if (tile_row == kt || tile_col == kt) {
+                continue;
+            }
+            TRACE_BEGIN(tile_span);
+            relaxations += product_tile(graph, summary, tile_row, tile_col, kt, &skipped,
+                                        thread_workspace(workspaces, workspace_count));
+            TRACE_END(tile_span, "tile", "kernel", "pivot_tile", kt);
+        }
+
+        TRACE_END(round_span, "pivot_tile", "kernel", "pivot_tile", kt);
+    }
+
+    /* Check for negative cycles */
+    for (int i = 0; i < n; i++) {
+        if (graph->distance[i][i] < -EPSILON) {
+            result.has_negative_cycle = true;
+            result.negative_cycle_vertex = i;
+            break;
+        }
+    }
+
+    /*
+     * Phase 3 settles a tile against pivot tiles that are already closed, so
+     * on a zero-weight cycle an equal-length alternative can win in an order
+     * the reference never uses and leave the hops of a target going round.
+     */
+    if (!result.has_negative_cycle) {
+        TRACE_BEGIN(repair_span);
+        floyd_warshall_repair_next(graph);
+        TRACE_END(repair_span, "repair_next", "phase", NULL, TRACE_NO_ARG);
+    }
+
+    clock_t end_time = clock();
+    result.execution_time = ((double)(end_time - start_time)) / CLOCKS_PER_SEC;
+    result.iterations = relaxations > INT_MAX ? INT_MAX : (int)relaxations;
+    result.tiles_skipped = skipped;
+    result.success = true;
+
+    return result;
+}
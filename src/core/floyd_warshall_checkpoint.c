@@ -0,0 +1,132 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "floyd_warshall.h"
+#include "pivot.h"
+#include "../utils/file_io.h"
+#include "../utils/trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+/*
+ * Checkpoints are taken at pivot boundaries by forking: the child sees a
+ * copy-on-write snapshot of the matrices as they were after the pivot, writes
+ * it with save_checkpoint_to_file and exits, while the parent goes on with the
+ * next pivots. Only pages the parent modifies while the child is writing get
+ * copied. At most one writer runs at a time; a checkpoint that falls due
+ * while the previous one is still being written is retried after the next
+ * pivot.
+ */
+
+/* Reap the writer; returns 1 if it wrote its checkpoint. Without wait a running writer is left alone. */
+static int reap_writer(pid_t *writer, bool wait) {
+    if (*writer <= 0) {
+        return 0;
+    }
+
+    int status = 0;
+    pid_t done = waitpid(*writer, &status, wait ? 0 : WNOHANG);
+    if (done == 0) {
+        return 0;
+    }
+
+    *writer = 0;
+    return done > 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+/* Start a writer for the current matrices; writes synchronously if fork fails. Returns checkpoints completed. */
+static int start_writer(const Graph *graph, int next_pivot, const CheckpointConfig *config, pid_t *writer) {
+    pid_t pid = fork();
+    if (pid == 0) {
+        _exit(save_checkpoint_to_file(graph, next_pivot, config->input_hash, config->path) == SUCCESS ? 0 : 1);
+    }
+    if (pid > 0) {
+        *writer = pid;
+        return 0;
+    }
+    return save_checkpoint_to_file(graph, next_pivot, config->input_hash, config->path) == SUCCESS ? 1 : 0;
+}
+
+FloydWarshallResult floyd_warshall_execute_checkpointed(Graph *graph, const CheckpointConfig *config,
+                                                        int *checkpoints_written) {
+    FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
+
+    if (checkpoints_written) {
+        *checkpoints_written = 0;
+    }
+
+    if (!graph || !graph->is_initialized || !config || !config->path) {
+        return result;
+    }
+
+    int n = graph->vertices;
+    if (config->start_pivot < 0 || config->start_pivot > n) {
+        return result;
+    }
+
+    /* A resumed graph may already hold negative distances on the diagonal */
+    if (config->start_pivot == 0 && graph_validate(graph) != SUCCESS) {
+        return result;
+    }
+
+    clock_t start_time = clock();
+    uint64_t interval_ns = (uint64_t)(config->interval_seconds > 0.0 ? config->interval_seconds * 1e9 : 0.0);
+    uint64_t last_time = trace_now_ns();
+    int last_pivot = config->start_pivot;
+    int iterations = 0;
+    int written = 0;
+    pid_t writer = 0;
+
+    for (int k = config->start_pivot; k < n; k++) {
+        /* A cancelled run leaves a checkpoint of exactly where it stopped */
+        if (execution_boundary(k, n, iterations)) {
+            written += reap_writer(&writer, true);
+            if (k > last_pivot && save_checkpoint_to_file(graph, k, config->input_hash, config->path) == SUCCESS) {
+                written++;
+            }
+            break;
+        }
+        TRACE_BEGIN(pivot_span);
+        iterations += floyd_warshall_relax_pivot(graph, k);
+        TRACE_END(pivot_span, "pivot", "kernel", "k", k);
+
+        /* Pivots 0..k are applied; the final state needs no checkpoint */
+        int done = k + 1;
+        bool due = (config->interval_pivots > 0 && done - last_pivot >= config->interval_pivots) ||
+                   (interval_ns > 0 && trace_now_ns() - last_time >= interval_ns);
+        if (due && done < n) {
+            written += reap_writer(&writer, false);
+            if (writer == 0) {
+                TRACE_BEGIN(snapshot_span);
+                written += start_writer(graph, done, config, &writer);
+                TRACE_END(snapshot_span, "checkpoint_snapshot", "phase", "pivots_done", done);
+                last_pivot = done;
+                last_time = trace_now_ns();
+            }
+        }
+    }
+
+    written += reap_writer(&writer, true);
+
+    /* Check for negative cycles */
+    for (int i = 0; i < n; i++) {
+        if (graph->distance[i][i] < -EPSILON) {
+            result.has_negative_cycle = true;
+            result.negative_cycle_vertex = i;
+            break;
+        }
+    }
+
+    clock_t end_time = clock();
+    result.execution_time = ((double)(end_time - start_time)) / CLOCKS_PER_SEC;
+    result.iterations = iterations;
+    result.success = true;
+
+    if (checkpoints_written) {
+        *checkpoints_written = written;
+    }
+    return result;
+}
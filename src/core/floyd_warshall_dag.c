@@ -0,0 +1,230 @@
+#include "floyd_warshall.h"
+#include "../utils/trace.h"
+#include <stdlib.h>
+#include <time.h>
+
+/*
+ * Acyclic graphs: with the vertices in topological order, one pass over the
+ * out-edges from the source onwards settles every distance from that source,
+ * negative weights included, since each vertex is final before its edges are
+ * relaxed. All pairs then cost O(n·m) instead of O(n^3), one independent row
+ * per source. A vertex is reached from s only if it comes after s, so each
+ * pass starts at s's position. The engine reads CSR, either the caller's
+ * (floyd_warshall_execute_dag_csr) or one built from the matrix.
+ *
+ * Cancellation is checked between blocks of DAG_SOURCE_BLOCK sources: rows
+ * not yet solved keep their input edges, which are real path lengths.
+ */
+
+#define DAG_SOURCE_BLOCK 64
+
+/* Topological order of a CSR graph */
+typedef struct {
+    const CsrGraph *csr;
+    int *order;             /* Position -> vertex */
+    int *rank;              /* Vertex -> position */
+} DagIndex;
+
+static void dag_index_free(DagIndex *index) {
+    free(index->order);
+    free(index->rank);
+}
+
+/* Kahn's algorithm, O(n + m); false if allocation fails or a cycle remains */
+static bool dag_index_build(const CsrGraph *csr, DagIndex *index) {
+    int n = csr->vertices;
+    index->csr = csr;
+    index->order = (int*)malloc((size_t)n * sizeof(int));
+    index->rank = (int*)malloc((size_t)n * sizeof(int));
+    int *in_degree = (int*)calloc((size_t)n, sizeof(int));
+    if (!index->order || !index->rank || !in_degree) {
+        dag_index_free(index);
+        free(in_degree);
+        return false;
+    }
+
+    /* A negative self-loop is a cycle; other self-loops never shorten a path */
+    for (int u = 0; u < n; u++) {
+        for (int e = csr->row_ptr[u]; e < csr->row_ptr[u + 1]; e++) {
+            int v = csr->col_idx[e];
+            if (v == u && csr_graph_weight(csr, e) < 0.0) {
+                dag_index_free(index);
+                free(in_degree);
+                return false;
+            }
+            in_degree[v] += v != u;
+        }
+    }
+
+    /* order doubles as the queue */
+    int count = 0;
+    for (int v = 0; v < n; v++) {
+        if (in_degree[v] == 0) {
+            index->order[count++] = v;
+        }
+    }
+    for (int head = 0; head < count; head++) {
+        int u = index->order[head];
+        for (int e = csr->row_ptr[u]; e < csr->row_ptr[u + 1]; e++) {
+            int v = csr->col_idx[e];
+            if (v != u && --in_degree[v] == 0) {
+                index->order[count++] = v;
+            }
+        }
+    }
+    free(in_degree);
+
+    if (count < n) {
+        dag_index_free(index);
+        return false;
+    }
+    for (int p = 0; p < n; p++) {
+        index->rank[index->order[p]] = p;
+    }
+    return true;
+}
+
+bool floyd_warshall_topological_order(const Graph *graph, int *order) {
+    CsrGraph *csr = csr_graph_from_graph(graph);
+    if (!csr) {
+        return false;
+    }
+
+    bool acyclic = floyd_warshall_topological_order_csr(csr, order);
+    csr_graph_destroy(csr);
+    return acyclic;
+}
+
+bool floyd_warshall_topological_order_csr(const CsrGraph *csr, int *order) {
+    if (!csr) {
+        return false;
+    }
+
+    DagIndex index;
+    if (!dag_index_build(csr, &index)) {
+        return false;
+    }
+    if (order) {
+        for (int p = 0; p < csr->vertices; p++) {
+            order[p] = index.order[p];
+        }
+    }
+    dag_index_free(&index);
+    return true;
+}
+
+/* Row s from s's position onwards; returns edges relaxed */
+static long long relax_source(Graph *graph, const DagIndex *index, int s) {
+    const CsrGraph *csr = index->csr;
+    int n = graph->vertices;
+    double *distance_s = graph->distance[s];
+    int *next_s = graph->next[s];
+
+    for (int j = 0; j < n; j++) {
+        distance_s[j] = INFINITY_VALUE;
+        next_s[j] = -1;
+    }
+    distance_s[s] = 0.0;
+
+    long long relaxations = 0;
+    for (int p = index->rank[s]; p < n; p++) {
+        int u = index->order[p];
+        double distance_u = distance_s[u];
+        if (distance_u >= INFINITY_VALUE) {
+            continue;
+        }
+        int hop = u == s ? -1 : next_s[u];
+        for (int e = csr->row_ptr[u]; e < csr->row_ptr[u + 1]; e++) {
+            int v = csr->col_idx[e];
+            double candidate = distance_u + csr_graph_weight(csr, e);
+            if (candidate < distance_s[v]) {
+                distance_s[v] = candidate;
+                next_s[v] = hop >= 0 ? hop : v;
+            }
+        }
+        relaxations += csr->row_ptr[u + 1] - csr->row_ptr[u];
+    }
+    return relaxations;
+}
+
+/*
+ * Rows of graph from the edges in csr. With a cycle, graph is filled from
+ * csr (when it is not the source of csr already) and goes to the reference
+ * kernel; after a cancellation the unsolved rows are filled the same way.
+ */
+static FloydWarshallResult dag_execute(const CsrGraph *csr, Graph *graph, bool expand) {
+    FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
+
+    clock_t start_time = clock();
+    DagIndex index;
+    TRACE_BEGIN(order_span);
+    bool acyclic = dag_index_build(csr, &index);
+    TRACE_END(order_span, "topological_order", "phase", NULL, TRACE_NO_ARG);
+
+    /* Cycles (or no memory for the index): the reference kernel handles them */
+    if (!acyclic) {
+        if (expand) {
+            csr_graph_expand(csr, graph);
+        }
+        result = floyd_warshall_execute_checked(graph, FW_NEGATIVE_CYCLE_COMPLETE, NULL);
+        result.execution_time = ((double)(clock() - start_time)) / CLOCKS_PER_SEC;
+        return result;
+    }
+
+    int n = graph->vertices;
+    long long relaxations = 0;
+    int first = 0;
+    for (; first < n; first += DAG_SOURCE_BLOCK) {
+        if (execution_boundary(first, n, relaxations)) {
+            break;
+        }
+        int last = first + DAG_SOURCE_BLOCK < n ? first + DAG_SOURCE_BLOCK : n;
+        TRACE_BEGIN(block_span);
+        #pragma omp parallel for schedule(dynamic, 4) reduction(+:relaxations)
+        for (int s = first; s < last; s++) {
+            relaxations += relax_source(graph, &index, s);
+        }
+        TRACE_END(block_span, "source_block", "kernel", "first_source", first);
+    }
+    dag_index_free(&index);
+    for (int s = first; expand && s < n; s++) {
+        csr_graph_expand_row(csr, graph, s);
+    }
+
+    clock_t end_time = clock();
+    result.execution_time = ((double)(end_time - start_time)) / CLOCKS_PER_SEC;
+    result.iterations = relaxations > INT_MAX ? INT_MAX : (int)relaxations;
+    result.success = true;
+
+    return result;
+}
+
+FloydWarshallResult floyd_warshall_execute_dag(Graph *graph) {
+    FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
+
+    if (!graph || !graph->is_initialized) {
+        return result;
+    }
+
+    if (graph_validate(graph) != SUCCESS) {
+        return result;
+    }
+
+    CsrGraph *csr = csr_graph_from_graph(graph);
+    if (!csr) {
+        return result;
+    }
+    result = dag_execute(csr, graph, false);
+    csr_graph_destroy(csr);
+    return result;
+}
+
+FloydWarshallResult floyd_warshall_execute_dag_csr(const CsrGraph *csr, Graph *graph) {
+    FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
+
+    if (!csr || !graph || !graph->is_initialized || graph->vertices != csr->vertices) {
+        return result;
+    }
+
+    return dag_execute(csr, graph, true);
+}
@@ -0,0 +1,418 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "floyd_warshall.h"
+#include "../utils/trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+/*
+ * Distributed Floyd-Warshall on a 2D process grid. The matrix is split into
+ * grid_rows x grid_cols blocks, one per worker process. In round k the
+ * workers holding row k broadcast their segment of it down their process
+ * column, and the workers holding column k broadcast d[i][k] and next[i][k]
+ * along their process row; then every worker relaxes its own block. Only
+ * rank 0 sees the Graph: it scatters the blocks before the first round and
+ * gathers them after the last, so the workers share nothing but the
+ * transport. Before every round rank 0 polls for cancellation and passes
+ * the answer on, so a cancelled run gathers the state after the same
+ * number of pivots on every rank.
+ */
+typedef struct {
+    int n;
+    int grid_rows;
+    int grid_cols;
+    int row;                   /* Position of this worker in the grid */
+    int col;
+    int row_begin;             /* Matrix rows [row_begin, row_end) */
+    int row_end;
+    int col_begin;             /* Matrix columns [col_begin, col_end) */
+    int col_end;
+} BlockLayout;
+
+/* Most square grid for the process count: rows is the largest divisor <= sqrt */
+static void grid_shape(int processes, int *rows, int *cols) {
+    *rows = 1;
+    for (int r = 1; r * r <= processes; r++) {
+        if (processes % r == 0) {
+            *rows = r;
+        }
+    }
+    *cols = processes / *rows;
+}
+
+static int block_begin(int part, int parts, int n) {
+    return (int)((long long)part * n / parts);
+}
+
+static int block_owner(int index, int parts, int n) {
+    int part = 0;
+    while (part + 1 < parts && block_begin(part + 1, parts, n) <= index) {
+        part++;
+    }
+    return part;
+}
+
+static void block_layout(int n, int processes, int rank, BlockLayout *layout) {
+    layout->n = n;
+    grid_shape(processes, &layout->grid_rows, &layout->grid_cols);
+    layout->row = rank / layout->grid_cols;
+    layout->col = rank % layout->grid_cols;
+    layout->row_begin = block_begin(layout->row, layout->grid_rows, n);
+    layout->row_end = block_begin(layout->row + 1, layout->grid_rows, n);
+    layout->col_begin = block_begin(layout->col, layout->grid_cols, n);
+    layout->col_end = block_begin(layout->col + 1, layout->grid_cols, n);
+}
+
+/* Local block of one worker, row-major */
+typedef struct {
+    int rows;
+    int cols;
+    double *distance;
+    int *next;
+} LocalBlock;
+
+static ReturnCode send_block(Transport *transport, int peer, const LocalBlock *block) {
+    size_t elements = (size_t)block->rows * block->cols;
+    if (transport->send(transport, peer, block->distance, elements * sizeof(double)) != SUCCESS ||
+        transport->send(transport, peer, block->next, elements * sizeof(int)) != SUCCESS) {
+        return ERROR_COMMUNICATION;
+    }
+    return SUCCESS;
+}
+
+static ReturnCode recv_block(Transport *transport, int peer, LocalBlock *block) {
+    size_t elements = (size_t)block->rows * block->cols;
+    if (transport->recv(transport, peer, block->distance, elements * sizeof(double)) != SUCCESS ||
+        transport->recv(transport, peer, block->next, elements * sizeof(int)) != SUCCESS) {
+        return ERROR_COMMUNICATION;
+    }
+    return SUCCESS;
+}
+
+static void copy_block_from_graph(const Graph *graph, const BlockLayout *layout, LocalBlock *block) {
+    for (int i = 0; i < block->rows; i++) {
+        for (int j = 0; j < block->cols; j++) {
+            block->distance[(size_t)i * block->cols + j] = graph->distance[layout->row_begin + i][layout->col_begin + j];
+            block->next[(size_t)i * block->cols + j] = graph->next[layout->row_begin + i][layout->col_begin + j];
+        }
+    }
+}
+
+static void copy_block_to_graph(Graph *graph, const BlockLayout *layout, const LocalBlock *block) {
+    for (int i = 0; i < block->rows; i++) {
+        for (int j = 0; j < block->cols; j++) {
+            graph->distance[layout->row_begin + i][layout->col_begin + j] = block->distance[(size_t)i * block->cols + j];
+            graph->next[layout->row_begin + i][layout->col_begin + j] = block->next[(size_t)i * block->cols + j];
+        }
+    }
+}
+
+static bool local_block_create(LocalBlock *block, int rows, int cols) {
+    size_t elements = (size_t)rows * cols;
+    block->rows = rows;
+    block->cols = cols;
+    block->distance = (double*)malloc((elements > 0 ? elements : 1) * sizeof(double));
+    block->next = (int*)malloc((elements > 0 ? elements : 1) * sizeof(int));
+    return block->distance && block->next;
+}
+
+static void local_block_free(LocalBlock *block) {
+    free(block->distance);
+    free(block->next);
+}
+
+/* Rank 0 sends every other worker its block; the others receive theirs */
+static ReturnCode scatter_blocks(Transport *transport, const Graph *graph, int processes, LocalBlock *block) {
+    if (transport->rank != 0) {
+        return recv_block(transport, 0, block);
+    }
+
+    int n = graph->vertices;
+    for (int rank = 0; rank < processes; rank++) {
+        BlockLayout layout;
+        block_layout(n, processes, rank, &layout);
+        if (rank == 0) {
+            copy_block_from_graph(graph, &layout, block);
+            continue;
+        }
+
+        LocalBlock staging;
+        ReturnCode status = ERROR_MEMORY_ALLOCATION;
+        if (local_block_create(&staging, layout.row_end - layout.row_begin, layout.col_end - layout.col_begin)) {
+            copy_block_from_graph(graph, &layout, &staging);
+            status = send_block(transport, rank, &staging);
+        }
+        local_block_free(&staging);
+        if (status != SUCCESS) {
+            return status;
+        }
+    }
+    return SUCCESS;
+}
+
+static ReturnCode gather_blocks(Transport *transport, Graph *graph, int processes, const LocalBlock *block) {
+    if (transport->rank != 0) {
+        return send_block(transport, 0, block);
+    }
+
+    int n = graph->vertices;
+    for (int rank = 0; rank < processes; rank++) {
+        BlockLayout layout;
+        block_layout(n, processes, rank, &layout);
+        if (rank == 0) {
+            copy_block_to_graph(graph, &layout, block);
+            continue;
+        }
+
+        LocalBlock staging;
+        ReturnCode status = ERROR_MEMORY_ALLOCATION;
+        if (local_block_create(&staging, layout.row_end - layout.row_begin, layout.col_end - layout.col_begin)) {
+            status = recv_block(transport, rank, &staging);
+            if (status == SUCCESS) {
+                copy_block_to_graph(graph, &layout, &staging);
+            }
+        }
+        local_block_free(&staging);
+        if (status != SUCCESS) {
+            return status;
+        }
+    }
+    return SUCCESS;
+}
+
+/* Root sends to every other member of its process column / row, the rest receive */
+static ReturnCode broadcast_column(Transport *transport, const BlockLayout *layout, int root_row,
+                                   void *data, size_t length) {
+    int root = root_row * layout->grid_cols + layout->col;
+    if (transport->rank != root) {
+        return transport->recv(transport, root, data, length);
+    }
+    for (int r = 0; r < layout->grid_rows; r++) {
+        if (r != root_row && transport->send(transport, r * layout->grid_cols + layout->col, data, length) != SUCCESS) {
+            return ERROR_COMMUNICATION;
+        }
+    }
+    return SUCCESS;
+}
+
+static ReturnCode broadcast_row(Transport *transport, const BlockLayout *layout, int root_col,
+                                void *data, size_t length) {
+    int root = layout->row * layout->grid_cols + root_col;
+    if (transport->rank != root) {
+        return transport->recv(transport, root, data, length);
+    }
+    for (int c = 0; c < layout->grid_cols; c++) {
+        if (c != root_col && transport->send(transport, layout->row * layout->grid_cols + c, data, length) != SUCCESS) {
+            return ERROR_COMMUNICATION;
+        }
+    }
+    return SUCCESS;
+}
+
+/*
+ * Rank 0 polls the execution context of the run and tells every other rank
+ * whether to stop, so all of them leave after the same round
+ */
+static ReturnCode agree_on_stop(Transport *transport, int processes, int round, int n, int *stop) {
+    if (transport->rank != 0) {
+        return transport->recv(transport, 0, stop, sizeof(*stop));
+    }
+
+    *stop = execution_boundary(round, n, (long long)n * n * round);
+    for (int rank = 1; rank < processes; rank++) {
+        if (transport->send(transport, rank, stop, sizeof(*stop)) != SUCCESS) {
+            return ERROR_COMMUNICATION;
+        }
+    }
+    return SUCCESS;
+}
+
+/*
+ * One worker: scatter, n broadcast-and-relax rounds (fewer if cancelled; the
+ * count goes to rounds), gather. graph is only used on rank 0.
+ */
+static ReturnCode distributed_worker(Transport *transport, Graph *graph, int n, int processes, int *rounds) {
+    BlockLayout layout;
+    block_layout(n, processes, transport->rank, &layout);
+    int rows = layout.row_end - layout.row_begin;
+    int cols = layout.col_end - layout.col_begin;
+
+    LocalBlock block;
+    double *pivot_row = (double*)malloc((size_t)(cols > 0 ? cols : 1) * sizeof(double));
+    double *pivot_col = (double*)malloc((size_t)(rows > 0 ? rows : 1) * sizeof(double));
+    int *pivot_next = (int*)malloc((size_t)(rows > 0 ? rows : 1) * sizeof(int));
+    ReturnCode status = ERROR_MEMORY_ALLOCATION;
+    if (local_block_create(&block, rows, cols) && pivot_row && pivot_col && pivot_next) {
+        status = scatter_blocks(transport, graph, processes, &block);
+    }
+
+    int k = 0;
+    for (; k < n && status == SUCCESS; k++) {
+        int stop = 0;
+        if (agree_on_stop(transport, processes, k, n, &stop) != SUCCESS) {
+            status = ERROR_COMMUNICATION;
+            break;
+        }
+        if (stop) {
+            break;
+        }
+        TRACE_BEGIN(round_span);
+        int owner_row = block_owner(k, layout.grid_rows, n);
+        int owner_col = block_owner(k, layout.grid_cols, n);
+
+        if (layout.row == owner_row) {
+            memcpy(pivot_row, block.distance + (size_t)(k - layout.row_begin) * cols, (size_t)cols * sizeof(double));
+        }
+        if (layout.col == owner_col) {
+            for (int i = 0; i < rows; i++) {
+                pivot_col[i] = block.distance[(size_t)i * cols + (k - layout.col_begin)];
+                pivot_next[i] = block.next[(size_t)i * cols + (k - layout.col_begin)];
+            }
+        }
+
+        if (broadcast_column(transport, &layout, owner_row, pivot_row, (size_t)cols * sizeof(double)) != SUCCESS ||
+            broadcast_row(transport, &layout, owner_col, pivot_col, (size_t)rows * sizeof(double)) != SUCCESS ||
+            broadcast_row(transport, &layout, owner_col, pivot_next, (size_t)rows * sizeof(int)) != SUCCESS) {
+            status = ERROR_COMMUNICATION;
+            break;
+        }
+
+        /* Same checks and update order as the reference kernel */
+        for (int i = 0; i < rows; i++) {
+            double distance_ik = pivot_col[i];
+            if (distance_ik >= INFINITY_VALUE) {
+                continue;
+            }
+            double *distance_i = block.distance + (size_t)i * cols;
+            int *next_i = block.next + (size_t)i * cols;
+            for (int j = 0; j < cols; j++) {
+                if (pivot_row[j] < INFINITY_VALUE) {
+                    double new_distance = distance_ik + pivot_row[j];
+                    if (new_distance < distance_i[j]) {
+                        distance_i[j] = new_distance;
+                        next_i[j] = pivot_next[i];
+                    }
+                }
+            }
+        }
+        TRACE_END(round_span, "distributed_round", "kernel", "k", k);
+    }
+
+    if (status == SUCCESS) {
+        status = gather_blocks(transport, graph, processes, &block);
+    }
+    *rounds = k;
+
+    local_block_free(&block);
+    free(pivot_row);
+    free(pivot_col);
+    free(pivot_next);
+    return status;
+}
+
+/*
+ * Launcher: forks processes - 1 workers, runs rank 0 itself and waits for
+ * the rest. Any worker failure aborts the transport group so that blocked
+ * peers return instead of waiting forever.
+ */
+FloydWarshallResult floyd_warshall_execute_distributed(Graph *graph, int processes, TransportKind transport) {
+    FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
+
+    if (!graph || !graph->is_initialized) {
+        return result;
+    }
+
+    if (graph_validate(graph) != SUCCESS || processes < 1 || processes > FW_DISTRIBUTED_MAX_PROCESSES) {
+        return result;
+    }
+
+    TransportGroup *group = transport_group_create(transport, processes);
+    if (!group) {
+        return result;
+    }
+
+    int n = graph->vertices;
+    pid_t *workers = (pid_t*)calloc((size_t)processes, sizeof(pid_t));
+    if (!workers) {
+        transport_group_destroy(group);
+        return result;
+    }
+
+    uint64_t start_time = trace_now_ns();
+    bool launched = true;
+    fflush(stdout);
+    fflush(stderr);
+
+    for (int rank = 1; rank < processes; rank++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            Transport *endpoint = transport_attach(group, rank);
+            int rounds = 0;
+            ReturnCode status = endpoint ? distributed_worker(endpoint, NULL, n, processes, &rounds)
+                                         : ERROR_COMMUNICATION;
+            if (status != SUCCESS) {
+                transport_group_abort(group);
+            }
+            transport_close(endpoint);
+            _exit(status == SUCCESS ? 0 : 1);
+        }
+        if (pid < 0) {
+            launched = false;
+            break;
+        }
+        workers[rank] = pid;
+    }
+
+    ReturnCode status = ERROR_COMMUNICATION;
+    int rounds = 0;
+    if (launched) {
+        Transport *endpoint = transport_attach(group, 0);
+        status = endpoint ? distributed_worker(endpoint, graph, n, processes, &rounds) : ERROR_COMMUNICATION;
+        transport_close(endpoint);
+    }
+    if (status != SUCCESS) {
+        /* Workers still waiting on a peer that will never come are stopped outright */
+        transport_group_abort(group);
+        for (int rank = 1; rank < processes; rank++) {
+            if (workers[rank] > 0) {
+                kill(workers[rank], SIGKILL);
+            }
+        }
+    }
+
+    for (int rank = 1; rank < processes; rank++) {
+        int exit_status = 0;
+        if (workers[rank] > 0 &&
+            (waitpid(workers[rank], &exit_status, 0) < 0 || !WIFEXITED(exit_status) || WEXITSTATUS(exit_status) != 0)) {
+            status = ERROR_COMMUNICATION;
+        }
+    }
+
+    free(workers);
+    transport_group_destroy(group);
+
+    if (status != SUCCESS) {
+        return result;
+    }
+
+    /* Check for negative cycles */
+    for (int i = 0; i < n; i++) {
+        if (graph->distance[i][i] < -EPSILON) {
+            result.has_negative_cycle = true;
+            result.negative_cycle_vertex = i;
+            break;
+        }
+    }
+
+    /* Wall time: the work is spread over processes, not this one's CPU time */
+    result.execution_time = (double)(trace_now_ns() - start_time) / 1e9;
+    result.iterations = n * n * rounds;
+    result.success = true;
+
+    return result;
+}
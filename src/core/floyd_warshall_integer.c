@@ -0,0 +1,201 @@
+#include "floyd_warshall.h"
+#include "simd.h"
+#include "../utils/memory_manager.h"
+#include "../utils/trace.h"
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+/*
+ * Integer kernel: when every edge weight is an integer and no simple path
+ * can reach FW_INTEGER_PATH_LIMIT in magnitude, the pivot loop runs on an
+ * int32 copy (SIMD_FLOAT_LANES lanes per vector: 4 on SSE2, 8 on AVX2, 16 on
+ * AVX-512). Integer sums are exact, so the result equals the double kernel's
+ * bit for bit, next hops included. Missing entries hold INTEGER_INFINITY;
+ * a candidate is accepted only inside (-INTEGER_LIMIT, INTEGER_LIMIT), which
+ * saturates both ends: a sum through a missing entry never lands, and values
+ * driven down by a negative cycle stop at -INTEGER_LIMIT instead of
+ * wrapping. No sum of two accepted values leaves int32.
+ *
+ * Results are converted back into graph->distance, so the accessors and
+ * writers see ordinary doubles. On a negative cycle the graph, still
+ * untouched, goes to the double reference kernel.
+ */
+
+#define INTEGER_ALIGNMENT 64
+#define INTEGER_INFINITY (1 << 30)
+#define INTEGER_LIMIT (1 << 29)
+
+#if FW_HAVE_VECTOR_EXTENSIONS
+#define INTEGER_LANES SIMD_FLOAT_LANES
+#else
+#define INTEGER_LANES 1
+#endif
+
+bool floyd_warshall_integral_weights(const Graph *graph) {
+    if (!graph || !graph->is_initialized) {
+        return false;
+    }
+
+    int n = graph->vertices;
+    double largest = 0.0;
+    for (int i = 0; i < n; i++) {
+        const double *row = graph->distance[i];
+        for (int j = 0; j < n; j++) {
+            double weight = row[j];
+            if (i == j || weight >= INFINITY_VALUE) {
+                continue;
+            }
+            if (weight != floor(weight)) {
+                return false;
+            }
+            largest = fmax(largest, fabs(weight));
+        }
+    }
+
+    /* A shortest path has at most n - 1 edges */
+    return largest * (n > 1 ? n - 1 : 1) < (double)FW_INTEGER_PATH_LIMIT;
+}
+
+/* row_i = min(row_i, distance_ik + row_k) over a padded row, next hops by the same mask */
+static void relax_integer_row(int32_t *row_i, int32_t *next_i, const int32_t *row_k,
+                              int32_t distance_ik, int32_t next_ik, int stride) {
+#if FW_HAVE_VECTOR_EXTENSIONS
+    SimdMask32 *row = (SimdMask32*)row_i;
+    SimdMask32 *hops = (SimdMask32*)next_i;
+    const SimdMask32 *pivot = (const SimdMask32*)row_k;
+    SimdMask32 broadcast_distance = distance_ik - (SimdMask32){0};
+    SimdMask32 broadcast_next = next_ik - (SimdMask32){0};
+    for (int v = 0; v < stride / SIMD_FLOAT_LANES; v++) {
+        SimdMask32 candidate = broadcast_distance + pivot[v];
+        SimdMask32 better = (candidate < row[v]) & (candidate < INTEGER_LIMIT) & (candidate > -INTEGER_LIMIT);
+        row[v] = SIMD_SELECT_MASK(better, candidate, row[v]);
+        hops[v] = SIMD_SELECT_MASK(better, broadcast_next, hops[v]);
+    }
+#else
+    for (int j = 0; j < stride; j++) {
+        int32_t candidate = distance_ik + row_k[j];
+        if (candidate < row_i[j] && candidate < INTEGER_LIMIT && candidate > -INTEGER_LIMIT) {
+            row_i[j] = candidate;
+            next_i[j] = next_ik;
+        }
+    }
+#endif
+}
+
+/* Pivot loop; stops early only when the execution context asks it to */
+static long long integer_kernel(int32_t *distance, int32_t *next, int n, int stride) {
+    long long relaxations = 0;
+
+    for (int k = 0; k < n; k++) {
+        if (execution_boundary(k, n, relaxations)) {
+            break;
+        }
+        TRACE_BEGIN(pivot_span);
+        const int32_t *row_k = distance + (size_t)k * stride;
+
+        /* Row k only changes through d[k][k] < 0, which is a negative cycle either way */
+        #pragma omp parallel for schedule(static) reduction(+:relaxations)
+        for (int i = 0; i < n; i++) {
+            int32_t *row_i = distance + (size_t)i * stride;
+            if (i == k || row_i[k] >= INTEGER_LIMIT) {
+                continue;
+            }
+            int32_t *next_i = next + (size_t)i * stride;
+            relax_integer_row(row_i, next_i, row_k, row_i[k], next_i[k], stride);
+            relaxations += n;
+        }
+        TRACE_END(pivot_span, "pivot", "kernel", "k", k);
+    }
+
+    return relaxations;
+}
+
+FloydWarshallResult floyd_warshall_execute_integer_checked(Graph *graph, NegativeCycleInfo *info) {
+    FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
+
+    if (!graph || !graph->is_initialized) {
+        return result;
+    }
+
+    if (graph_validate(graph) != SUCCESS) {
+        return result;
+    }
+
+    /* Fractional or too large weights: the double kernel handles them */
+    if (!floyd_warshall_integral_weights(graph)) {
+        return floyd_warshall_execute_checked(graph, FW_NEGATIVE_CYCLE_COMPLETE, info);
+    }
+
+    clock_t start_time = clock();
+    int n = graph->vertices;
+    int stride = (n + INTEGER_LANES - 1) / INTEGER_LANES * INTEGER_LANES;
+    size_t padded = (size_t)n * (size_t)stride;
+
+    int32_t *distance = (int32_t*)allocate_aligned(padded * sizeof(int32_t), INTEGER_ALIGNMENT);
+    int32_t *next = (int32_t*)allocate_aligned(padded * sizeof(int32_t), INTEGER_ALIGNMENT);
+    if (!distance || !next) {
+        deallocate_aligned(distance, padded * sizeof(int32_t));
+        deallocate_aligned(next, padded * sizeof(int32_t));
+        return result;
+    }
+
+    for (int i = 0; i < n; i++) {
+        int32_t *distance_i = distance + (size_t)i * stride;
+        int32_t *next_i = next + (size_t)i * stride;
+        for (int j = 0; j < stride; j++) {
+            bool finite = j < n && graph->distance[i][j] < INFINITY_VALUE;
+            distance_i[j] = finite ? (int32_t)graph->distance[i][j] : INTEGER_INFINITY;
+            next_i[j] = j < n ? graph->next[i][j] : -1;
+        }
+    }
+
+    long long relaxations = integer_kernel(distance, next, n, stride);
+
+    int negative_vertex = -1;
+    for (int i = 0; i < n && negative_vertex < 0; i++) {
+        if (distance[(size_t)i * stride + i] < 0) {
+            negative_vertex = i;
+        }
+    }
+
+    /* A cancelled run keeps its partial state, negative or not */
+    bool cancelled = execution_current && execution_context_cancelled(execution_current);
+    if (negative_vertex < 0 || cancelled) {
+        TRACE_BEGIN(convert_span);
+        for (int i = 0; i < n; i++) {
+            const int32_t *distance_i = distance + (size_t)i * stride;
+            const int32_t *next_i = next + (size_t)i * stride;
+            for (int j = 0; j < n; j++) {
+                /* Unreached entries keep their input value */
+                if (distance_i[j] != INTEGER_INFINITY) {
+                    graph->distance[i][j] = (double)distance_i[j];
+                }
+                graph->next[i][j] = next_i[j];
+            }
+        }
+        TRACE_END(convert_span, "integer_to_double", "phase", NULL, TRACE_NO_ARG);
+    }
+
+    deallocate_aligned(distance, padded * sizeof(int32_t));
+    deallocate_aligned(next, padded * sizeof(int32_t));
+
+    if (negative_vertex >= 0 && !cancelled) {
+        result = floyd_warshall_execute_checked(graph, FW_NEGATIVE_CYCLE_COMPLETE, info);
+        result.execution_time = ((double)(clock() - start_time)) / CLOCKS_PER_SEC;
+        return result;
+    }
+
+    clock_t end_time = clock();
+    result.execution_time = ((double)(end_time - start_time)) / CLOCKS_PER_SEC;
+    result.iterations = relaxations > INT_MAX ? INT_MAX : (int)relaxations;
+    result.has_negative_cycle = negative_vertex >= 0;
+    result.negative_cycle_vertex = negative_vertex;
+    result.success = true;
+
+    return result;
+}
+
+FloydWarshallResult floyd_warshall_execute_integer(Graph *graph) {
+    return floyd_warshall_execute_integer_checked(graph, NULL);
+}
@@ -0,0 +1,435 @@
+#include "floyd_warshall.h"
+#include "simd.h"
+#include "../utils/memory_manager.h"
+#include "../utils/trace.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+/*
+ * Mixed precision: the pivot loop runs on a float32 copy (twice the lanes
+ * per vector, half the memory traffic), and only its next-hop matrix is
+ * kept. Distances are then recomputed exactly in double along those paths,
+ * and the result is verified against every original edge:
+ * d[i][j] <= w(i,u) + d[u][j]. Rows that violate it are relaxed again in
+ * double until no row changes; when a row changes, its predecessors are
+ * rechecked. The fixpoint is exact shortest paths. Float rounding can
+ * only make the float kernel pick a path that is slightly too long, and
+ * those rows are the ones repaired.
+ *
+ * If the float kernel sees a negative cycle, or the repair does not settle,
+ * the graph (still untouched at that point) goes to the double reference
+ * kernel instead. A cancelled run stops between float pivots and keeps the
+ * paths found so far, with their lengths recomputed in double.
+ */
+
+#define MIXED_ALIGNMENT 64
+
+#if FW_HAVE_VECTOR_EXTENSIONS
+#define MIXED_LANES SIMD_FLOAT_LANES
+#else
+#define MIXED_LANES 1
+#endif
+
+/* Finite off-diagonal entries of the input, by source and by target */
+typedef struct {
+    int *offsets;            /* Edges of u: targets[offsets[u] .. offsets[u + 1]) */
+    int *targets;
+    double *weights;
+    int *reverse_offsets;    /* Predecessors of v: sources[reverse_offsets[v] .. reverse_offsets[v + 1]) */
+    int *sources;
+} MixedEdges;
+
+static void mixed_edges_free(MixedEdges *edges) {
+    free(edges->offsets);
+    free(edges->targets);
+    free(edges->weights);
+    free(edges->reverse_offsets);
+    free(edges->sources);
+}
+
+static bool mixed_edges_build(const Graph *graph, MixedEdges *edges) {
+    int n = graph->vertices;
+    size_t count = 0;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            count += i != j && graph->distance[i][j] < INFINITY_VALUE;
+        }
+    }
+
+    size_t slots = count > 0 ? count : 1;
+    edges->offsets = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    edges->targets = (int*)malloc(slots * sizeof(int));
+    edges->weights = (double*)malloc(slots * sizeof(double));
+    edges->reverse_offsets = (int*)calloc((size_t)n + 1, sizeof(int));
+    edges->sources = (int*)malloc(slots * sizeof(int));
+    if (!edges->offsets || !edges->targets || !edges->weights || !edges->reverse_offsets || !edges->sources) {
+        mixed_edges_free(edges);
+        return false;
+    }
+
+    int edge = 0;
+    for (int i = 0; i < n; i++) {
+        edges->offsets[i] = edge;
+        for (int j = 0; j < n; j++) {
+            if (i != j && graph->distance[i][j] < INFINITY_VALUE) {
+                edges->targets[edge] = j;
+                edges->weights[edge] = graph->distance[i][j];
+                edges->reverse_offsets[j + 1]++;
+                edge++;
+            }
+        }
+    }
+    edges->offsets[n] = edge;
+
+    for (int v = 0; v < n; v++) {
+        edges->reverse_offsets[v + 1] += edges->reverse_offsets[v];
+    }
+    int *fill = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    if (!fill) {
+        mixed_edges_free(edges);
+        return false;
+    }
+    memcpy(fill, edges->reverse_offsets, ((size_t)n + 1) * sizeof(int));
+    for (int u = 0; u < n; u++) {
+        for (int e = edges->offsets[u]; e < edges->offsets[u + 1]; e++) {
+            edges->sources[fill[edges->targets[e]]++] = u;
+        }
+    }
+    free(fill);
+    return true;
+}
+
+/* row_i = min(row_i, distance_ik + row_k) over a padded row, next hops by the same mask */
+static void relax_float_row(float *row_i, int32_t *next_i, const float *row_k,
+                            float distance_ik, int32_t next_ik, int stride) {
+#if FW_HAVE_VECTOR_EXTENSIONS
+    SimdFloats *row = (SimdFloats*)row_i;
+    SimdMask32 *hops = (SimdMask32*)next_i;
+    const SimdFloats *pivot = (const SimdFloats*)row_k;
+    SimdFloats broadcast_distance = distance_ik - (SimdFloats){0};
+    SimdMask32 broadcast_next = next_ik - (SimdMask32){0};
+    for (int v = 0; v < stride / SIMD_FLOAT_LANES; v++) {
+        SimdFloats candidate = broadcast_distance + pivot[v];
+        SimdMask32 better = candidate < row[v];
+        row[v] = SIMD_SELECT_FLOATS(better, candidate, row[v]);
+        hops[v] = SIMD_SELECT_MASK(better, broadcast_next, hops[v]);
+    }
+#else
+    for (int j = 0; j < stride; j++) {
+        float candidate = distance_ik + row_k[j];
+        if (candidate < row_i[j]) {
+            row_i[j] = candidate;
+            next_i[j] = next_ik;
+        }
+    }
+#endif
+}
+
+/* Pivot loop in float; missing entries are +inf so no branch is needed per element. Sets *cancelled if stopped. */
+static long long float_kernel(float *distance, int32_t *next, int n, int stride, bool *cancelled) {
+    long long relaxations = 0;
+
+    *cancelled = false;
+    for (int k = 0; k < n; k++) {
+        if (execution_boundary(k, n, relaxations)) {
+            *cancelled = true;
+            break;
+        }
+        TRACE_BEGIN(pivot_span);
+        const float *row_k = distance + (size_t)k * stride;
+
+        /* Row k only changes through d[k][k] < 0, which is a negative cycle either way */
+        #pragma omp parallel for schedule(static) reduction(+:relaxations)
+        for (int i = 0; i < n; i++) {
+            float *row_i = distance + (size_t)i * stride;
+            if (i == k || isinf(row_i[k])) {
+                continue;
+            }
+            int32_t *next_i = next + (size_t)i * stride;
+            relax_float_row(row_i, next_i, row_k, row_i[k], next_i[k], stride);
+            relaxations += n;
+        }
+        TRACE_END(pivot_span, "pivot", "kernel", "k", k);
+    }
+
+    return relaxations;
+}
+
+/*
+ * Exact distances along the float kernel's paths: for each target j the
+ * next hops form a tree, evaluated from j outwards in double with the
+ * original edge weights. Returns false if a hop chain is broken.
+ */
+static bool trace_paths(const Graph *graph, const int32_t *next, int stride,
+                        double *exact, int *exact_next) {
+    int n = graph->vertices;
+    int broken = 0;
+
+    #pragma omp parallel reduction(+:broken)
+    {
+        int *resolved = (int*)malloc((size_t)n * sizeof(int));
+        int *stack = (int*)malloc((size_t)n * sizeof(int));
+        if (!resolved || !stack) {
+            broken++;
+        } else {
+            for (int v = 0; v < n; v++) {
+                resolved[v] = -1;
+            }
+        }
+
+        #pragma omp for schedule(dynamic, 16)
+        for (int j = 0; j < n; j++) {
+            if (!resolved || !stack) {
+                continue;
+            }
+            exact[(size_t)j * n + j] = graph->distance[j][j];
+            exact_next[(size_t)j * n + j] = graph->next[j][j];
+            resolved[j] = j;
+
+            for (int i = 0; i < n && !broken; i++) {
+                int depth = 0;
+                int v = i;
+                while (resolved[v] != j) {
+                    int hop = next[(size_t)v * stride + j];
+                    if (hop < 0) {
+                        /* No path found: the input entry stays */
+                        exact[(size_t)v * n + j] = graph->distance[v][j];
+                        exact_next[(size_t)v * n + j] = graph->next[v][j];
+                        resolved[v] = j;
+                        break;
+                    }
+                    if (hop >= n || depth == n || graph->distance[v][hop] >= INFINITY_VALUE) {
+                        broken++;
+                        break;
+                    }
+                    stack[depth++] = v;
+                    v = hop;
+                }
+
+                while (depth > 0 && !broken) {
+                    int u = stack[--depth];
+                    int hop = next[(size_t)u * stride + j];
+                    exact[(size_t)u * n + j] = graph->distance[u][hop] + exact[(size_t)hop * n + j];
+                    exact_next[(size_t)u * n + j] = hop;
+                    resolved[u] = j;
+                }
+            }
+        }
+
+        free(resolved);
+        free(stack);
+    }
+
+    return broken == 0;
+}
+
+/* The float matrices as they are, widened to double (missing entries back to INFINITY_VALUE) */
+static void float_to_double(const Graph *graph, const float *distance, const int32_t *next, int stride,
+                            double *exact, int *exact_next) {
+    int n = graph->vertices;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            float value = distance[(size_t)i * stride + j];
+            exact[(size_t)i * n + j] = isinf(value) ? INFINITY_VALUE : (double)value;
+            exact_next[(size_t)i * n + j] = next[(size_t)i * stride + j];
+        }
+    }
+}
+
+/* Mark rows with an edge (i, u) where w(i, u) + d[u][j] beats d[i][j]; returns the count */
+static int verify_rows(const MixedEdges *edges, int n, const double *exact, unsigned char *dirty) {
+    int failed = 0;
+
+    #pragma omp parallel for schedule(dynamic, 16) reduction(+:failed)
+    for (int i = 0; i < n; i++) {
+        const double *row_i = exact + (size_t)i * n;
+        dirty[i] = 0;
+        for (int e = edges->offsets[i]; e < edges->offsets[i + 1] && !dirty[i]; e++) {
+            const double *row_u = exact + (size_t)edges->targets[e] * n;
+            double weight = edges->weights[e];
+            for (int j = 0; j < n; j++) {
+                if (row_u[j] < INFINITY_VALUE && weight + row_u[j] < row_i[j]) {
+                    dirty[i] = 1;
+                    failed++;
+                    break;
+                }
+            }
+        }
+    }
+
+    return failed;
+}
+
+/*
+ * Relax the dirty rows in double until none changes; a changed row queues
+ * its predecessors. Returns the number of distinct entries changed, or -1
+ * on a negative cycle or if a row is relaxed more than n times.
+ */
+static int repair_rows(const MixedEdges *edges, int n, double *exact, int *exact_next, unsigned char *queued) {
+    int *queue = (int*)malloc((size_t)n * sizeof(int));
+    int *passes = (int*)calloc((size_t)n, sizeof(int));
+    unsigned char *touched = (unsigned char*)calloc((size_t)n * (size_t)n, 1);
+    if (!queue || !passes || !touched) {
+        free(queue);
+        free(passes);
+        free(touched);
+        return -1;
+    }
+
+    int head = 0;
+    int size = 0;
+    for (int i = 0; i < n; i++) {
+        if (queued[i]) {
+            queue[(head + size++) % n] = i;
+        }
+    }
+
+    int repaired = 0;
+    bool failed = false;
+    while (size > 0 && !failed) {
+        int i = queue[head];
+        head = (head + 1) % n;
+        size--;
+        queued[i] = 0;
+
+        if (++passes[i] > n) {
+            failed = true;
+            break;
+        }
+
+        double *row_i = exact + (size_t)i * n;
+        int *next_i = exact_next + (size_t)i * n;
+        bool changed = false;
+        for (int e = edges->offsets[i]; e < edges->offsets[i + 1]; e++) {
+            int u = edges->targets[e];
+            const double *row_u = exact + (size_t)u * n;
+            double weight = edges->weights[e];
+            for (int j = 0; j < n; j++) {
+                if (row_u[j] < INFINITY_VALUE && weight + row_u[j] < row_i[j]) {
+                    row_i[j] = weight + row_u[j];
+                    next_i[j] = u;
+                    changed = true;
+                    if (!touched[(size_t)i * n + j]) {
+                        touched[(size_t)i * n + j] = 1;
+                        repaired++;
+                    }
+                }
+            }
+        }
+
+        if (row_i[i] < -EPSILON) {
+            failed = true;
+        } else if (changed) {
+            for (int p = edges->reverse_offsets[i]; p < edges->reverse_offsets[i + 1]; p++) {
+                int predecessor = edges->sources[p];
+                if (!queued[predecessor]) {
+                    queued[predecessor] = 1;
+                    queue[(head + size++) % n] = predecessor;
+                }
+            }
+        }
+    }
+
+    free(queue);
+    free(passes);
+    free(touched);
+    return failed ? -1 : repaired;
+}
+
+FloydWarshallResult floyd_warshall_execute_mixed(Graph *graph) {
+    FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
+
+    if (!graph || !graph->is_initialized) {
+        return result;
+    }
+
+    if (graph_validate(graph) != SUCCESS) {
+        return result;
+    }
+
+    clock_t start_time = clock();
+    int n = graph->vertices;
+    int stride = (n + MIXED_LANES - 1) / MIXED_LANES * MIXED_LANES;
+    size_t padded = (size_t)n * (size_t)stride;
+    size_t cells = (size_t)n * (size_t)n;
+
+    MixedEdges edges;
+    if (!mixed_edges_build(graph, &edges)) {
+        return result;
+    }
+    float *distance = (float*)allocate_aligned(padded * sizeof(float), MIXED_ALIGNMENT);
+    int32_t *next = (int32_t*)allocate_aligned(padded * sizeof(int32_t), MIXED_ALIGNMENT);
+    double *exact = (double*)malloc(cells * sizeof(double));
+    int *exact_next = (int*)malloc(cells * sizeof(int));
+    unsigned char *dirty = (unsigned char*)malloc((size_t)n);
+
+    bool ok = distance && next && exact && exact_next && dirty;
+    long long relaxations = 0;
+    int repaired = -1;
+    if (ok) {
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < stride; j++) {
+                bool finite = j < n && graph->distance[i][j] < INFINITY_VALUE;
+                distance[(size_t)i * stride + j] = finite ? (float)graph->distance[i][j] : HUGE_VALF;
+                next[(size_t)i * stride + j] = j < n ? graph->next[i][j] : -1;
+            }
+        }
+
+        bool cancelled;
+        relaxations = float_kernel(distance, next, n, stride, &cancelled);
+
+        bool negative = false;
+        for (int i = 0; i < n && !negative; i++) {
+            negative = distance[(size_t)i * stride + i] < 0.0f;
+        }
+
+        TRACE_BEGIN(repair_span);
+        if (cancelled) {
+            /* The paths found so far, measured exactly; no repair towards the full solution */
+            if (negative || !trace_paths(graph, next, stride, exact, exact_next)) {
+                float_to_double(graph, distance, next, stride, exact, exact_next);
+            }
+            repaired = 0;
+        } else if (!negative && trace_paths(graph, next, stride, exact, exact_next)) {
+            repaired = verify_rows(&edges, n, exact, dirty) > 0
+                       ? repair_rows(&edges, n, exact, exact_next, dirty) : 0;
+        }
+        TRACE_END(repair_span, "double_repair", "phase", NULL, TRACE_NO_ARG);
+    }
+
+    if (ok && repaired >= 0) {
+        for (int i = 0; i < n; i++) {
+            memcpy(graph->distance[i], exact + (size_t)i * n, (size_t)n * sizeof(double));
+            memcpy(graph->next[i], exact_next + (size_t)i * n, (size_t)n * sizeof(int));
+        }
+    }
+
+    deallocate_aligned(distance, padded * sizeof(float));
+    deallocate_aligned(next, padded * sizeof(int32_t));
+    free(exact);
+    free(exact_next);
+    free(dirty);
+    mixed_edges_free(&edges);
+
+    if (!ok) {
+        return result;
+    }
+
+    /* Negative cycle or no fixpoint: the untouched graph goes to the double kernel */
+    if (repaired < 0) {
+        result = floyd_warshall_execute_checked(graph, FW_NEGATIVE_CYCLE_COMPLETE, NULL);
+        result.repaired_entries = (int)cells;
+        result.execution_time = ((double)(clock() - start_time)) / CLOCKS_PER_SEC;
+        return result;
+    }
+
+    clock_t end_time = clock();
+    result.execution_time = ((double)(end_time - start_time)) / CLOCKS_PER_SEC;
+    result.iterations = relaxations > INT_MAX ? INT_MAX : (int)relaxations;
+    result.repaired_entries = repaired;
+    result.success = true;
+
+    return result;
+}
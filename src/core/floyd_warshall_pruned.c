@@ -0,0 +1,131 @@
+#include "floyd_warshall.h"
+#include "../utils/trace.h"
+#include <stdlib.h>
+#include <time.h>
+
+/*
+ * Sparse reachability index: for every vertex v, the rows i with a finite
+ * d[i][v] (column list) and the columns j with a finite d[v][j] (row list).
+ * Lists only grow, because a finite distance never becomes infinite again.
+ */
+typedef struct {
+    int n;
+    int *column_rows;       /* n x n, column_rows[v * n + t] = t-th row reaching v */
+    int *column_count;
+    int *row_columns;       /* n x n, row_columns[v * n + t] = t-th column reached from v */
+    int *row_count;
+} ReachabilityIndex;
+
+static void reachability_index_free(ReachabilityIndex *index) {
+    free(index->column_rows);
+    free(index->column_count);
+    free(index->row_columns);
+    free(index->row_count);
+}
+
+static bool reachability_index_build(ReachabilityIndex *index, const Graph *graph) {
+    int n = graph->vertices;
+    size_t cells = (size_t)n * (size_t)n;
+
+    index->n = n;
+    index->column_rows = (int*)malloc(cells * sizeof(int));
+    index->column_count = (int*)calloc((size_t)n, sizeof(int));
+    index->row_columns = (int*)malloc(cells * sizeof(int));
+    index->row_count = (int*)calloc((size_t)n, sizeof(int));
+
+    if (!index->column_rows || !index->column_count || !index->row_columns || !index->row_count) {
+        reachability_index_free(index);
+        return false;
+    }
+
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (graph->distance[i][j] < INFINITY_VALUE) {
+                index->row_columns[(size_t)i * n + index->row_count[i]++] = j;
+                index->column_rows[(size_t)j * n + index->column_count[j]++] = i;
+            }
+        }
+    }
+
+    return true;
+}
+
+FloydWarshallResult floyd_warshall_execute_pruned(Graph *graph) {
+    FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
+
+    if (!graph || !graph->is_initialized) {
+        return result;
+    }
+
+    if (graph_validate(graph) != SUCCESS) {
+        return result;
+    }
+
+    ReachabilityIndex index;
+    if (!reachability_index_build(&index, graph)) {
+        return result;
+    }
+
+    clock_t start_time = clock();
+    int n = graph->vertices;
+    long long iterations = 0;
+
+    /*
+     * Only pairs (i, j) with finite d[i][k] and d[k][j] can improve, so the
+     * pivot loop walks the two lists instead of the full n x n square. Neither
+     * list of pivot k changes while k is processed (new finite cells are never
+     * in row k or column k), so the counts are read once per pivot.
+     */
+    for (int k = 0; k < n; k++) {
+        if (execution_boundary(k, n, iterations)) {
+            break;
+        }
+        TRACE_BEGIN(pivot_span);
+        const int *rows = &index.column_rows[(size_t)k * n];
+        const int *columns = &index.row_columns[(size_t)k * n];
+        int row_total = index.column_count[k];
+        int column_total = index.row_count[k];
+
+        for (int r = 0; r < row_total; r++) {
+            int i = rows[r];
+            double distance_ik = graph->distance[i][k];
+            double *distance_i = graph->distance[i];
+            int *next_i = graph->next[i];
+            int next_ik = next_i[k];
+
+            for (int c = 0; c < column_total; c++) {
+                int j = columns[c];
+                double new_distance = distance_ik + graph->distance[k][j];
+                iterations++;
+
+                if (new_distance < distance_i[j]) {
+                    if (distance_i[j] >= INFINITY_VALUE) {
+                        index.row_columns[(size_t)i * n + index.row_count[i]++] = j;
+                        index.column_rows[(size_t)j * n + index.column_count[j]++] = i;
+                    }
+                    distance_i[j] = new_distance;
+                    next_i[j] = next_ik;
+                }
+            }
+        }
+        TRACE_END(pivot_span, "pivot", "kernel", "k", k);
+    }
+
+    /* Check for negative cycles */
+    for (int i = 0; i < n; i++) {
+        if (graph->distance[i][i] < -EPSILON) {
+            result.has_negative_cycle = true;
+            result.negative_cycle_vertex = i;
+            break;
+        }
+    }
+
+    reachability_index_free(&index);
+
+    clock_t end_time = clock();
+    result.execution_time = ((double)(end_time - start_time)) / CLOCKS_PER_SEC;
+    result.iterations = iterations > INT_MAX ? INT_MAX : (int)iterations;
+    result.success = true;
+
+    return result;
+}
@@ -0,0 +1,369 @@
+#include "floyd_warshall.h"
+#include "../utils/trace.h"
+#include <stdlib.h>
+#include <time.h>
+
+/*
+ * Working copy of the matrices, padded to tiles x tiles leaf tiles where
+ * tiles is a power of two. In Morton layout every quadrant at every level
+ * of the recursion is one contiguous block, so locality follows the
+ * recursion without any machine-specific tile size.
+ */
+/* Top-level k-blocks per side: the cancellation points of the recursion */
+#define RECURSIVE_TOP_BLOCKS 8
+
+typedef struct {
+    MatrixLayout layout;
+    int tile;               /* Leaf tile edge length */
+    int tiles;              /* Leaf tiles per side (power of two) */
+    int padded;             /* tile * tiles */
+    double *distance;
+    int *next;
+    long long leaf_calls;   /* Leaf kernel invocations, for the iteration count */
+} RecursiveWorkspace;
+
+/* Interleave tile coordinates; row bits are the more significant of each pair */
+static size_t morton_index(int tile_row, int tile_col) {
+    size_t index = 0;
+    for (int bit = 0; bit < 16; bit++) {
+        index |= (size_t)((tile_col >> bit) & 1) << (2 * bit);
+        index |= (size_t)((tile_row >> bit) & 1) << (2 * bit + 1);
+    }
+    return index;
+}
+
+static size_t tile_offset(const RecursiveWorkspace *ws, int tile_row, int tile_col) {
+    if (ws->layout == FW_LAYOUT_MORTON) {
+        return morton_index(tile_row, tile_col) * (size_t)ws->tile * (size_t)ws->tile;
+    }
+    return (size_t)tile_row * ws->tile * ws->padded + (size_t)tile_col * ws->tile;
+}
+
+static int tile_stride(const RecursiveWorkspace *ws) {
+    return ws->layout == FW_LAYOUT_MORTON ? ws->tile : ws->padded;
+}
+
+/* Offset of logical element (i, j) in the working buffers */
+static size_t element_offset(const RecursiveWorkspace *ws, int i, int j) {
+    return tile_offset(ws, i / ws->tile, j / ws->tile) +
+           (size_t)(i % ws->tile) * tile_stride(ws) + (size_t)(j % ws->tile);
+}
+
+static bool workspace_create(RecursiveWorkspace *ws, const Graph *graph, MatrixLayout layout) {
+    int n = graph->vertices;
+
+    /* Smallest power-of-two tile count whose tiles fit the in-cache base size */
+    ws->tiles = 1;
+    while ((n + ws->tiles - 1) / ws->tiles > FW_RECURSIVE_BASE) {
+        ws->tiles *= 2;
+    }
+    ws->tile = (n + ws->tiles - 1) / ws->tiles;
+    ws->padded = ws->tile * ws->tiles;
+    ws->layout = layout;
+    ws->leaf_calls = 0;
+
+    size_t cells = (size_t)ws->padded * (size_t)ws->padded;
+    ws->distance = (double*)malloc(cells * sizeof(double));
+    ws->next = (int*)malloc(cells * sizeof(int));
+    if (!ws->distance || !ws->next) {
+        free(ws->distance);
+        free(ws->next);
+        return false;
+    }
+
+    /* Padding vertices are isolated, so they never shorten a real path */
+    for (int i = 0; i < ws->padded; i++) {
+        for (int j = 0; j < ws->padded; j++) {
+            size_t offset = element_offset(ws, i, j);
+            if (i < n && j < n) {
+                ws->distance[offset] = graph->distance[i][j];
+                ws->next[offset] = graph->next[i][j];
+            } else {
+                ws->distance[offset] = (i == j) ? 0.0 : INFINITY_VALUE;
+                ws->next[offset] = -1;
+            }
+        }
+    }
+
+    return true;
+}
+
+static void workspace_store(const RecursiveWorkspace *ws, Graph *graph) {
+    for (int i = 0; i < graph->vertices; i++) {
+        for (int j = 0; j < graph->vertices; j++) {
+            size_t offset = element_offset(ws, i, j);
+            graph->distance[i][j] = ws->distance[offset];
+            graph->next[i][j] = ws->next[offset];
+        }
+    }
+}
+
+static void workspace_destroy(RecursiveWorkspace *ws) {
+    free(ws->distance);
+    free(ws->next);
+}
+
+/* Base case: in-cache Floyd-Warshall on a single tile */
+static void leaf_closure(RecursiveWorkspace *ws, int t) {
+    size_t offset = tile_offset(ws, t, t);
+    double *d = ws->distance + offset;
+    int *next = ws->next + offset;
+    int stride = tile_stride(ws);
+    int b = ws->tile;
+
+    for (int k = 0; k < b; k++) {
+        for (int i = 0; i < b; i++) {
+            double d_ik = d[i * stride + k];
+            if (d_ik >= INFINITY_VALUE) {
+                continue;
+            }
+            int next_ik = next[i * stride + k];
+            for (int j = 0; j < b; j++) {
+                double d_kj = d[k * stride + j];
+                if (d_kj < INFINITY_VALUE && d_ik + d_kj < d[i * stride + j]) {
+                    d[i * stride + j] = d_ik + d_kj;
+                    next[i * stride + j] = next_ik;
+                }
+            }
+        }
+    }
+
+    #pragma omp atomic
+    ws->leaf_calls++;
+}
+
+/* Base case: T = min(T, L (x) R) on single tiles */
+static void leaf_minplus(RecursiveWorkspace *ws, int tr, int tc, int lr, int lc, int rr, int rc) {
+    size_t t_offset = tile_offset(ws, tr, tc);
+    size_t l_offset = tile_offset(ws, lr, lc);
+    const double *r = ws->distance + tile_offset(ws, rr, rc);
+    const double *l = ws->distance + l_offset;
+    const int *l_next = ws->next + l_offset;
+    double *t = ws->distance + t_offset;
+    int *t_next = ws->next + t_offset;
+    int stride = tile_stride(ws);
+    int b = ws->tile;
+
+    for (int i = 0; i < b; i++) {
+        for (int k = 0; k < b; k++) {
+            double l_ik = l[i * stride + k];
+            if (l_ik >= INFINITY_VALUE) {
+                continue;
+            }
+            int next_ik = l_next[i * stride + k];
+            for (int j = 0; j < b; j++) {
+                double r_kj = r[k * stride + j];
+                if (r_kj < INFINITY_VALUE && l_ik + r_kj < t[i * stride + j]) {
+                    t[i * stride + j] = l_ik + r_kj;
+                    t_next[i * stride + j] = next_ik;
+                }
+            }
+        }
+    }
+
+    #pragma omp atomic
+    ws->leaf_calls++;
+}
+
+static void minplus(RecursiveWorkspace *ws, int tr, int tc, int lr, int lc, int rr, int rc, int size);
+
+/* T[a][b] = min(T[a][b], L[a][k] (x) R[k][b]) on the half-size quadrants */
+static void quadrant_product(RecursiveWorkspace *ws, int tr, int tc, int lr, int lc, int rr, int rc,
+                             int h, int a, int b, int k) {
+    minplus(ws, tr + a * h, tc + b * h, lr + a * h, lc + k * h, rr + k * h, rc + b * h, h);
+}
+
+/*
+ * T = min(T, L (x) R) over size x size tiles. Target quadrants that do not
+ * read each other run as parallel tasks: all four when T aliases neither
+ * operand, the two column halves when T is R, the two row halves when T is L.
+ */
+static void minplus(RecursiveWorkspace *ws, int tr, int tc, int lr, int lc, int rr, int rc, int size) {
+    if (size == 1) {
+        leaf_minplus(ws, tr, tc, lr, lc, rr, rc);
+        return;
+    }
+
+    int h = size / 2;
+
+    if (tr == rr && tc == rc) {
+        for (int b = 0; b < 2; b++) {
+            #pragma omp task if(size > 2)
+            for (int k = 0; k < 2; k++) {
+                for (int a = 0; a < 2; a++) {
+                    quadrant_product(ws, tr, tc, lr, lc, rr, rc, h, a, b, k);
+                }
+            }
+        }
+        #pragma omp taskwait
+    } else if (tr == lr && tc == lc) {
+        for (int a = 0; a < 2; a++) {
+            #pragma omp task if(size > 2)
+            for (int k = 0; k < 2; k++) {
+                for (int b = 0; b < 2; b++) {
+                    quadrant_product(ws, tr, tc, lr, lc, rr, rc, h, a, b, k);
+                }
+            }
+        }
+        #pragma omp taskwait
+    } else {
+        for (int k = 0; k < 2; k++) {
+            for (int a = 0; a < 2; a++) {
+                for (int b = 0; b < 2; b++) {
+                    #pragma omp task if(size > 2)
+                    quadrant_product(ws, tr, tc, lr, lc, rr, rc, h, a, b, k);
+                }
+            }
+            #pragma omp taskwait
+        }
+    }
+}
+
+/* Kleene closure of the diagonal block starting at tile t */
+static void closure(RecursiveWorkspace *ws, int t, int size) {
+    if (size == 1) {
+        leaf_closure(ws, t);
+        return;
+    }
+
+    int h = size / 2;
+    int a = t, d = t + h;
+
+    closure(ws, a, h);
+
+    /* B = A (x) B and C = C (x) A are independent */
+    #pragma omp task if(size > 2)
+    minplus(ws, a, d, a, a, a, d, h);
+    #pragma omp task if(size > 2)
+    minplus(ws, d, a, d, a, a, a, h);
+    #pragma omp taskwait
+
+    minplus(ws, d, d, d, a, a, d, h);
+    closure(ws, d, h);
+
+    /* B = B (x) D and C = D (x) C are independent */
+    #pragma omp task if(size > 2)
+    minplus(ws, a, d, a, d, d, d, h);
+    #pragma omp task if(size > 2)
+    minplus(ws, d, a, d, d, d, a, h);
+    #pragma omp taskwait
+
+    minplus(ws, a, a, a, d, d, a, h);
+}
+
+/*
+ * The top level is a blocked Floyd-Warshall over at most
+ * RECURSIVE_TOP_BLOCKS x RECURSIVE_TOP_BLOCKS blocks, with the recursion
+ * inside every block: closure of diagonal block kb, its block row and
+ * column, then the remaining blocks as plain products. After k-block kb the
+ * matrices are exactly those after its last pivot, so cancellation is polled
+ * between k-blocks.
+ */
+static void top_level(RecursiveWorkspace *ws, int n) {
+    int blocks = ws->tiles < RECURSIVE_TOP_BLOCKS ? ws->tiles : RECURSIVE_TOP_BLOCKS;
+    int span = ws->tiles / blocks;
+    long long tile_cube = (long long)ws->tile * ws->tile * ws->tile;
+
+    for (int kb = 0; kb < blocks; kb++) {
+        int pivots = kb * span * ws->tile;
+        if (execution_boundary(pivots < n ? pivots : n, n, ws->leaf_calls * tile_cube)) {
+            return;
+        }
+        TRACE_BEGIN(block_span);
+        int k = kb * span;
+
+        #pragma omp parallel
+        #pragma omp single
+        {
+            closure(ws, k, span);
+
+            /* Block row and column only read the closed diagonal block */
+            for (int other = 0; other < blocks; other++) {
+                if (other == kb) {
+                    continue;
+                }
+                int o = other * span;
+                #pragma omp task
+                minplus(ws, k, o, k, k, k, o, span);
+                #pragma omp task
+                minplus(ws, o, k, o, k, k, k, span);
+            }
+            #pragma omp taskwait
+
+            for (int row = 0; row < blocks; row++) {
+                for (int col = 0; col < blocks; col++) {
+                    if (row == kb || col == kb) {
+                        continue;
+                    }
+                    #pragma omp task
+                    minplus(ws, row * span, col * span, row * span, k, k, col * span, span);
+                }
+            }
+            #pragma omp taskwait
+        }
+
+        TRACE_END(block_span, "k_block", "kernel", "k_block", kb);
+    }
+}
+
+FloydWarshallResult floyd_warshall_execute_recursive_layout(Graph *graph, MatrixLayout layout) {
+    FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
+
+    if (!graph || !graph->is_initialized) {
+        return result;
+    }
+
+    if (graph_validate(graph) != SUCCESS) {
+        return result;
+    }
+
+    clock_t start_time = clock();
+
+    RecursiveWorkspace ws;
+    TRACE_BEGIN(pack_span);
+    bool packed = workspace_create(&ws, graph, layout);
+    TRACE_END(pack_span, "pack", "kernel", NULL, TRACE_NO_ARG);
+    if (!packed) {
+        return result;
+    }
+
+    TRACE_BEGIN(closure_span);
+    top_level(&ws, graph->vertices);
+    TRACE_END(closure_span, "kleene_closure", "kernel", NULL, TRACE_NO_ARG);
+
+    workspace_store(&ws, graph);
+
+    /* Check for negative cycles */
+    for (int i = 0; i < graph->vertices; i++) {
+        if (graph->distance[i][i] < -EPSILON) {
+            result.has_negative_cycle = true;
+            result.negative_cycle_vertex = i;
+            break;
+        }
+    }
+
+    /*
+     * The closure products take the first of several equal routes in
+     * quadrant order, not pivot order, so around a zero-weight cycle the
+     * hops towards a target can close on themselves; re-point those.
+     */
+    if (!result.has_negative_cycle) {
+        TRACE_BEGIN(repair_span);
+        floyd_warshall_repair_next(graph);
+        TRACE_END(repair_span, "repair_next", "phase", NULL, TRACE_NO_ARG);
+    }
+
+    long long relaxations = ws.leaf_calls * ws.tile * ws.tile * ws.tile;
+    workspace_destroy(&ws);
+
+    clock_t end_time = clock();
+    result.execution_time = ((double)(end_time - start_time)) / CLOCKS_PER_SEC;
+    result.iterations = relaxations > INT_MAX ? INT_MAX : (int)relaxations;
+    result.success = true;
+
+    return result;
+}
+
+FloydWarshallResult floyd_warshall_execute_recursive(Graph *graph) {
+    return floyd_warshall_execute_recursive_layout(graph, FW_LAYOUT_MORTON);
+}
@@ -0,0 +1,280 @@
+#include "floyd_warshall.h"
+#include "scc.h"
+#include "../utils/trace.h"
+#include <stdlib.h>
+#include <time.h>
+
+/*
+ * Decomposition into strongly connected components: a shortest path between
+ * two vertices of one component never leaves it, so each component is solved
+ * on its own (floyd_warshall_execute on a copy). Pairs in different
+ * components are then combined over the condensation DAG, sinks first: with
+ * the rows of every later component final, the exits of component C are
+ *
+ *     E[u][j] = min over edges (u, v) leaving C of w(u, v) + d[v][j]
+ *
+ * and d[i][j] = min over u in C of d_C[i][u] + E[u][j], a min-plus product of
+ * n_C x n_C by n_C x n. The total is about sum n_C^3 + sum n_C^2 n + m n
+ * instead of n^3.
+ *
+ * A negative cycle lies inside one component; if any component reports one,
+ * the graph (still untouched) goes to the reference kernel instead.
+ */
+
+/* Components up to this size are solved one per thread; larger ones one at a time with parallel kernels */
+#define SCC_PARALLEL_MAX FW_SMALL_MAX_VERTICES
+
+/* Copy of component c with local vertex numbers */
+static Graph* component_graph(const Graph *graph, const SccDecomposition *scc, const int *local, int c) {
+    int size = scc_size(scc, c);
+    const int *members = scc->members + scc->offsets[c];
+    Graph *sub = graph_create(size);
+    if (!sub) {
+        return NULL;
+    }
+
+    for (int a = 0; a < size; a++) {
+        const double *distance_i = graph->distance[members[a]];
+        const int *next_i = graph->next[members[a]];
+        for (int b = 0; b < size; b++) {
+            int hop = next_i[members[b]];
+            if (a != b) {
+                sub->distance[a][b] = distance_i[members[b]];
+            }
+            sub->next[a][b] = hop >= 0 && scc->component[hop] == c ? local[hop] : -1;
+        }
+    }
+    return sub;
+}
+
+/*
+ * Rows of component c: intra-component entries from its solved copy, then
+ * the exits through later components. The rows of c are read (for E) before
+ * any of them is written. exits and exit_next hold n entries per member;
+ * columns (n entries) receives the columns some exit reaches, and E is
+ * packed down to those so the product only runs over reachable targets.
+ */
+static void combine_component(Graph *graph, const SccDecomposition *scc, const Graph *sub, int c,
+                              double *exits, int *exit_next, int *columns) {
+    int n = graph->vertices;
+    int size = scc_size(scc, c);
+    const int *members = scc->members + scc->offsets[c];
+
+    #pragma omp parallel for schedule(dynamic, 4)
+    for (int a = 0; a < size; a++) {
+        const double *distance_u = graph->distance[members[a]];
+        double *exit_a = exits + (size_t)a * n;
+        int *exit_next_a = exit_next + (size_t)a * n;
+        for (int j = 0; j < n; j++) {
+            exit_a[j] = INFINITY_VALUE;
+            exit_next_a[j] = -1;
+        }
+        for (int v = 0; v < n; v++) {
+            double weight = distance_u[v];
+            if (scc->component[v] <= c || weight >= INFINITY_VALUE) {
+                continue;
+            }
+            const double *distance_v = graph->distance[v];
+            for (int j = 0; j < n; j++) {
+                if (distance_v[j] < INFINITY_VALUE && weight + distance_v[j] < exit_a[j]) {
+                    exit_a[j] = weight + distance_v[j];
+                    exit_next_a[j] = v;
+                }
+            }
+        }
+    }
+
+    int reached = 0;
+    for (int j = 0; j < n; j++) {
+        for (int a = 0; a < size; a++) {
+            if (exits[(size_t)a * n + j] < INFINITY_VALUE) {
+                columns[reached++] = j;
+                break;
+            }
+        }
+    }
+
+    #pragma omp parallel for schedule(dynamic, 4)
+    for (int a = 0; a < size; a++) {
+        int i = members[a];
+        double *distance_i = graph->distance[i];
+        int *next_i = graph->next[i];
+
+        if (sub) {
+            for (int b = 0; b < size; b++) {
+                distance_i[members[b]] = sub->distance[a][b];
+                next_i[members[b]] = sub->next[a][b] >= 0 ? members[sub->next[a][b]] : -1;
+            }
+        }
+
+        /* Pack row a of E in place (columns ascend, so no entry is overwritten before it is read) */
+        double *exit_a = exits + (size_t)a * n;
+        int *exit_next_a = exit_next + (size_t)a * n;
+        for (int t = 0; t < reached; t++) {
+            exit_a[t] = exit_a[columns[t]];
+            exit_next_a[t] = exit_next_a[columns[t]];
+        }
+    }
+
+    #pragma omp parallel for schedule(dynamic, 4)
+    for (int a = 0; a < size; a++) {
+        double *distance_i = graph->distance[members[a]];
+        int *next_i = graph->next[members[a]];
+        for (int b = 0; b < size; b++) {
+            double to_exit = sub ? sub->distance[a][b] : 0.0;
+            if (to_exit >= INFINITY_VALUE) {
+                continue;
+            }
+            /* Leaving from i itself takes the exit edge; otherwise the first hop towards u */
+            int hop = b == a ? -1 : members[sub->next[a][b]];
+            const double *exit_b = exits + (size_t)b * n;
+            const int *exit_next_b = exit_next + (size_t)b * n;
+            for (int t = 0; t < reached; t++) {
+                int j = columns[t];
+                if (exit_b[t] < INFINITY_VALUE && to_exit + exit_b[t] < distance_i[j]) {
+                    distance_i[j] = to_exit + exit_b[t];
+                    next_i[j] = hop >= 0 ? hop : exit_next_b[t];
+                }
+            }
+        }
+    }
+}
+
+FloydWarshallResult floyd_warshall_execute_components(Graph *graph, const SccDecomposition *scc) {
+    FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
+
+    if (!graph || !graph->is_initialized || !scc || scc->vertices != graph->vertices) {
+        return result;
+    }
+
+    if (graph_validate(graph) != SUCCESS) {
+        return result;
+    }
+
+    /* One component: nothing to split */
+    if (scc->count == 1) {
+        return floyd_warshall_execute_auto(graph);
+    }
+
+    clock_t start_time = clock();
+    int n = graph->vertices;
+    int count = scc->count;
+    Graph **solved = (Graph**)calloc((size_t)count, sizeof(Graph*));
+    int *local = (int*)malloc((size_t)n * sizeof(int));
+    double *exits = (double*)malloc((size_t)scc->largest * (size_t)n * sizeof(double));
+    int *exit_next = (int*)malloc((size_t)scc->largest * (size_t)n * sizeof(int));
+    int *columns = (int*)malloc((size_t)n * sizeof(int));
+    if (!solved || !local || !exits || !exit_next || !columns) {
+        free(solved);
+        free(local);
+        free(exits);
+        free(exit_next);
+        free(columns);
+        return result;
+    }
+    for (int c = 0; c < count; c++) {
+        for (int a = 0; a < scc_size(scc, c); a++) {
+            local[scc->members[scc->offsets[c] + a]] = a;
+        }
+    }
+
+    /*
+     * Components report to a context of their own (their pivots are not the
+     * graph's) that follows the caller's cancellation. The graph is only
+     * written when the components are combined, so a cancelled run leaves
+     * it as it was: the state after no pivots.
+     */
+    ExecutionContext *context = execution_current;
+    ExecutionContext component_context;
+    execution_context_init(&component_context, NULL, NULL, 0);
+    component_context.parent = context;
+    execution_current = context ? &component_context : NULL;
+
+    long long relaxations = 0;
+    int failures = 0;
+    int negative = 0;
+
+    /* Copies are made serially: graph_create updates the memory manager's counters, which are not thread-safe */
+    for (int c = 0; c < count; c++) {
+        if (scc_size(scc, c) > 1) {
+            solved[c] = component_graph(graph, scc, local, c);
+            failures += !solved[c];
+        }
+    }
+
+    TRACE_BEGIN(solve_span);
+    for (int c = 0; c < count && failures == 0 && !execution_context_cancelled(context); c++) {
+        if (scc_size(scc, c) > SCC_PARALLEL_MAX) {
+            FloydWarshallResult part = floyd_warshall_execute_auto(solved[c]);
+            relaxations += part.iterations;
+            failures += !part.success;
+            negative += part.has_negative_cycle;
+        }
+    }
+
+    bool cancelled = execution_context_cancelled(context);
+    if (!cancelled && failures == 0) {
+        #pragma omp parallel for schedule(dynamic, 1) reduction(+:relaxations, failures, negative)
+        for (int c = 0; c < count; c++) {
+            int size = scc_size(scc, c);
+            if (size > 1 && size <= SCC_PARALLEL_MAX) {
+                FloydWarshallResult part = floyd_warshall_execute_auto(solved[c]);
+                relaxations += part.iterations;
+                failures += !part.success;
+                negative += part.has_negative_cycle;
+            }
+        }
+    }
+    TRACE_END(solve_span, "solve_components", "phase", "components", count);
+    execution_current = context;
+    cancelled = cancelled || execution_context_cancelled(context);
+
+    /* Sinks first, so the rows an exit leads to are final */
+    TRACE_BEGIN(combine_span);
+    for (int c = count - 1; c >= 0 && failures == 0 && negative == 0 && !cancelled; c--) {
+        combine_component(graph, scc, solved[c], c, exits, exit_next, columns);
+        relaxations += (long long)scc_size(scc, c) * scc_size(scc, c) * n;
+    }
+    TRACE_END(combine_span, "combine_components", "phase", NULL, TRACE_NO_ARG);
+
+    for (int c = 0; c < count; c++) {
+        graph_destroy(solved[c]);
+    }
+    free(solved);
+    free(local);
+    free(exits);
+    free(exit_next);
+    free(columns);
+
+    if (failures > 0) {
+        return result;
+    }
+
+    if (cancelled) {
+        /* Records the stop at pivot 0 in the caller's context */
+        execution_boundary(0, n, relaxations);
+    } else if (negative > 0) {
+        result = floyd_warshall_execute_checked(graph, FW_NEGATIVE_CYCLE_COMPLETE, NULL);
+        result.execution_time = ((double)(clock() - start_time)) / CLOCKS_PER_SEC;
+        return result;
+    }
+
+    clock_t end_time = clock();
+    result.execution_time = ((double)(end_time - start_time)) / CLOCKS_PER_SEC;
+    result.iterations = relaxations > INT_MAX ? INT_MAX : (int)relaxations;
+    result.success = true;
+
+    return result;
+}
+
+FloydWarshallResult floyd_warshall_execute_scc(Graph *graph) {
+    FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
+
+    SccDecomposition *scc = scc_decompose(graph);
+    if (!scc) {
+        return result;
+    }
+    result = floyd_warshall_execute_components(graph, scc);
+    scc_destroy(scc);
+    return result;
+}
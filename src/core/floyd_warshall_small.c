@@ -0,0 +1,181 @@
+#include "floyd_warshall.h"
+#include "simd.h"
+#include "../utils/trace.h"
+#include <string.h>
+#include <time.h>
+#include <math.h>
+
+/*
+ * One kernel per padded size N = 8, 16, 32 and 64. A graph with n <= N
+ * vertices is copied into stack arrays with row stride N; columns n..N-1 are
+ * padding that stays at INFINITY_VALUE. Only the column (j) loop is
+ * specialized: its trip count is the constant N, so with vector extensions
+ * it becomes N / SIMD_LANES vector operations under GCC unroll pragmas (a
+ * hint, not a guarantee), and elsewhere a plain loop of constant length.
+ * The pivot (k) and row (i) loops are ordinary runtime loops over the n
+ * real vertices and are not unrolled.
+ *
+ * Semantics match the reference kernel exactly: the pivot row is copied with
+ * entries >= INFINITY_VALUE replaced by HUGE_VAL (d[k][j] < INF check), rows
+ * with d[i][k] >= INFINITY_VALUE are skipped, and updates use the same strict
+ * comparison in the same k, i, j order.
+ */
+#if FW_HAVE_VECTOR_EXTENSIONS
+
+#define DEFINE_SMALL_KERNEL(N)                                                       \
+static void small_kernel_##N(int n, SimdDoubles *distance, SimdMask *next) {         \
+    SimdDoubles pivot_row[N / SIMD_LANES];                                           \
+    double *pivot = (double*)pivot_row;                                              \
+    for (int k = 0; k < n; k++) {                                                    \
+        const double *row_k = (const double*)(distance + k * (N / SIMD_LANES));      \
+        _Pragma("GCC unroll 64")                                                     \
+        for (int j = 0; j < N; j++) {                                                \
+            pivot[j] = row_k[j] < INFINITY_VALUE ? row_k[j] : HUGE_VAL;              \
+        }                                                                            \
+        for (int i = 0; i < n; i++) {                                                \
+            SimdDoubles *row_i = distance + i * (N / SIMD_LANES);                    \
+            SimdMask *next_i = next + i * (N / SIMD_LANES);                          \
+            double distance_ik = ((const double*)row_i)[k];                          \
+            if (distance_ik >= INFINITY_VALUE) {                                     \
+                continue;                                                            \
+            }                                                                        \
+            SimdDoubles broadcast_distance = distance_ik - (SimdDoubles){0};         \
+            SimdMask broadcast_next = ((const int64_t*)next_i)[k] - (SimdMask){0};   \
+            _Pragma("GCC unroll 32")                                                 \
+            for (int v = 0; v < N / SIMD_LANES; v++) {                               \
+                SimdDoubles candidate = broadcast_distance + pivot_row[v];           \
+                SimdMask better = candidate < row_i[v];                              \
+                row_i[v] = SIMD_SELECT_DOUBLES(better, candidate, row_i[v]);         \
+                next_i[v] = SIMD_SELECT_MASK(better, broadcast_next, next_i[v]);     \
+            }                                                                        \
+        }                                                                            \
+    }                                                                                \
+}
+
+typedef SimdDoubles SmallDistance;
+typedef SimdMask SmallNext;
+#define SMALL_ELEMENTS(N) ((N) * (N) / SIMD_LANES)
+
+#else
+
+#define DEFINE_SMALL_KERNEL(N)                                                       \
+static void small_kernel_##N(int n, double *distance, int64_t *next) {              \
+    double pivot[N];                                                                 \
+    for (int k = 0; k < n; k++) {                                                    \
+        const double *row_k = distance + k * N;                                      \
+        for (int j = 0; j < N; j++) {                                                \
+            pivot[j] = row_k[j] < INFINITY_VALUE ? row_k[j] : HUGE_VAL;              \
+        }                                                                            \
+        for (int i = 0; i < n; i++) {                                                \
+            double *row_i = distance + i * N;                                        \
+            int64_t *next_i = next + i * N;                                          \
+            double distance_ik = row_i[k];                                           \
+            if (distance_ik >= INFINITY_VALUE) {                                     \
+                continue;                                                            \
+            }                                                                        \
+            int64_t next_ik = next_i[k];                                             \
+            for (int j = 0; j < N; j++) {                                            \
+                double candidate = distance_ik + pivot[j];                           \
+                if (candidate < row_i[j]) {                                          \
+                    row_i[j] = candidate;                                            \
+                    next_i[j] = next_ik;                                             \
+                }                                                                    \
+            }                                                                        \
+        }                                                                            \
+    }                                                                                \
+}
+
+typedef double SmallDistance;
+typedef int64_t SmallNext;
+#define SMALL_ELEMENTS(N) ((N) * (N))
+
+#endif
+
+DEFINE_SMALL_KERNEL(8)
+DEFINE_SMALL_KERNEL(16)
+DEFINE_SMALL_KERNEL(32)
+DEFINE_SMALL_KERNEL(64)
+
+/* Smallest specialized size that holds n vertices, or 0 if none does */
+static int small_kernel_size(int n) {
+    for (int size = 8; size <= FW_SMALL_MAX_VERTICES; size *= 2) {
+        if (n <= size) {
+            return size;
+        }
+    }
+    return 0;
+}
+
+FloydWarshallResult floyd_warshall_execute_small(Graph *graph) {
+    FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
+
+    if (!graph || !graph->is_initialized) {
+        return result;
+    }
+
+    int n = graph->vertices;
+    int size = small_kernel_size(n);
+    if (size == 0) {
+        return floyd_warshall_execute_checked(graph, FW_NEGATIVE_CYCLE_COMPLETE, NULL);
+    }
+
+    if (graph_validate(graph) != SUCCESS) {
+        return result;
+    }
+
+    clock_t start_time = clock();
+
+    /* Working copy on the stack, padded to the kernel size */
+    SmallDistance distance_storage[SMALL_ELEMENTS(FW_SMALL_MAX_VERTICES)];
+    SmallNext next_storage[SMALL_ELEMENTS(FW_SMALL_MAX_VERTICES)];
+    double *distance = (double*)distance_storage;
+    int64_t *next = (int64_t*)next_storage;
+
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < size; j++) {
+            bool real = i < n && j < n;
+            distance[i * size + j] = real ? graph->distance[i][j] : (i == j ? 0.0 : INFINITY_VALUE);
+            next[i * size + j] = real ? graph->next[i][j] : -1;
+        }
+    }
+
+    TRACE_BEGIN(kernel_span);
+    switch (size) {
+        case 8:
+            small_kernel_8(n, distance_storage, next_storage);
+            break;
+        case 16:
+            small_kernel_16(n, distance_storage, next_storage);
+            break;
+        case 32:
+            small_kernel_32(n, distance_storage, next_storage);
+            break;
+        default:
+            small_kernel_64(n, distance_storage, next_storage);
+            break;
+    }
+    TRACE_END(kernel_span, "small_kernel", "kernel", "kernel_size", size);
+
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            graph->distance[i][j] = distance[i * size + j];
+            graph->next[i][j] = (int)next[i * size + j];
+        }
+    }
+
+    /* Check for negative cycles */
+    for (int i = 0; i < n; i++) {
+        if (graph->distance[i][i] < -EPSILON) {
+            result.has_negative_cycle = true;
+            result.negative_cycle_vertex = i;
+            break;
+        }
+    }
+
+    clock_t end_time = clock();
+    result.execution_time = ((double)(end_time - start_time)) / CLOCKS_PER_SEC;
+    result.iterations = n * n * n;
+    result.success = true;
+
+    return result;
+}
@@ -0,0 +1,101 @@
+#include "floyd_warshall.h"
+#include "minplus_gemm.h"
+#include "../utils/trace.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * Repeated squaring: after round r the matrix holds shortest paths of at
+ * most 2^r edges, so ceil(log2(n)) rounds of D = min(D, D (x) D) suffice
+ * and the loop stops as soon as a round changes nothing. Each round reads
+ * a frozen copy of D and is split into independent row stripes.
+ */
+FloydWarshallResult floyd_warshall_execute_squaring(Graph *graph) {
+    FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
+
+    if (!graph || !graph->is_initialized) {
+        return result;
+    }
+
+    if (graph_validate(graph) != SUCCESS) {
+        return result;
+    }
+
+    Graph *previous = graph_copy(graph);
+    if (!previous) {
+        return result;
+    }
+
+    clock_t start_time = clock();
+    int n = graph->vertices;
+    int stripes = (n + MINPLUS_MC - 1) / MINPLUS_MC;
+    long long relaxations = 0;
+    int failures = 0;
+
+    int max_rounds = 1;
+    while ((1 << max_rounds) < n) {
+        max_rounds++;
+    }
+
+    for (int round = 0; round < max_rounds && failures == 0; round++) {
+        if (execution_boundary(round, max_rounds, relaxations)) {
+            break;
+        }
+        TRACE_BEGIN(round_span);
+
+        MinPlusView a = {previous->distance, previous->next, 0, 0};
+        MinPlusView b = {previous->distance, NULL, 0, 0};
+
+        #pragma omp parallel for schedule(dynamic) reduction(+:failures)
+        for (int s = 0; s < stripes; s++) {
+            int row = s * MINPLUS_MC;
+            int rows = (row + MINPLUS_MC < n ? row + MINPLUS_MC : n) - row;
+            MinPlusView stripe_a = a;
+            MinPlusView stripe_c = {graph->distance, graph->next, row, 0};
+            stripe_a.row0 = row;
+            if (minplus_gemm(rows, n, n, &stripe_a, &b, &stripe_c) != SUCCESS) {
+                failures++;
+            }
+        }
+        relaxations += (long long)n * n * n;
+
+        /* Converged when the round improved nothing; otherwise freeze it for the next */
+        bool changed = false;
+        for (int i = 0; i < n; i++) {
+            if (memcmp(graph->distance[i], previous->distance[i], (size_t)n * sizeof(double)) != 0) {
+                changed = true;
+                memcpy(previous->distance[i], graph->distance[i], (size_t)n * sizeof(double));
+                memcpy(previous->next[i], graph->next[i], (size_t)n * sizeof(int));
+            }
+        }
+
+        TRACE_END(round_span, "squaring_round", "kernel", "round", round);
+
+        if (!changed) {
+            break;
+        }
+    }
+
+    graph_destroy(previous);
+
+    if (failures > 0) {
+        return result;
+    }
+
+    /* Check for negative cycles */
+    for (int i = 0; i < n; i++) {
+        if (graph->distance[i][i] < -EPSILON) {
+            result.has_negative_cycle = true;
+            result.negative_cycle_vertex = i;
+            break;
+        }
+    }
+
+    clock_t end_time = clock();
+    result.execution_time = ((double)(end_time - start_time)) / CLOCKS_PER_SEC;
+    result.iterations = relaxations > INT_MAX ? INT_MAX : (int)relaxations;
+    result.success = true;
+
+    return result;
+}
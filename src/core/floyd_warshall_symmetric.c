@@ -0,0 +1,195 @@
+#include "floyd_warshall.h"
+#include "../utils/trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*
+ * Floyd-Warshall on the packed upper triangle. For pivot k the column
+ * d[.][k] equals row k, so it is gathered once into a contiguous vector;
+ * then every row i only relaxes j >= i, which is half the square. Rows are
+ * independent for a fixed pivot and run in parallel.
+ */
+FloydWarshallResult floyd_warshall_execute_symmetric(SymmetricGraph *graph) {
+    FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
+
+    if (!graph || !graph->is_initialized) {
+        return result;
+    }
+
+    if (symmetric_graph_validate(graph) != SUCCESS) {
+        return result;
+    }
+
+    int n = graph->vertices;
+    double *pivot_row = (double*)malloc((size_t)n * sizeof(double));
+    if (!pivot_row) {
+        return result;
+    }
+
+    clock_t start_time = clock();
+    long long relaxations = 0;
+
+    for (int k = 0; k < n; k++) {
+        TRACE_BEGIN(pivot_span);
+        for (int x = 0; x < n; x++) {
+            pivot_row[x] = graph->distance[symmetric_graph_index(n, k, x)];
+        }
+
+        #pragma omp parallel for schedule(dynamic, 16) reduction(+:relaxations)
+        for (int i = 0; i < n; i++) {
+            double distance_ik = pivot_row[i];
+            if (distance_ik >= INFINITY_VALUE) {
+                continue;
+            }
+
+            /* Shift so that row[j] addresses (i, j) for j >= i */
+            size_t offset = symmetric_graph_index(n, i, i) - (size_t)i;
+            double *row = graph->distance + offset;
+            int *via = graph->via + offset;
+            relaxations += n - i;
+
+            for (int j = i; j < n; j++) {
+                if (pivot_row[j] < INFINITY_VALUE) {
+                    double new_distance = distance_ik + pivot_row[j];
+                    if (new_distance < row[j]) {
+                        row[j] = new_distance;
+                        via[j] = k;
+                    }
+                }
+            }
+        }
+        TRACE_END(pivot_span, "pivot", "kernel", "k", k);
+    }
+
+    free(pivot_row);
+
+    /* Check for negative cycles (any negative edge is one when undirected) */
+    for (int i = 0; i < n; i++) {
+        if (graph->distance[symmetric_graph_index(n, i, i)] < -EPSILON) {
+            result.has_negative_cycle = true;
+            result.negative_cycle_vertex = i;
+            break;
+        }
+    }
+
+    clock_t end_time = clock();
+    result.execution_time = ((double)(end_time - start_time)) / CLOCKS_PER_SEC;
+    result.iterations = relaxations > INT_MAX ? INT_MAX : (int)relaxations;
+    result.success = true;
+
+    return result;
+}
+
+/*
+ * Expand the path through the recorded intermediates: (i, j) with
+ * intermediate k is (i, k) followed by (k, j). Segments are kept on an
+ * explicit stack; a path longer than n vertices means via is inconsistent
+ * (negative cycle) and the reconstruction fails.
+ */
+int* floyd_warshall_get_path_symmetric(const SymmetricGraph *graph, int start, int end, int *path_length) {
+    if (!graph || !graph->is_initialized || !path_length ||
+        start < 0 || start >= graph->vertices ||
+        end < 0 || end >= graph->vertices) {
+        if (path_length) *path_length = 0;
+        return NULL;
+    }
+
+    int n = graph->vertices;
+    *path_length = 0;
+
+    /* Check if path exists */
+    if (graph->distance[symmetric_graph_index(n, start, end)] >= INFINITY_VALUE) {
+        return NULL;
+    }
+
+    int *path = (int*)malloc((size_t)n * sizeof(int));
+    int *stack = (int*)malloc(2 * (size_t)n * sizeof(int));
+    if (!path || !stack) {
+        free(path);
+        free(stack);
+        return NULL;
+    }
+
+    int count = 0;
+    int top = 0;
+    bool valid = true;
+    path[count++] = start;
+    stack[top++] = end;
+    int from = start;
+
+    /* The stack holds pending segment end points; the top is the next target */
+    while (top > 0 && valid) {
+        int to = stack[top - 1];
+        int via = (from == to) ? -1 : graph->via[symmetric_graph_index(n, from, to)];
+
+        if (via < 0) {
+            top--;
+            if (from != to) {
+                if (count >= n) {
+                    valid = false;
+                    break;
+                }
+                path[count++] = to;
+                from = to;
+            }
+        } else if (top >= 2 * n) {
+            valid = false;
+        } else {
+            stack[top++] = via;
+        }
+    }
+
+    free(stack);
+    if (!valid) {
+        free(path);
+        return NULL;
+    }
+
+    *path_length = count;
+    return path;
+}
+
+double floyd_warshall_get_distance_symmetric(const SymmetricGraph *graph, int start, int end) {
+    return symmetric_graph_get_edge(graph, start, end);
+}
+
+void floyd_warshall_print_path_symmetric(const SymmetricGraph *graph, int start, int end) {
+    if (!graph || !graph->is_initialized) {
+        printf("Invalid graph\n");
+        return;
+    }
+
+    if (start < 0 || start >= graph->vertices ||
+        end < 0 || end >= graph->vertices) {
+        printf("Invalid start or end vertex\n");
+        return;
+    }
+
+    double distance = floyd_warshall_get_distance_symmetric(graph, start, end);
+    printf("Shortest distance between %d and %d: ", start, end);
+
+    if (distance >= INFINITY_VALUE) {
+        printf("No path exists\n");
+        return;
+    }
+
+    printf("%.2f\n", distance);
+
+    int path_length;
+    int *path = floyd_warshall_get_path_symmetric(graph, start, end, &path_length);
+
+    if (path) {
+        printf("Path: ");
+        for (int i = 0; i < path_length; i++) {
+            printf("%d", path[i]);
+            if (i < path_length - 1) {
+                printf(" -- ");
+            }
+        }
+        printf("\n");
+        free(path);
+    } else {
+        printf("Path reconstruction failed\n");
+    }
+}
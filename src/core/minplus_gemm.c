@@ -0,0 +1,227 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include "minplus_gemm.h"
+#include <math.h>
+#include <stdlib.h>
+
+/* Packed panels start on a cache line */
+#define MINPLUS_ALIGNMENT 64
+
+static int min_int(int a, int b) {
+    return a < b ? a : b;
+}
+
+static int round_up(int value, int multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+/* Missing entries become +inf so sums with them can never win a comparison */
+static double pack_value(double value) {
+    return value >= INFINITY_VALUE ? HUGE_VAL : value;
+}
+
+/*
+ * Pack an mc x kc block of A into MR-row micro-panels: within a panel the
+ * MR values of one column p are contiguous. Rows past mc are padded.
+ */
+static void pack_a(const MinPlusView *a, int row, int col, int mc, int kc, double *packed) {
+    for (int panel = 0; panel < mc; panel += MINPLUS_MR) {
+        for (int p = 0; p < kc; p++) {
+            for (int r = 0; r < MINPLUS_MR; r++) {
+                int i = panel + r;
+                *packed++ = (i < mc) ? pack_value(a->rows[a->row0 + row + i][a->col0 + col + p]) : HUGE_VAL;
+            }
+        }
+    }
+}
+
+/* Pack a kc x nc panel of B into NR-column micro-panels, row p of each contiguous */
+static void pack_b(const MinPlusView *b, int row, int col, int kc, int nc, double *packed) {
+    for (int panel = 0; panel < nc; panel += MINPLUS_NR) {
+        for (int p = 0; p < kc; p++) {
+            const double *b_row = b->rows[b->row0 + row + p] + b->col0 + col;
+            for (int c = 0; c < MINPLUS_NR; c++) {
+                int j = panel + c;
+                *packed++ = (j < nc) ? pack_value(b_row[j]) : HUGE_VAL;
+            }
+        }
+    }
+}
+
+/*
+ * MR x NR register block: best[r][c] = min over p of A[r][p] + B[p][c].
+ * The body is a pure add/min so it maps to packed min instructions on any
+ * SIMD width; the winning pivot is recovered later only for improved cells.
+ */
+static void micro_kernel(int kc, const double *packed_a, const double *packed_b,
+                         double best[MINPLUS_MR][MINPLUS_NR]) {
+    double acc[MINPLUS_MR * MINPLUS_NR];
+
+    for (int t = 0; t < MINPLUS_MR * MINPLUS_NR; t++) {
+        acc[t] = HUGE_VAL;
+    }
+
+    for (int p = 0; p < kc; p++) {
+        const double *a_column = packed_a + p * MINPLUS_MR;
+        const double *b_row = packed_b + p * MINPLUS_NR;
+
+        for (int r = 0; r < MINPLUS_MR; r++) {
+            double a_value = a_column[r];
+            double *acc_row = acc + r * MINPLUS_NR;
+            #pragma omp simd
+            for (int c = 0; c < MINPLUS_NR; c++) {
+                double sum = a_value + b_row[c];
+                acc_row[c] = (sum < acc_row[c]) ? sum : acc_row[c];
+            }
+        }
+    }
+
+    for (int r = 0; r < MINPLUS_MR; r++) {
+        for (int c = 0; c < MINPLUS_NR; c++) {
+            best[r][c] = acc[r * MINPLUS_NR + c];
+        }
+    }
+}
+
+/* First pivot p whose sum reproduces best exactly (same operands, same rounding) */
+static int find_winner(int kc, const double *packed_a, const double *packed_b, int r, int c, double best) {
+    for (int p = 0; p < kc; p++) {
+        if (packed_a[p * MINPLUS_MR + r] + packed_b[p * MINPLUS_NR + c] == best) {
+            return p;
+        }
+    }
+    return 0;
+}
+
+/* Merge a register block into C at (row, col), taking next hops from A's pivot columns */
+static void store_block(const MinPlusView *a, MinPlusView *c, int row, int col, int col_a,
+                        int mr, int nr, int kc, const double *packed_a, const double *packed_b,
+                        double best[MINPLUS_MR][MINPLUS_NR]) {
+    bool track_next = (a->next_rows != NULL && c->next_rows != NULL);
+
+    for (int r = 0; r < mr; r++) {
+        double *c_row = c->rows[c->row0 + row + r] + c->col0 + col;
+        for (int j = 0; j < nr; j++) {
+            if (best[r][j] < c_row[j]) {
+                c_row[j] = best[r][j];
+                if (track_next) {
+                    int p = find_winner(kc, packed_a, packed_b, r, j, best[r][j]);
+                    c->next_rows[c->row0 + row + r][c->col0 + col + j] =
+                        a->next_rows[a->row0 + row + r][a->col0 + col_a + p];
+                }
+            }
+        }
+    }
+}
+
+void minplus_workspace_init(MinPlusWorkspace *workspace) {
+    workspace->packed_a = NULL;
+    workspace->packed_b = NULL;
+    workspace->a_cells = 0;
+    workspace->b_cells = 0;
+}
+
+void minplus_workspace_release(MinPlusWorkspace *workspace) {
+    if (!workspace) {
+        return;
+    }
+
+    free(workspace->packed_a);
+    free(workspace->packed_b);
+    minplus_workspace_init(workspace);
+}
+
+/* Grow one packing buffer to at least cells doubles */
+static ReturnCode reserve_panel(double **panel, size_t *capacity, size_t cells) {
+    if (cells <= *capacity) {
+        return SUCCESS;
+    }
+
+    void *grown = NULL;
+    if (posix_memalign(&grown, MINPLUS_ALIGNMENT, cells * sizeof(double)) != 0) {
+        return ERROR_MEMORY_ALLOCATION;
+    }
+    free(*panel);
+    *panel = (double*)grown;
+    *capacity = cells;
+    return SUCCESS;
+}
+
+ReturnCode minplus_workspace_reserve(MinPlusWorkspace *workspace, int m, int n, int k) {
+    if (!workspace) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if (m <= 0 || n <= 0 || k <= 0) {
+        return SUCCESS;
+    }
+
+    int kc_max = min_int(k, MINPLUS_KC);
+    size_t a_cells = (size_t)round_up(min_int(m, MINPLUS_MC), MINPLUS_MR) * (size_t)kc_max;
+    size_t b_cells = (size_t)kc_max * (size_t)round_up(min_int(n, MINPLUS_NC), MINPLUS_NR);
+
+    if (reserve_panel(&workspace->packed_a, &workspace->a_cells, a_cells) != SUCCESS ||
+        reserve_panel(&workspace->packed_b, &workspace->b_cells, b_cells) != SUCCESS) {
+        return ERROR_MEMORY_ALLOCATION;
+    }
+    return SUCCESS;
+}
+
+ReturnCode minplus_gemm(int m, int n, int k, const MinPlusView *a, const MinPlusView *b, MinPlusView *c) {
+    return minplus_gemm_workspace(m, n, k, a, b, c, NULL);
+}
+
+ReturnCode minplus_gemm_workspace(int m, int n, int k, const MinPlusView *a, const MinPlusView *b,
+                                  MinPlusView *c, MinPlusWorkspace *workspace) {
+    if (!a || !b || !c || !a->rows || !b->rows || !c->rows) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if (m < 0 || n < 0 || k < 0) {
+        return ERROR_INVALID_INPUT;
+    }
+
+    if (m == 0 || n == 0 || k == 0) {
+        return SUCCESS;
+    }
+
+    MinPlusWorkspace temporary;
+    minplus_workspace_init(&temporary);
+    MinPlusWorkspace *buffers = workspace ? workspace : &temporary;
+    if (minplus_workspace_reserve(buffers, m, n, k) != SUCCESS) {
+        minplus_workspace_release(&temporary);
+        return ERROR_MEMORY_ALLOCATION;
+    }
+    double *packed_a = buffers->packed_a;
+    double *packed_b = buffers->packed_b;
+
+    double best[MINPLUS_MR][MINPLUS_NR];
+
+    for (int jc = 0; jc < n; jc += MINPLUS_NC) {
+        int nc = min_int(MINPLUS_NC, n - jc);
+
+        for (int pc = 0; pc < k; pc += MINPLUS_KC) {
+            int kc = min_int(MINPLUS_KC, k - pc);
+            pack_b(b, pc, jc, kc, nc, packed_b);
+
+            for (int ic = 0; ic < m; ic += MINPLUS_MC) {
+                int mc = min_int(MINPLUS_MC, m - ic);
+                pack_a(a, ic, pc, mc, kc, packed_a);
+
+                for (int jr = 0; jr < nc; jr += MINPLUS_NR) {
+                    const double *b_panel = packed_b + (size_t)jr * kc;
+                    for (int ir = 0; ir < mc; ir += MINPLUS_MR) {
+                        const double *a_panel = packed_a + (size_t)ir * kc;
+                        micro_kernel(kc, a_panel, b_panel, best);
+                        store_block(a, c, ic + ir, jc + jr, pc,
+                                    min_int(MINPLUS_MR, mc - ir), min_int(MINPLUS_NR, nc - jr),
+                                    kc, a_panel, b_panel, best);
+                    }
+                }
+            }
+        }
+    }
+
+    minplus_workspace_release(&temporary);
+    return SUCCESS;
+}
@@ -0,0 +1,63 @@
+#ifndef MINPLUS_GEMM_H
+#define MINPLUS_GEMM_H
+
+#include <stddef.h>
+#include "constants.h"
+
+/*
+ * Register block of the micro-kernel (MR rows x NR columns of C), sized so
+ * the accumulators stay in registers: 4 x 8 fills eight 256-bit registers
+ * with AVX, 4 x 4 fills eight of the sixteen SSE2 registers otherwise.
+ */
+#define MINPLUS_MR 4
+#ifdef __AVX__
+#define MINPLUS_NR 8
+#else
+#define MINPLUS_NR 4
+#endif
+
+/* Cache blocking: KC x NR panel of B in L1, MC x KC block of A in L2, KC x NC panel of B in L3 */
+#define MINPLUS_KC 256
+#define MINPLUS_MC 64
+#define MINPLUS_NC 2048
+
+/*
+ * Submatrix view over row-pointer storage (the layout Graph uses): element
+ * (i, j) is rows[row0 + i][col0 + j]. next_rows is the matching next-hop
+ * matrix and may be NULL when hops are not tracked.
+ */
+typedef struct {
+    double **rows;
+    int **next_rows;
+    int row0;
+    int col0;
+} MinPlusView;
+
+/*
+ * C = min(C, A (x) B) for an m x k matrix A and a k x n matrix B, where
+ * (A (x) B)[i][j] = min over p of A[i][p] + B[p][j]. Entries at or above
+ * INFINITY_VALUE are treated as missing. When c->next_rows and
+ * a->next_rows are set, every improved C[i][j] takes A's hop next[i][p]
+ * of the winning p. C must not overlap A or B.
+ */
+ReturnCode minplus_gemm(int m, int n, int k, const MinPlusView *a, const MinPlusView *b, MinPlusView *c);
+
+/* Packing buffers kept between calls; they only grow */
+typedef struct {
+    double *packed_a;
+    double *packed_b;
+    size_t a_cells;
+    size_t b_cells;
+} MinPlusWorkspace;
+
+void minplus_workspace_init(MinPlusWorkspace *workspace);
+void minplus_workspace_release(MinPlusWorkspace *workspace);
+
+/* Size the buffers for an m x k by k x n product so later calls of that size do not allocate */
+ReturnCode minplus_workspace_reserve(MinPlusWorkspace *workspace, int m, int n, int k);
+
+/* minplus_gemm packing into workspace (NULL: temporary buffers for this call) */
+ReturnCode minplus_gemm_workspace(int m, int n, int k, const MinPlusView *a, const MinPlusView *b,
+                                  MinPlusView *c, MinPlusWorkspace *workspace);
+
+#endif /* MINPLUS_GEMM_H */
@@ -0,0 +1,207 @@
+#include "negative_cycle.h"
+#include "bitset.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void negative_cycle_info_init(NegativeCycleInfo *info) {
+    if (!info) {
+        return;
+    }
+
+    memset(info, 0, sizeof(NegativeCycleInfo));
+    info->pivot = -1;
+}
+
+void negative_cycle_info_free(NegativeCycleInfo *info) {
+    if (!info) {
+        return;
+    }
+
+    free(info->cycle);
+    free(info->unbounded);
+    negative_cycle_info_init(info);
+}
+
+/* Append the next-hop walk from 'from' up to (not including) 'to'; false if it does not arrive */
+static bool append_walk(const Graph *graph, int from, int to, int *walk, int *length) {
+    int current = from;
+    while (current != to) {
+        if (current < 0 || *length >= 2 * graph->vertices) {
+            return false;
+        }
+        walk[(*length)++] = current;
+        current = graph->next[current][to];
+    }
+    return true;
+}
+
+/*
+ * The closed walk vertex -> pivot -> vertex is two simple paths whose
+ * intermediates are all below pivot. A vertex u on both paths splits it
+ * into a walk through pivot and one through vertex; the latter has no
+ * intermediate at or above pivot, so it is not negative (it would have been
+ * detected earlier) and the part through pivot is at least as negative.
+ * Cutting to that part until no vertex repeats leaves a simple cycle.
+ */
+ReturnCode negative_cycle_extract(const Graph *graph, int vertex, int pivot, NegativeCycleInfo *info) {
+    if (!graph || !graph->is_initialized || !info) {
+        return ERROR_NULL_POINTER;
+    }
+
+    int n = graph->vertices;
+    if (vertex < 0 || vertex >= n || pivot < 0 || pivot >= n || pivot == vertex) {
+        return ERROR_INVALID_INPUT;
+    }
+
+    int *walk = (int*)malloc(2 * (size_t)n * sizeof(int));
+    int *position = (int*)malloc((size_t)n * sizeof(int));
+    if (!walk || !position) {
+        free(walk);
+        free(position);
+        return ERROR_MEMORY_ALLOCATION;
+    }
+
+    int length = 0;
+    bool closed = append_walk(graph, vertex, pivot, walk, &length) &&
+                  append_walk(graph, pivot, vertex, walk, &length);
+    if (!closed) {
+        free(walk);
+        free(position);
+        return ERROR_INVALID_INPUT;
+    }
+
+    bool repeated = true;
+    while (repeated) {
+        repeated = false;
+        for (int v = 0; v < n; v++) {
+            position[v] = -1;
+        }
+        for (int t = 0; t < length; t++) {
+            int first = position[walk[t]];
+            if (first >= 0) {
+                memmove(walk, walk + first, (size_t)(t - first) * sizeof(int));
+                length = t - first;
+                repeated = true;
+                break;
+            }
+            position[walk[t]] = t;
+        }
+    }
+
+    free(position);
+    info->weight_bound = graph->distance[vertex][pivot] + graph->distance[pivot][vertex];
+    free(info->cycle);
+    info->cycle = (int*)realloc(walk, (size_t)length * sizeof(int));
+    if (!info->cycle) {
+        info->cycle = walk;
+    }
+    info->cycle_length = length;
+    info->pivot = pivot;
+    info->found = true;
+    return SUCCESS;
+}
+
+/*
+ * d(i, j) = -inf exactly when i reaches some vertex v on a negative cycle
+ * and v reaches j. Each such v contributes its reach row (as bits) to every
+ * row that reaches it, so the cost is words, not pairs, per update; vertices
+ * on a cycle already covered by a processed one are skipped.
+ */
+ReturnCode negative_cycle_mark_unbounded(const Graph *graph, NegativeCycleInfo *info) {
+    if (!graph || !graph->is_initialized || !info) {
+        return ERROR_NULL_POINTER;
+    }
+
+    int n = graph->vertices;
+    int words = (n + 63) / 64;
+    uint64_t *unbounded = (uint64_t*)calloc((size_t)n * (size_t)words, sizeof(uint64_t));
+    uint64_t *reach = (uint64_t*)malloc((size_t)words * sizeof(uint64_t));
+    int *representatives = (int*)malloc((size_t)n * sizeof(int));
+    if (!unbounded || !reach || !representatives) {
+        free(unbounded);
+        free(reach);
+        free(representatives);
+        return ERROR_MEMORY_ALLOCATION;
+    }
+
+    int representative_count = 0;
+    for (int v = 0; v < n; v++) {
+        if (graph->distance[v][v] >= -EPSILON) {
+            continue;
+        }
+
+        bool covered = false;
+        for (int r = 0; r < representative_count && !covered; r++) {
+            int u = representatives[r];
+            covered = graph->distance[u][v] < INFINITY_VALUE && graph->distance[v][u] < INFINITY_VALUE;
+        }
+        if (covered) {
+            continue;
+        }
+        representatives[representative_count++] = v;
+
+        memset(reach, 0, (size_t)words * sizeof(uint64_t));
+        for (int j = 0; j < n; j++) {
+            if (graph->distance[v][j] < INFINITY_VALUE) {
+                reach[j / 64] |= (uint64_t)1 << (j % 64);
+            }
+        }
+
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < n; i++) {
+            if (graph->distance[i][v] < INFINITY_VALUE) {
+                uint64_t *row = unbounded + (size_t)i * words;
+                for (int w = 0; w < words; w++) {
+                    row[w] |= reach[w];
+                }
+            }
+        }
+    }
+
+    long long pairs = 0;
+    for (size_t w = 0; w < (size_t)n * (size_t)words; w++) {
+        pairs += bitset_popcount(unbounded[w]);
+    }
+
+    free(reach);
+    free(representatives);
+    free(info->unbounded);
+    info->unbounded = unbounded;
+    info->vertices = n;
+    info->words_per_row = words;
+    info->unbounded_pairs = pairs;
+    if (representative_count > 0) {
+        info->found = true;
+    }
+    return SUCCESS;
+}
+
+bool negative_cycle_is_unbounded(const NegativeCycleInfo *info, int from, int to) {
+    if (!info || !info->unbounded ||
+        from < 0 || from >= info->vertices || to < 0 || to >= info->vertices) {
+        return false;
+    }
+
+    uint64_t word = info->unbounded[(size_t)from * info->words_per_row + to / 64];
+    return (word >> (to % 64)) & 1;
+}
+
+void negative_cycle_print(const NegativeCycleInfo *info) {
+    if (!info || !info->found) {
+        printf("No negative cycle\n");
+        return;
+    }
+
+    if (info->cycle_length > 0) {
+        printf("Negative cycle (weight <= %.2f): ", info->weight_bound);
+        for (int t = 0; t < info->cycle_length; t++) {
+            printf("%d -> ", info->cycle[t]);
+        }
+        printf("%d\n", info->cycle[0]);
+    }
+
+    if (info->unbounded) {
+        printf("Pairs with unbounded (-inf) distance: %lld\n", info->unbounded_pairs);
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef NEGATIVE_CYCLE_H
+#define NEGATIVE_CYCLE_H
+
+#include "../data_structures/graph.h"
+#include <stdint.h>
+
+/* How the checked kernel reacts to the first negative cycle */
+typedef enum {
+    FW_NEGATIVE_CYCLE_COMPLETE = 0,  /* Run every pivot, then extract the cycle and mark -inf pairs */
+    FW_NEGATIVE_CYCLE_ABORT          /* Stop at the first negative cycle (yes/no answer) */
+} NegativeCycleMode;
+
+/* Negative cycle report filled by floyd_warshall_execute_checked */
+typedef struct {
+    bool found;                 /* A negative cycle exists */
+    int pivot;                  /* Pivot at which it was detected (-1 if not extracted) */
+    int *cycle;                 /* Simple cycle; cycle[t] -> cycle[t + 1] and back to cycle[0] */
+    int cycle_length;
+    double weight_bound;        /* The reported cycle weighs at most this (always < 0) */
+    int vertices;
+    int words_per_row;
+    uint64_t *unbounded;        /* vertices x words_per_row bitset, bit (i, j) set when d(i, j) = -inf */
+    long long unbounded_pairs;
+} NegativeCycleInfo;
+
+/* Lifetime */
+void negative_cycle_info_init(NegativeCycleInfo *info);
+void negative_cycle_info_free(NegativeCycleInfo *info);
+
+/*
+ * Extract the cycle closed by pivot: d[vertex][pivot] + d[pivot][vertex] < 0
+ * while next still describes the state before pivot was applied.
+ */
+ReturnCode negative_cycle_extract(const Graph *graph, int vertex, int pivot, NegativeCycleInfo *info);
+
+/*
+ * Mark every pair (i, j) with a path through a vertex whose final d[v][v]
+ * is negative. Works after any engine that ran all pivots.
+ */
+ReturnCode negative_cycle_mark_unbounded(const Graph *graph, NegativeCycleInfo *info);
+bool negative_cycle_is_unbounded(const NegativeCycleInfo *info, int from, int to);
+
+/* Output */
+void negative_cycle_print(const NegativeCycleInfo *info);
+
+#endif /* NEGATIVE_CYCLE_H */
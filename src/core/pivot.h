@@ -0,0 +1,14 @@
+#ifndef PIVOT_H
+#define PIVOT_H
+
+#include "../data_structures/graph.h"
+
+/*
+ * Internal to the reference kernels (floyd_warshall_execute_checked and the
+ * checkpointed run), so both apply a pivot the same way: relax every pair
+ * (i, j) through pivot k, taking the first hop towards k on improvement.
+ * Returns the relaxations done (n^2).
+ */
+int floyd_warshall_relax_pivot(Graph *graph, int k);
+
+#endif /* PIVOT_H */
@@ -0,0 +1,324 @@
+#include "reduction.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Working copy of the matrix while vertices are removed */
+typedef struct {
+    int vertices;
+    double *weight;             /* Row-major n x n */
+    bool *alive;
+    int *degree;                /* Alive neighbours, either direction */
+} ReductionWork;
+
+static double work_weight(const ReductionWork *work, int from, int to) {
+    return work->weight[(size_t)from * work->vertices + to];
+}
+
+static bool work_adjacent(const ReductionWork *work, int u, int v) {
+    return u != v && (work_weight(work, u, v) < INFINITY_VALUE || work_weight(work, v, u) < INFINITY_VALUE);
+}
+
+/* Shortcut from -> to through the removed vertex, kept only if cheaper than the existing edge */
+static bool add_shortcut(ReductionWork *work, GraphReduction *reduction, int from, int to,
+                         double weight_in, double weight_out) {
+    if (weight_in >= INFINITY_VALUE || weight_out >= INFINITY_VALUE) {
+        return false;
+    }
+
+    double *existing = &work->weight[(size_t)from * work->vertices + to];
+    double weight = weight_in + weight_out;
+    if (weight >= INFINITY_VALUE) {
+        return false;
+    }
+    if (weight < *existing) {
+        reduction->dominated_edges += *existing < INFINITY_VALUE;
+        *existing = weight;
+        return true;
+    }
+    reduction->dominated_edges++;
+    return false;
+}
+
+/* Try to remove v; false if it has more than two neighbours or sits on a negative two-edge cycle */
+static bool remove_vertex(ReductionWork *work, GraphReduction *reduction, int v) {
+    int n = work->vertices;
+    ReductionStep step;
+    step.vertex = v;
+    step.degree = 0;
+    step.shortcut[0] = step.shortcut[1] = false;
+
+    for (int u = 0; u < n; u++) {
+        if (!work->alive[u] || !work_adjacent(work, u, v)) {
+            continue;
+        }
+        if (step.degree == 2) {
+            return false;
+        }
+        step.neighbours[step.degree] = u;
+        step.weight_in[step.degree] = work_weight(work, u, v);
+        step.weight_out[step.degree] = work_weight(work, v, u);
+        if (step.weight_in[step.degree] < INFINITY_VALUE && step.weight_out[step.degree] < INFINITY_VALUE &&
+            step.weight_in[step.degree] + step.weight_out[step.degree] < 0.0) {
+            return false;
+        }
+        step.degree++;
+    }
+
+    if (step.degree == 2) {
+        int a = step.neighbours[0];
+        int b = step.neighbours[1];
+        bool adjacent_before = work_adjacent(work, a, b);
+        step.shortcut[0] = add_shortcut(work, reduction, a, b, step.weight_in[0], step.weight_out[1]);
+        step.shortcut[1] = add_shortcut(work, reduction, b, a, step.weight_in[1], step.weight_out[0]);
+        int gained = !adjacent_before && work_adjacent(work, a, b);
+        work->degree[a] += gained - 1;
+        work->degree[b] += gained - 1;
+        reduction->chains++;
+    } else if (step.degree == 1) {
+        work->degree[step.neighbours[0]]--;
+        reduction->leaves++;
+    } else {
+        reduction->isolated++;
+    }
+
+    work->alive[v] = false;
+    reduction->steps[reduction->step_count++] = step;
+    return true;
+}
+
+static Graph* build_core(const ReductionWork *work, GraphReduction *reduction) {
+    int n = work->vertices;
+    int size = 0;
+    for (int v = 0; v < n; v++) {
+        if (work->alive[v]) {
+            reduction->core_vertex[size++] = v;
+        }
+    }
+
+    Graph *core = graph_create(size);
+    if (!core) {
+        return NULL;
+    }
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < size; j++) {
+            double weight = work_weight(work, reduction->core_vertex[i], reduction->core_vertex[j]);
+            if (i != j && weight < INFINITY_VALUE) {
+                graph_add_edge(core, i, j, weight);
+            }
+        }
+    }
+    return core;
+}
+
+GraphReduction* reduction_create(const Graph *graph) {
+    if (!graph || !graph->is_initialized) {
+        return NULL;
+    }
+
+    int n = graph->vertices;
+    GraphReduction *reduction = (GraphReduction*)calloc(1, sizeof(GraphReduction));
+    ReductionWork work;
+    work.vertices = n;
+    work.weight = (double*)malloc((size_t)n * (size_t)n * sizeof(double));
+    work.alive = (bool*)malloc((size_t)n * sizeof(bool));
+    work.degree = (int*)calloc((size_t)n, sizeof(int));
+    int *queue = (int*)malloc((size_t)n * sizeof(int));
+    bool *queued = (bool*)calloc((size_t)n, sizeof(bool));
+    if (reduction) {
+        reduction->vertices = n;
+        reduction->core_vertex = (int*)malloc((size_t)n * sizeof(int));
+        reduction->steps = (ReductionStep*)malloc((size_t)n * sizeof(ReductionStep));
+    }
+    if (!reduction || !reduction->core_vertex || !reduction->steps ||
+        !work.weight || !work.alive || !work.degree || !queue || !queued) {
+        reduction_destroy(reduction);
+        free(work.weight);
+        free(work.alive);
+        free(work.degree);
+        free(queue);
+        free(queued);
+        return NULL;
+    }
+
+    for (int i = 0; i < n; i++) {
+        memcpy(work.weight + (size_t)i * n, graph->distance[i], (size_t)n * sizeof(double));
+        work.alive[i] = true;
+    }
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            if (work_adjacent(&work, i, j)) {
+                work.degree[i]++;
+                work.degree[j]++;
+            }
+        }
+    }
+
+    /* Removing a vertex can bring its neighbours down to two, so they are queued again */
+    int head = 0;
+    int size = 0;
+    for (int v = 0; v < n; v++) {
+        if (work.degree[v] <= 2) {
+            queue[(head + size++) % n] = v;
+            queued[v] = true;
+        }
+    }
+    int remaining = n;
+    while (size > 0 && remaining > 1) {
+        int v = queue[head];
+        head = (head + 1) % n;
+        size--;
+        queued[v] = false;
+
+        if (!work.alive[v] || work.degree[v] > 2 || !remove_vertex(&work, reduction, v)) {
+            continue;
+        }
+        remaining--;
+
+        const ReductionStep *step = &reduction->steps[reduction->step_count - 1];
+        for (int t = 0; t < step->degree; t++) {
+            int u = step->neighbours[t];
+            if (work.degree[u] <= 2 && !queued[u]) {
+                queue[(head + size++) % n] = u;
+                queued[u] = true;
+            }
+        }
+    }
+
+    reduction->core = build_core(&work, reduction);
+    free(work.weight);
+    free(work.alive);
+    free(work.degree);
+    free(queue);
+    free(queued);
+
+    if (!reduction->core) {
+        reduction_destroy(reduction);
+        return NULL;
+    }
+    return reduction;
+}
+
+void reduction_destroy(GraphReduction *reduction) {
+    if (!reduction) {
+        return;
+    }
+
+    graph_destroy(reduction->core);
+    free(reduction->core_vertex);
+    free(reduction->steps);
+    free(reduction);
+}
+
+/* Put back one removed vertex: its column and row over the vertices already present */
+static void expand_step(const ReductionStep *step, Graph *graph, const bool *present) {
+    int n = graph->vertices;
+    int v = step->vertex;
+
+    /* Paths that took a shortcut now start with the hop into v */
+    for (int t = 0; t < step->degree; t++) {
+        if (!step->shortcut[t]) {
+            continue;
+        }
+        int from = step->neighbours[t];
+        int to = step->neighbours[1 - t];
+        int *next_from = graph->next[from];
+        for (int y = 0; y < n; y++) {
+            if (present[y] && next_from[y] == to) {
+                next_from[y] = v;
+            }
+        }
+    }
+
+    for (int x = 0; x < n; x++) {
+        if (!present[x]) {
+            continue;
+        }
+        double best = INFINITY_VALUE;
+        int hop = -1;
+        for (int t = 0; t < step->degree; t++) {
+            int u = step->neighbours[t];
+            double to_u = x == u ? 0.0 : graph->distance[x][u];
+            if (step->weight_in[t] >= INFINITY_VALUE || to_u >= INFINITY_VALUE) {
+                continue;
+            }
+            /* A tie goes to the direct edge, never to a route that may already pass v */
+            double cost = to_u + step->weight_in[t];
+            if (cost < best || (cost == best && x == u)) {
+                best = cost;
+                hop = x == u ? v : graph->next[x][u];
+            }
+        }
+        if (best < INFINITY_VALUE) {
+            graph->distance[x][v] = best;
+            graph->next[x][v] = hop;
+        }
+    }
+
+    for (int y = 0; y < n; y++) {
+        if (!present[y]) {
+            continue;
+        }
+        double best = INFINITY_VALUE;
+        int hop = -1;
+        for (int t = 0; t < step->degree; t++) {
+            int u = step->neighbours[t];
+            double from_u = y == u ? 0.0 : graph->distance[u][y];
+            /*
+             * A neighbour whose route to y starts back into v would close a
+             * hop cycle; on a zero-weight two-cycle it ties with the other
+             * neighbour (never beats it), so it is simply not a candidate.
+             */
+            if (step->weight_out[t] >= INFINITY_VALUE || from_u >= INFINITY_VALUE ||
+                (y != u && graph->next[u][y] == v)) {
+                continue;
+            }
+            double cost = step->weight_out[t] + from_u;
+            if (cost < best || (cost == best && y == u)) {
+                best = cost;
+                hop = u;
+            }
+        }
+        if (best < INFINITY_VALUE) {
+            graph->distance[v][y] = best;
+            graph->next[v][y] = hop;
+        }
+    }
+}
+
+ReturnCode reduction_expand(const GraphReduction *reduction, Graph *graph) {
+    if (!reduction || !graph || !graph->is_initialized) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if (graph->vertices != reduction->vertices) {
+        return ERROR_INVALID_INPUT;
+    }
+
+    int n = graph->vertices;
+    bool *present = (bool*)calloc((size_t)n, sizeof(bool));
+    if (!present) {
+        return ERROR_MEMORY_ALLOCATION;
+    }
+
+    /* Unreachable core pairs keep the full graph's entries */
+    const Graph *core = reduction->core;
+    for (int i = 0; i < core->vertices; i++) {
+        int u = reduction->core_vertex[i];
+        present[u] = true;
+        for (int j = 0; j < core->vertices; j++) {
+            int v = reduction->core_vertex[j];
+            if (core->distance[i][j] < INFINITY_VALUE) {
+                graph->distance[u][v] = core->distance[i][j];
+                graph->next[u][v] = core->next[i][j] >= 0 ? reduction->core_vertex[core->next[i][j]] : -1;
+            }
+        }
+    }
+
+    for (int s = reduction->step_count - 1; s >= 0; s--) {
+        expand_step(&reduction->steps[s], graph, present);
+        present[reduction->steps[s].vertex] = true;
+    }
+
+    free(present);
+    return SUCCESS;
+}
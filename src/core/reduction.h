@@ -0,0 +1,52 @@
+#ifndef REDUCTION_H
+#define REDUCTION_H
+
+#include "../data_structures/graph.h"
+
+/*
+ * Removal of one vertex with at most two neighbours (in or out). Its edges
+ * to and from the neighbours are kept so the vertex can be put back; for a
+ * chain vertex, shortcut[0] tells that neighbours[0] -> neighbours[1] through
+ * the vertex beat the direct edge (shortcut[1] the other direction).
+ */
+typedef struct {
+    int vertex;
+    int degree;                 /* 0 (isolated), 1 (leaf) or 2 (chain) */
+    int neighbours[2];
+    double weight_in[2];        /* w(neighbours[t] -> vertex), INFINITY_VALUE if none */
+    double weight_out[2];       /* w(vertex -> neighbours[t]) */
+    bool shortcut[2];
+} ReductionStep;
+
+/*
+ * Graph reduced by repeatedly removing isolated, leaf and chain vertices.
+ * A chain vertex is replaced by weighted shortcuts between its two
+ * neighbours; where a shortcut meets an existing edge only the cheaper one
+ * is kept. Distances between the remaining (core) vertices are unchanged,
+ * so the core can be solved by any engine and expanded back. Vertices on a
+ * negative two-edge cycle are never removed.
+ */
+typedef struct {
+    int vertices;               /* Of the full graph */
+    Graph *core;                /* Solved in place by the caller */
+    int *core_vertex;           /* Core index -> full graph vertex */
+    ReductionStep *steps;       /* In removal order; undone in reverse */
+    int step_count;
+    int leaves;                 /* Removed vertices by kind */
+    int chains;
+    int isolated;
+    int dominated_edges;        /* Edges dropped in favour of a cheaper parallel one */
+} GraphReduction;
+
+/* Reduce graph (left unchanged); NULL on allocation failure */
+GraphReduction* reduction_create(const Graph *graph);
+void reduction_destroy(GraphReduction *reduction);
+
+/*
+ * Fill the distance and next matrices of the full graph from the solved
+ * core: core pairs are copied, then the removed vertices are put back in
+ * reverse order, each from its neighbours' final rows and columns.
+ */
+ReturnCode reduction_expand(const GraphReduction *reduction, Graph *graph);
+
+#endif /* REDUCTION_H */
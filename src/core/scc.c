@@ -0,0 +1,174 @@
+#include "scc.h"
+#include <stdlib.h>
+
+/* Work arrays of one Tarjan run; the call stack replaces recursion */
+typedef struct {
+    int *offsets;           /* Adjacency of the matrix edges (CSR) */
+    int *targets;
+    int *index;             /* Discovery order, -1 before discovery */
+    int *low;
+    unsigned char *on_stack;
+    int *stack;             /* Vertices of the components still open */
+    int *call_vertex;
+    int *call_edge;         /* Next edge to look at, per call frame */
+} TarjanState;
+
+static void tarjan_free(TarjanState *state) {
+    free(state->offsets);
+    free(state->targets);
+    free(state->index);
+    free(state->low);
+    free(state->on_stack);
+    free(state->stack);
+    free(state->call_vertex);
+    free(state->call_edge);
+}
+
+static bool tarjan_init(TarjanState *state, const Graph *graph) {
+    int n = graph->vertices;
+    size_t edges = 0;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            edges += i != j && graph->distance[i][j] < INFINITY_VALUE;
+        }
+    }
+
+    state->offsets = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    state->targets = (int*)malloc((edges > 0 ? edges : 1) * sizeof(int));
+    state->index = (int*)malloc((size_t)n * sizeof(int));
+    state->low = (int*)malloc((size_t)n * sizeof(int));
+    state->on_stack = (unsigned char*)calloc((size_t)n, 1);
+    state->stack = (int*)malloc((size_t)n * sizeof(int));
+    state->call_vertex = (int*)malloc((size_t)n * sizeof(int));
+    state->call_edge = (int*)malloc((size_t)n * sizeof(int));
+    if (!state->offsets || !state->targets || !state->index || !state->low || !state->on_stack ||
+        !state->stack || !state->call_vertex || !state->call_edge) {
+        tarjan_free(state);
+        return false;
+    }
+
+    int edge = 0;
+    for (int i = 0; i < n; i++) {
+        state->offsets[i] = edge;
+        state->index[i] = -1;
+        for (int j = 0; j < n; j++) {
+            if (i != j && graph->distance[i][j] < INFINITY_VALUE) {
+                state->targets[edge++] = j;
+            }
+        }
+    }
+    state->offsets[n] = edge;
+    return true;
+}
+
+SccDecomposition* scc_decompose(const Graph *graph) {
+    if (!graph || !graph->is_initialized) {
+        return NULL;
+    }
+
+    int n = graph->vertices;
+    SccDecomposition *scc = (SccDecomposition*)calloc(1, sizeof(SccDecomposition));
+    TarjanState state;
+    if (!scc) {
+        return NULL;
+    }
+    scc->vertices = n;
+    scc->component = (int*)malloc((size_t)n * sizeof(int));
+    scc->offsets = (int*)calloc((size_t)n + 1, sizeof(int));
+    scc->members = (int*)malloc((size_t)n * sizeof(int));
+    if (!scc->component || !scc->offsets || !scc->members || !tarjan_init(&state, graph)) {
+        scc_destroy(scc);
+        return NULL;
+    }
+
+    /* Components close sinks first; they are renumbered below */
+    int counter = 0;
+    int top = 0;
+    int depth = 0;
+    int closed = 0;
+    for (int root = 0; root < n; root++) {
+        if (state.index[root] >= 0) {
+            continue;
+        }
+        state.index[root] = state.low[root] = counter++;
+        state.stack[top++] = root;
+        state.on_stack[root] = 1;
+        state.call_vertex[depth] = root;
+        state.call_edge[depth++] = state.offsets[root];
+
+        while (depth > 0) {
+            int v = state.call_vertex[depth - 1];
+            int e = state.call_edge[depth - 1];
+            if (e < state.offsets[v + 1]) {
+                state.call_edge[depth - 1]++;
+                int w = state.targets[e];
+                if (state.index[w] < 0) {
+                    state.index[w] = state.low[w] = counter++;
+                    state.stack[top++] = w;
+                    state.on_stack[w] = 1;
+                    state.call_vertex[depth] = w;
+                    state.call_edge[depth++] = state.offsets[w];
+                } else if (state.on_stack[w] && state.index[w] < state.low[v]) {
+                    state.low[v] = state.index[w];
+                }
+                continue;
+            }
+
+            if (state.low[v] == state.index[v]) {
+                int w;
+                do {
+                    w = state.stack[--top];
+                    state.on_stack[w] = 0;
+                    scc->component[w] = closed;
+                } while (w != v);
+                closed++;
+            }
+            depth--;
+            if (depth > 0) {
+                int parent = state.call_vertex[depth - 1];
+                if (state.low[v] < state.low[parent]) {
+                    state.low[parent] = state.low[v];
+                }
+            }
+        }
+    }
+    tarjan_free(&state);
+
+    /* Reverse the closing order into topological order, then group members */
+    scc->count = closed;
+    for (int v = 0; v < n; v++) {
+        scc->component[v] = closed - 1 - scc->component[v];
+        scc->offsets[scc->component[v] + 1]++;
+    }
+    for (int c = 0; c < closed; c++) {
+        scc->offsets[c + 1] += scc->offsets[c];
+        if (scc_size(scc, c) > scc->largest) {
+            scc->largest = scc_size(scc, c);
+        }
+    }
+    int *position = (int*)malloc((size_t)closed * sizeof(int));
+    if (!position) {
+        scc_destroy(scc);
+        return NULL;
+    }
+    for (int c = 0; c < closed; c++) {
+        position[c] = scc->offsets[c];
+    }
+    for (int v = 0; v < n; v++) {
+        scc->members[position[scc->component[v]]++] = v;
+    }
+    free(position);
+
+    return scc;
+}
+
+void scc_destroy(SccDecomposition *scc) {
+    if (!scc) {
+        return;
+    }
+
+    free(scc->component);
+    free(scc->offsets);
+    free(scc->members);
+    free(scc);
+}
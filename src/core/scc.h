@@ -0,0 +1,29 @@
+#ifndef SCC_H
+#define SCC_H
+
+#include "../data_structures/graph.h"
+
+/*
+ * Strongly connected components of the edges of a graph (finite off-diagonal
+ * entries). Components are numbered in topological order of the
+ * condensation: every edge between two components goes from the lower
+ * number to the higher one.
+ */
+typedef struct {
+    int vertices;
+    int count;              /* Number of components */
+    int largest;            /* Vertices in the largest component */
+    int *component;         /* Component of each vertex */
+    int *offsets;           /* Vertices of component c: members[offsets[c] .. offsets[c + 1]) */
+    int *members;           /* Ascending within each component */
+} SccDecomposition;
+
+/* Iterative Tarjan, O(n^2) for the matrix scan; NULL on allocation failure */
+SccDecomposition* scc_decompose(const Graph *graph);
+void scc_destroy(SccDecomposition *scc);
+
+static inline int scc_size(const SccDecomposition *scc, int c) {
+    return scc->offsets[c + 1] - scc->offsets[c];
+}
+
+#endif /* SCC_H */
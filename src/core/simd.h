@@ -0,0 +1,44 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <stdint.h>
+
+/*
+ * Native-width vectors for kernels that relax distances and select next hops
+ * with the same comparison mask. GCC does not if-convert that two-way select
+ * for plain SSE2 under omp simd, so such kernels use GNU vector extensions
+ * (GCC and Clang); FW_HAVE_VECTOR_EXTENSIONS is 0 elsewhere and callers keep
+ * a scalar loop.
+ */
+#if defined(__GNUC__)
+#define FW_HAVE_VECTOR_EXTENSIONS 1
+
+#if defined(__AVX512F__)
+#define SIMD_LANES 8
+#elif defined(__AVX2__)
+#define SIMD_LANES 4
+#else
+#define SIMD_LANES 2
+#endif
+
+typedef double SimdDoubles __attribute__((vector_size(SIMD_LANES * sizeof(double)), may_alias));
+typedef int64_t SimdMask __attribute__((vector_size(SIMD_LANES * sizeof(int64_t)), may_alias));
+
+/* Same width in float32 lanes, with 32-bit masks (next hops stored as int32_t) */
+#define SIMD_FLOAT_LANES (2 * SIMD_LANES)
+typedef float SimdFloats __attribute__((vector_size(SIMD_FLOAT_LANES * sizeof(float)), may_alias));
+typedef int32_t SimdMask32 __attribute__((vector_size(SIMD_FLOAT_LANES * sizeof(int32_t)), may_alias));
+
+/* Lanes of mask set: value_if_set, others: value_otherwise */
+#define SIMD_SELECT_DOUBLES(mask, value_if_set, value_otherwise) \
+    ((SimdDoubles)(((SimdMask)(value_if_set) & (mask)) | ((SimdMask)(value_otherwise) & ~(mask))))
+#define SIMD_SELECT_MASK(mask, value_if_set, value_otherwise) \
+    (((value_if_set) & (mask)) | ((value_otherwise) & ~(mask)))
+#define SIMD_SELECT_FLOATS(mask, value_if_set, value_otherwise) \
+    ((SimdFloats)(((SimdMask32)(value_if_set) & (mask)) | ((SimdMask32)(value_otherwise) & ~(mask))))
+
+#else
+#define FW_HAVE_VECTOR_EXTENSIONS 0
+#endif
+
+#endif /* SIMD_H */
@@ -0,0 +1,200 @@
+#include "solver.h"
+#include "../utils/memory_manager.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Rows of both matrices start on a cache line */
+#define SOLVER_ALIGNMENT 64
+
+static bool supported_engine(FloydWarshallEngine engine) {
+    return engine == FW_ENGINE_STANDARD || engine == FW_ENGINE_OPTIMIZED ||
+           engine == FW_ENGINE_BLOCKED || engine == FW_ENGINE_SMALL;
+}
+
+static size_t block_bytes(const Solver *solver, size_t element) {
+    return (size_t)solver->graph.vertices * (size_t)solver->row_stride * element;
+}
+
+/*
+ * One set of packing buffers per thread, each sized for a full tile product
+ * and reserved by the thread that will use it. Running the region here also
+ * starts the OpenMP thread team, which the runtime then keeps for later runs.
+ */
+static bool create_workspaces(Solver *solver) {
+#ifdef _OPENMP
+    int count = omp_get_max_threads();
+#else
+    int count = 1;
+#endif
+    solver->workspaces = (MinPlusWorkspace*)malloc((size_t)count * sizeof(MinPlusWorkspace));
+    if (!solver->workspaces) {
+        return false;
+    }
+    solver->workspace_count = count;
+    for (int t = 0; t < count; t++) {
+        minplus_workspace_init(&solver->workspaces[t]);
+    }
+
+    int failures = 0;
+    #pragma omp parallel reduction(+:failures)
+    {
+#ifdef _OPENMP
+        int thread = omp_get_thread_num();
+#else
+        int thread = 0;
+#endif
+        if (thread < count &&
+            minplus_workspace_reserve(&solver->workspaces[thread], FW_TILE_SIZE, FW_TILE_SIZE,
+                                      FW_TILE_SIZE) != SUCCESS) {
+            failures++;
+        }
+    }
+    return failures == 0;
+}
+
+Solver* solver_create(int vertices, FloydWarshallEngine engine) {
+    if (vertices <= 0 || vertices > MAX_VERTICES) {
+        return NULL;
+    }
+
+    if (engine == FW_ENGINE_COUNT) {
+        engine = vertices <= FW_SMALL_MAX_VERTICES ? FW_ENGINE_SMALL : FW_ENGINE_BLOCKED;
+    }
+    if (!supported_engine(engine)) {
+        return NULL;
+    }
+
+    Solver *solver = (Solver*)calloc(1, sizeof(Solver));
+    if (!solver) {
+        return NULL;
+    }
+
+    int per_line = SOLVER_ALIGNMENT / (int)sizeof(int);
+    solver->engine = engine;
+    solver->graph.vertices = vertices;
+    solver->graph.storage = GRAPH_STORAGE_EXTERNAL;
+    solver->row_stride = (vertices + per_line - 1) / per_line * per_line;
+    solver->distance_block = (double*)allocate_aligned(block_bytes(solver, sizeof(double)), SOLVER_ALIGNMENT);
+    solver->next_block = (int*)allocate_aligned(block_bytes(solver, sizeof(int)), SOLVER_ALIGNMENT);
+    solver->graph.distance = (double**)malloc((size_t)vertices * sizeof(double*));
+    solver->graph.next = (int**)malloc((size_t)vertices * sizeof(int*));
+    if (!solver->distance_block || !solver->next_block || !solver->graph.distance || !solver->graph.next) {
+        solver_destroy(solver);
+        return NULL;
+    }
+
+    for (int i = 0; i < vertices; i++) {
+        solver->graph.distance[i] = solver->distance_block + (size_t)i * solver->row_stride;
+        solver->graph.next[i] = solver->next_block + (size_t)i * solver->row_stride;
+    }
+
+    /* Touch every page now rather than during the first run */
+    memset(solver->distance_block, 0, block_bytes(solver, sizeof(double)));
+    memset(solver->next_block, 0, block_bytes(solver, sizeof(int)));
+    graph_initialize(&solver->graph);
+
+    if (engine == FW_ENGINE_BLOCKED) {
+        solver->summary = tile_summary_create(&solver->graph, FW_TILE_SIZE);
+        if (!solver->summary || !create_workspaces(solver)) {
+            solver_destroy(solver);
+            return NULL;
+        }
+    }
+
+    return solver;
+}
+
+void solver_destroy(Solver *solver) {
+    if (!solver) {
+        return;
+    }
+
+    for (int t = 0; t < solver->workspace_count; t++) {
+        minplus_workspace_release(&solver->workspaces[t]);
+    }
+    free(solver->workspaces);
+    tile_summary_destroy(solver->summary);
+    free(solver->graph.distance);
+    free(solver->graph.next);
+    deallocate_aligned(solver->distance_block, block_bytes(solver, sizeof(double)));
+    deallocate_aligned(solver->next_block, block_bytes(solver, sizeof(int)));
+    free(solver);
+}
+
+Graph* solver_reset(Solver *solver) {
+    if (!solver) {
+        return NULL;
+    }
+
+    graph_initialize(&solver->graph);
+    return &solver->graph;
+}
+
+ReturnCode solver_load_graph(Solver *solver, const Graph *source) {
+    if (!solver || !source || !source->is_initialized) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if (source->vertices != solver->graph.vertices) {
+        return ERROR_INVALID_INPUT;
+    }
+
+    int n = solver->graph.vertices;
+    for (int i = 0; i < n; i++) {
+        memcpy(solver->graph.distance[i], source->distance[i], (size_t)n * sizeof(double));
+        memcpy(solver->graph.next[i], source->next[i], (size_t)n * sizeof(int));
+    }
+    solver->graph.is_initialized = true;
+
+    return SUCCESS;
+}
+
+ReturnCode solver_load_matrix(Solver *solver, const double *weights) {
+    if (!solver || !weights) {
+        return ERROR_NULL_POINTER;
+    }
+
+    int n = solver->graph.vertices;
+    for (int i = 0; i < n; i++) {
+        const double *row = weights + (size_t)i * n;
+        double *distance_i = solver->graph.distance[i];
+        int *next_i = solver->graph.next[i];
+        for (int j = 0; j < n; j++) {
+            bool edge = i != j && row[j] < INFINITY_VALUE;
+            distance_i[j] = edge ? row[j] : (i == j ? 0.0 : INFINITY_VALUE);
+            next_i[j] = edge ? j : -1;
+        }
+    }
+    solver->graph.is_initialized = true;
+
+    return SUCCESS;
+}
+
+FloydWarshallResult solver_run(Solver *solver) {
+    FloydWarshallResult result = {false, 0.0, 0, false, -1, 0, 0};
+
+    if (!solver) {
+        return result;
+    }
+
+    if (solver->engine == FW_ENGINE_BLOCKED) {
+        tile_summary_rebuild(solver->summary, &solver->graph);
+        result = floyd_warshall_execute_blocked_reusing(&solver->graph, solver->summary,
+                                                        solver->workspaces, solver->workspace_count);
+    } else {
+        result = floyd_warshall_execute_engine(&solver->graph, solver->engine);
+    }
+
+    if (result.success) {
+        solver->runs++;
+    }
+    return result;
+}
+
+Graph* solver_graph(Solver *solver) {
+    return solver ? &solver->graph : NULL;
+}
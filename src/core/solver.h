@@ -0,0 +1,60 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include "floyd_warshall.h"
+
+/*
+ * Persistent solver for repeated runs on graphs of one size. Everything a
+ * run needs is allocated and first touched by solver_create: the distance
+ * and next matrices (one aligned block each, rows padded to a cache line),
+ * the tile summary and one set of packing buffers per OpenMP thread. Each
+ * run then reloads the matrices in place and solves them in place, so after
+ * creation a run performs no allocation (negative cycle reporting aside).
+ *
+ * Typical loop:
+ *     Solver *solver = solver_create(n, FW_ENGINE_COUNT);
+ *     for (...) {
+ *         solver_load_matrix(solver, weights);
+ *         solver_run(solver);
+ *         ... read solver_graph(solver) ...
+ *     }
+ *     solver_destroy(solver);
+ */
+typedef struct {
+    Graph graph;                    /* Row pointers into the blocks below; inputs and results */
+    FloydWarshallEngine engine;     /* Kernel selected at creation */
+    int row_stride;                 /* Elements per padded row */
+    double *distance_block;
+    int *next_block;
+    TileSummary *summary;           /* Blocked kernel only */
+    MinPlusWorkspace *workspaces;   /* Packing buffers, one per OpenMP thread (blocked kernel only) */
+    int workspace_count;
+    int runs;                       /* Successful runs so far */
+} Solver;
+
+/*
+ * Create a solver for graphs with the given vertex count. engine selects the
+ * kernel: FW_ENGINE_STANDARD, FW_ENGINE_OPTIMIZED, FW_ENGINE_BLOCKED or
+ * FW_ENGINE_SMALL, or FW_ENGINE_COUNT to pick the small kernel up to
+ * FW_SMALL_MAX_VERTICES and the blocked kernel above. Engines that build
+ * scratch state per run are not supported (NULL).
+ */
+Solver* solver_create(int vertices, FloydWarshallEngine engine);
+void solver_destroy(Solver *solver);
+
+/* Clear to a graph without edges and return it for graph_add_edge */
+Graph* solver_reset(Solver *solver);
+
+/* Load a graph of the solver's size (copied row by row) */
+ReturnCode solver_load_graph(Solver *solver, const Graph *source);
+
+/* Load a row-major n x n weight matrix (>= INFINITY_VALUE: no edge; the diagonal is ignored) */
+ReturnCode solver_load_matrix(Solver *solver, const double *weights);
+
+/* Solve the loaded graph in place; results are read from solver_graph */
+FloydWarshallResult solver_run(Solver *solver);
+
+/* The solver's graph; owned by the solver (graph_destroy ignores it) */
+Graph* solver_graph(Solver *solver);
+
+#endif /* SOLVER_H */
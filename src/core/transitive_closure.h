@@ -0,0 +1,40 @@
+#ifndef TRANSITIVE_CLOSURE_H
+#define TRANSITIVE_CLOSURE_H
+
+#include "../data_structures/graph.h"
+#include <stdint.h>
+
+/* Bits per reachability word */
+#define REACHABILITY_WORD_BITS 64
+
+/* Reachability matrix: row i is a bitset, bit j set when j is reachable from i */
+typedef struct {
+    int vertices;           /* Number of vertices */
+    int words_per_row;      /* Row length in 64-bit words (padded for alignment) */
+    uint64_t *bits;         /* vertices x words_per_row, 64-byte aligned */
+} ReachabilityMatrix;
+
+/* Result structure for transitive closure execution */
+typedef struct {
+    bool success;               /* Flag indicating successful execution */
+    double execution_time;      /* Wall time in seconds */
+    long long reachable_pairs;  /* Number of (i, j) pairs with j reachable from i */
+} TransitiveClosureResult;
+
+/* Creation and destruction functions */
+ReachabilityMatrix* reachability_create(int vertices);
+ReachabilityMatrix* reachability_from_graph(const Graph *graph);
+void reachability_destroy(ReachabilityMatrix *matrix);
+
+/* Edge and query functions */
+ReturnCode reachability_add_edge(ReachabilityMatrix *matrix, int from, int to);
+bool reachability_is_reachable(const ReachabilityMatrix *matrix, int from, int to);
+
+/* Warshall's algorithm over bitset rows */
+TransitiveClosureResult transitive_closure_execute(ReachabilityMatrix *matrix);
+
+/* Output functions */
+void reachability_print(const ReachabilityMatrix *matrix);
+ReturnCode save_reachability_to_file(const ReachabilityMatrix *matrix, const char *filename);
+
+#endif /* TRANSITIVE_CLOSURE_H */
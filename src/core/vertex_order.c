@@ -0,0 +1,327 @@
+#include "vertex_order.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Label propagation stops after this many rounds even if labels still move */
+#define COMMUNITY_MAX_ROUNDS 10
+
+/* Neighbours in either direction (CSR) */
+typedef struct {
+    int *offsets;
+    int *targets;
+} Adjacency;
+
+static void adjacency_free(Adjacency *adjacency) {
+    free(adjacency->offsets);
+    free(adjacency->targets);
+}
+
+static bool adjacent(const Graph *graph, int u, int v) {
+    return u != v && (graph->distance[u][v] < INFINITY_VALUE || graph->distance[v][u] < INFINITY_VALUE);
+}
+
+static bool adjacency_build(const Graph *graph, Adjacency *adjacency) {
+    int n = graph->vertices;
+    adjacency->offsets = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    adjacency->targets = NULL;
+    if (!adjacency->offsets) {
+        return false;
+    }
+
+    size_t count = 0;
+    for (int u = 0; u < n; u++) {
+        for (int v = 0; v < n; v++) {
+            count += adjacent(graph, u, v);
+        }
+    }
+    adjacency->targets = (int*)malloc((count > 0 ? count : 1) * sizeof(int));
+    if (!adjacency->targets) {
+        adjacency_free(adjacency);
+        return false;
+    }
+
+    int edge = 0;
+    for (int u = 0; u < n; u++) {
+        adjacency->offsets[u] = edge;
+        for (int v = 0; v < n; v++) {
+            if (adjacent(graph, u, v)) {
+                adjacency->targets[edge++] = v;
+            }
+        }
+    }
+    adjacency->offsets[n] = edge;
+    return true;
+}
+
+static int degree_of(const Adjacency *adjacency, int v) {
+    return adjacency->offsets[v + 1] - adjacency->offsets[v];
+}
+
+/*
+ * Append the BFS order of start's component to out[count..]; with by_degree
+ * the neighbours found from one vertex are appended lowest degree first
+ * (Cuthill-McKee). Returns the new count.
+ */
+static int append_bfs(const Adjacency *adjacency, int start, bool by_degree, bool *visited, int *out, int count) {
+    int head = count;
+    out[count++] = start;
+    visited[start] = true;
+
+    while (head < count) {
+        int v = out[head++];
+        int first = count;
+        for (int e = adjacency->offsets[v]; e < adjacency->offsets[v + 1]; e++) {
+            int w = adjacency->targets[e];
+            if (!visited[w]) {
+                visited[w] = true;
+                out[count++] = w;
+            }
+        }
+        if (!by_degree) {
+            continue;
+        }
+        for (int t = first + 1; t < count; t++) {
+            int w = out[t];
+            int s = t;
+            while (s > first && (degree_of(adjacency, out[s - 1]) > degree_of(adjacency, w) ||
+                                 (degree_of(adjacency, out[s - 1]) == degree_of(adjacency, w) && out[s - 1] > w))) {
+                out[s] = out[s - 1];
+                s--;
+            }
+            out[s] = w;
+        }
+    }
+    return count;
+}
+
+/* Cuthill-McKee from the lowest-degree vertex of each component, then reversed */
+static void order_rcm(const Adjacency *adjacency, int n, bool *visited, int *order) {
+    int count = 0;
+    while (count < n) {
+        int start = -1;
+        for (int v = 0; v < n; v++) {
+            if (!visited[v] && (start < 0 || degree_of(adjacency, v) < degree_of(adjacency, start))) {
+                start = v;
+            }
+        }
+        count = append_bfs(adjacency, start, true, visited, order, count);
+    }
+
+    for (int i = 0; i < n / 2; i++) {
+        int swap = order[i];
+        order[i] = order[n - 1 - i];
+        order[n - 1 - i] = swap;
+    }
+}
+
+static void order_bfs(const Adjacency *adjacency, int n, bool *visited, int *order) {
+    int count = 0;
+    for (int v = 0; v < n; v++) {
+        if (!visited[v]) {
+            count = append_bfs(adjacency, v, false, visited, order, count);
+        }
+    }
+}
+
+/*
+ * Asynchronous label propagation: each vertex takes the label most common
+ * among its neighbours (smallest on ties). Communities are then laid out
+ * contiguously in the order BFS first reaches them, BFS order inside.
+ */
+static bool order_community(const Adjacency *adjacency, int n, bool *visited, int *order) {
+    int *label = (int*)malloc((size_t)n * sizeof(int));
+    int *tally = (int*)calloc((size_t)n, sizeof(int));
+    int *bfs = (int*)malloc((size_t)n * sizeof(int));
+    int *group = (int*)malloc((size_t)n * sizeof(int));
+    int *start = (int*)calloc((size_t)n + 1, sizeof(int));
+    if (!label || !tally || !bfs || !group || !start) {
+        free(label);
+        free(tally);
+        free(bfs);
+        free(group);
+        free(start);
+        return false;
+    }
+
+    for (int v = 0; v < n; v++) {
+        label[v] = v;
+    }
+    bool changed = true;
+    for (int round = 0; round < COMMUNITY_MAX_ROUNDS && changed; round++) {
+        changed = false;
+        for (int v = 0; v < n; v++) {
+            int best = label[v];
+            int best_count = 0;
+            for (int e = adjacency->offsets[v]; e < adjacency->offsets[v + 1]; e++) {
+                int l = label[adjacency->targets[e]];
+                tally[l]++;
+                if (tally[l] > best_count || (tally[l] == best_count && l < best)) {
+                    best = l;
+                    best_count = tally[l];
+                }
+            }
+            for (int e = adjacency->offsets[v]; e < adjacency->offsets[v + 1]; e++) {
+                tally[label[adjacency->targets[e]]] = 0;
+            }
+            if (best_count > 0 && best != label[v]) {
+                label[v] = best;
+                changed = true;
+            }
+        }
+    }
+
+    /* Number communities by first BFS visit, then bucket vertices in BFS order */
+    order_bfs(adjacency, n, visited, bfs);
+    for (int v = 0; v < n; v++) {
+        group[v] = -1;
+    }
+    int groups = 0;
+    for (int i = 0; i < n; i++) {
+        int l = label[bfs[i]];
+        if (group[l] < 0) {
+            group[l] = groups++;
+        }
+        start[group[l] + 1]++;
+    }
+    for (int g = 0; g < groups; g++) {
+        start[g + 1] += start[g];
+    }
+    for (int i = 0; i < n; i++) {
+        order[start[group[label[bfs[i]]]]++] = bfs[i];
+    }
+
+    free(label);
+    free(tally);
+    free(bfs);
+    free(group);
+    free(start);
+    return true;
+}
+
+VertexOrder* vertex_order_create(const Graph *graph, VertexOrderStrategy strategy) {
+    if (!graph || !graph->is_initialized || strategy < 0 || strategy >= VERTEX_ORDER_COUNT) {
+        return NULL;
+    }
+
+    int n = graph->vertices;
+    VertexOrder *order = (VertexOrder*)calloc(1, sizeof(VertexOrder));
+    if (!order) {
+        return NULL;
+    }
+    order->vertices = n;
+    order->strategy = strategy;
+    order->order = (int*)malloc((size_t)n * sizeof(int));
+    order->rank = (int*)malloc((size_t)n * sizeof(int));
+    bool *visited = (bool*)calloc((size_t)n, sizeof(bool));
+    Adjacency adjacency;
+    if (!order->order || !order->rank || !visited || !adjacency_build(graph, &adjacency)) {
+        free(visited);
+        vertex_order_destroy(order);
+        return NULL;
+    }
+
+    bool ok = true;
+    switch (strategy) {
+        case VERTEX_ORDER_RCM:
+            order_rcm(&adjacency, n, visited, order->order);
+            break;
+        case VERTEX_ORDER_BFS:
+            order_bfs(&adjacency, n, visited, order->order);
+            break;
+        default:
+            ok = order_community(&adjacency, n, visited, order->order);
+            break;
+    }
+    adjacency_free(&adjacency);
+    free(visited);
+
+    if (!ok) {
+        vertex_order_destroy(order);
+        return NULL;
+    }
+    for (int i = 0; i < n; i++) {
+        order->rank[order->order[i]] = i;
+    }
+    return order;
+}
+
+void vertex_order_destroy(VertexOrder *order) {
+    if (!order) {
+        return;
+    }
+
+    free(order->order);
+    free(order->rank);
+    free(order);
+}
+
+Graph* vertex_order_apply(const VertexOrder *order, const Graph *graph) {
+    if (!order || !graph || !graph->is_initialized || graph->vertices != order->vertices) {
+        return NULL;
+    }
+
+    int n = graph->vertices;
+    Graph *permuted = graph_create(n);
+    if (!permuted) {
+        return NULL;
+    }
+    for (int i = 0; i < n; i++) {
+        const double *distance_row = graph->distance[order->order[i]];
+        const int *next_row = graph->next[order->order[i]];
+        for (int j = 0; j < n; j++) {
+            int hop = next_row[order->order[j]];
+            permuted->distance[i][j] = distance_row[order->order[j]];
+            permuted->next[i][j] = hop >= 0 ? order->rank[hop] : -1;
+        }
+    }
+    return permuted;
+}
+
+ReturnCode vertex_order_restore(const VertexOrder *order, const Graph *permuted, Graph *graph) {
+    if (!order || !permuted || !graph || !graph->is_initialized) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if (permuted->vertices != order->vertices || graph->vertices != order->vertices) {
+        return ERROR_INVALID_INPUT;
+    }
+
+    int n = graph->vertices;
+    for (int i = 0; i < n; i++) {
+        double *distance_row = graph->distance[order->order[i]];
+        int *next_row = graph->next[order->order[i]];
+        for (int j = 0; j < n; j++) {
+            int hop = permuted->next[i][j];
+            distance_row[order->order[j]] = permuted->distance[i][j];
+            next_row[order->order[j]] = hop >= 0 ? order->order[hop] : -1;
+        }
+    }
+    return SUCCESS;
+}
+
+/* Strategy names used on the command line */
+static const char *strategy_names[VERTEX_ORDER_COUNT] = {
+    "rcm",
+    "bfs",
+    "community"
+};
+
+const char* vertex_order_strategy_name(VertexOrderStrategy strategy) {
+    if (strategy < 0 || strategy >= VERTEX_ORDER_COUNT) {
+        return "unknown";
+    }
+    return strategy_names[strategy];
+}
+
+VertexOrderStrategy vertex_order_strategy_from_name(const char *name) {
+    if (!name) {
+        return VERTEX_ORDER_COUNT;
+    }
+
+    for (int s = 0; s < VERTEX_ORDER_COUNT; s++) {
+        if (strcmp(name, strategy_names[s]) == 0) {
+            return (VertexOrderStrategy)s;
+        }
+    }
+    return VERTEX_ORDER_COUNT;
+}
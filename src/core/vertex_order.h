@@ -0,0 +1,42 @@
+#ifndef VERTEX_ORDER_H
+#define VERTEX_ORDER_H
+
+#include "../data_structures/graph.h"
+
+/* How vertices are renumbered before compute */
+typedef enum {
+    VERTEX_ORDER_RCM = 0,       /* Reverse Cuthill-McKee: BFS from a low-degree vertex, neighbours by degree, reversed */
+    VERTEX_ORDER_BFS,           /* Plain BFS order per connected component */
+    VERTEX_ORDER_COMMUNITY,     /* Label-propagation communities kept contiguous, BFS order inside */
+    VERTEX_ORDER_COUNT
+} VertexOrderStrategy;
+
+/*
+ * Permutation of the vertices of a graph. Neighbours (in either direction)
+ * end up close together, so tiles of the permuted matrix are more often
+ * entirely infinite or settle early, and rows touched together share cache
+ * lines. Compute runs on a permuted copy; vertex_order_restore writes the
+ * result back in the original numbering, so accessors and writers need no
+ * mapping.
+ */
+typedef struct {
+    int vertices;
+    VertexOrderStrategy strategy;
+    int *order;                 /* Position -> original vertex */
+    int *rank;                  /* Original vertex -> position */
+} VertexOrder;
+
+VertexOrder* vertex_order_create(const Graph *graph, VertexOrderStrategy strategy);
+void vertex_order_destroy(VertexOrder *order);
+
+/* Copy of graph in the permuted numbering; NULL on failure */
+Graph* vertex_order_apply(const VertexOrder *order, const Graph *graph);
+
+/* Write the solved permuted copy back into graph (original numbering) */
+ReturnCode vertex_order_restore(const VertexOrder *order, const Graph *permuted, Graph *graph);
+
+/* Strategy registry for the command line */
+const char* vertex_order_strategy_name(VertexOrderStrategy strategy);
+VertexOrderStrategy vertex_order_strategy_from_name(const char *name);
+
+#endif /* VERTEX_ORDER_H */
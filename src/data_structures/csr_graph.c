@@ -0,0 +1,186 @@
+#include "csr_graph.h"
+#include <stdlib.h>
+#include <math.h>
+
+static bool valid_weight(double weight) {
+    return !isnan(weight) && weight < INFINITY_VALUE && weight > -INFINITY_VALUE;
+}
+
+CsrGraph* csr_graph_wrap(int vertices, const int *row_ptr, const int *col_idx, const double *weights) {
+    if (vertices <= 0 || vertices > MAX_VERTICES || !row_ptr || row_ptr[0] != 0) {
+        return NULL;
+    }
+
+    for (int u = 0; u < vertices; u++) {
+        if (row_ptr[u + 1] < row_ptr[u]) {
+            return NULL;
+        }
+    }
+    int edges = row_ptr[vertices];
+    if (edges > 0 && !col_idx) {
+        return NULL;
+    }
+    for (int e = 0; e < edges; e++) {
+        if (col_idx[e] < 0 || col_idx[e] >= vertices || (weights && !valid_weight(weights[e]))) {
+            return NULL;
+        }
+    }
+
+    CsrGraph *csr = (CsrGraph*)malloc(sizeof(CsrGraph));
+    if (!csr) {
+        return NULL;
+    }
+    csr->vertices = vertices;
+    csr->edges = edges;
+    csr->row_ptr = row_ptr;
+    csr->col_idx = col_idx;
+    csr->weights = weights;
+    csr->owns_arrays = false;
+    return csr;
+}
+
+/* Owned arrays for vertices rows and edges entries (weights only if requested) */
+static CsrGraph* csr_graph_allocate(int vertices, int edges, bool weighted,
+                                    int **row_ptr, int **col_idx, double **weights) {
+    CsrGraph *csr = (CsrGraph*)malloc(sizeof(CsrGraph));
+    *row_ptr = (int*)calloc((size_t)vertices + 1, sizeof(int));
+    *col_idx = (int*)malloc((edges > 0 ? (size_t)edges : 1) * sizeof(int));
+    *weights = weighted ? (double*)malloc((edges > 0 ? (size_t)edges : 1) * sizeof(double)) : NULL;
+    if (!csr || !*row_ptr || !*col_idx || (weighted && !*weights)) {
+        free(csr);
+        free(*row_ptr);
+        free(*col_idx);
+        free(*weights);
+        return NULL;
+    }
+
+    csr->vertices = vertices;
+    csr->edges = edges;
+    csr->row_ptr = *row_ptr;
+    csr->col_idx = *col_idx;
+    csr->weights = *weights;
+    csr->owns_arrays = true;
+    return csr;
+}
+
+CsrGraph* csr_graph_from_edges(int vertices, const int *from, const int *to, const double *weights, int count) {
+    if (vertices <= 0 || vertices > MAX_VERTICES || count < 0 || (count > 0 && (!from || !to))) {
+        return NULL;
+    }
+
+    for (int e = 0; e < count; e++) {
+        if (from[e] < 0 || from[e] >= vertices || to[e] < 0 || to[e] >= vertices ||
+            (weights && !valid_weight(weights[e]))) {
+            return NULL;
+        }
+    }
+
+    int *row_ptr, *col_idx;
+    double *row_weights;
+    CsrGraph *csr = csr_graph_allocate(vertices, count, weights != NULL, &row_ptr, &col_idx, &row_weights);
+    if (!csr) {
+        return NULL;
+    }
+
+    /* Counting sort by source; edges keep their input order within a row */
+    for (int e = 0; e < count; e++) {
+        row_ptr[from[e] + 1]++;
+    }
+    for (int u = 0; u < vertices; u++) {
+        row_ptr[u + 1] += row_ptr[u];
+    }
+    for (int e = 0; e < count; e++) {
+        int slot = row_ptr[from[e]]++;
+        col_idx[slot] = to[e];
+        if (weights) {
+            row_weights[slot] = weights[e];
+        }
+    }
+    for (int u = vertices; u > 0; u--) {
+        row_ptr[u] = row_ptr[u - 1];
+    }
+    row_ptr[0] = 0;
+    return csr;
+}
+
+CsrGraph* csr_graph_from_graph(const Graph *graph) {
+    if (!graph || !graph->is_initialized) {
+        return NULL;
+    }
+
+    int n = graph->vertices;
+    int edges = 0;
+    for (int u = 0; u < n; u++) {
+        const double *row = graph->distance[u];
+        for (int v = 0; v < n; v++) {
+            edges += row[v] < INFINITY_VALUE && (u != v || row[v] < 0.0);
+        }
+    }
+
+    int *row_ptr, *col_idx;
+    double *weights;
+    CsrGraph *csr = csr_graph_allocate(n, edges, true, &row_ptr, &col_idx, &weights);
+    if (!csr) {
+        return NULL;
+    }
+
+    int edge = 0;
+    for (int u = 0; u < n; u++) {
+        const double *row = graph->distance[u];
+        for (int v = 0; v < n; v++) {
+            if (row[v] < INFINITY_VALUE && (u != v || row[v] < 0.0)) {
+                col_idx[edge] = v;
+                weights[edge++] = row[v];
+            }
+        }
+        row_ptr[u + 1] = edge;
+    }
+    return csr;
+}
+
+void csr_graph_destroy(CsrGraph *csr) {
+    if (!csr) {
+        return;
+    }
+
+    if (csr->owns_arrays) {
+        free((void*)csr->row_ptr);
+        free((void*)csr->col_idx);
+        free((void*)csr->weights);
+    }
+    free(csr);
+}
+
+void csr_graph_expand_row(const CsrGraph *csr, Graph *graph, int u) {
+    int n = graph->vertices;
+    double *distance_u = graph->distance[u];
+    int *next_u = graph->next[u];
+    for (int v = 0; v < n; v++) {
+        distance_u[v] = u == v ? 0.0 : INFINITY_VALUE;
+        next_u[v] = -1;
+    }
+
+    for (int e = csr->row_ptr[u]; e < csr->row_ptr[u + 1]; e++) {
+        int v = csr->col_idx[e];
+        double weight = csr_graph_weight(csr, e);
+        if (weight < distance_u[v]) {
+            distance_u[v] = weight;
+            next_u[v] = v;
+        }
+    }
+}
+
+ReturnCode csr_graph_expand(const CsrGraph *csr, Graph *graph) {
+    if (!csr || !graph || !graph->is_initialized) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if (graph->vertices != csr->vertices) {
+        return ERROR_INVALID_INPUT;
+    }
+
+    for (int u = 0; u < csr->vertices; u++) {
+        csr_graph_expand_row(csr, graph, u);
+    }
+    return SUCCESS;
+}
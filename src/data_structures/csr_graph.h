@@ -0,0 +1,46 @@
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include "graph.h"
+
+/*
+ * Sparse graph in compressed sparse row form: the out-edges of u are
+ * col_idx[row_ptr[u] .. row_ptr[u + 1]) with the matching weights.
+ * csr_graph_wrap only references the caller's arrays, which must stay
+ * valid and unchanged while the CsrGraph is in use; csr_graph_from_edges
+ * and csr_graph_from_graph own theirs. Parallel edges are allowed (the
+ * cheapest one counts) and self-loops with a non-negative weight are
+ * ignored. The sparse engines (dag, bfs) read these arrays directly; the
+ * dense ones get a matrix from csr_graph_expand.
+ */
+typedef struct {
+    int vertices;
+    int edges;
+    const int *row_ptr;         /* vertices + 1 entries, row_ptr[0] == 0 */
+    const int *col_idx;         /* edges entries */
+    const double *weights;      /* edges entries; NULL: every edge weighs 1 */
+    bool owns_arrays;           /* Freed by csr_graph_destroy */
+} CsrGraph;
+
+/* Reference caller-owned arrays after an O(n + m) check; NULL if they are malformed */
+CsrGraph* csr_graph_wrap(int vertices, const int *row_ptr, const int *col_idx, const double *weights);
+
+/* Edge array (from[e] -> to[e], weights may be NULL) sorted into owned CSR arrays */
+CsrGraph* csr_graph_from_edges(int vertices, const int *from, const int *to, const double *weights, int count);
+
+/* Finite off-diagonal entries of a dense graph (and negative diagonal ones, as self-loops) */
+CsrGraph* csr_graph_from_graph(const Graph *graph);
+
+void csr_graph_destroy(CsrGraph *csr);
+
+static inline double csr_graph_weight(const CsrGraph *csr, int edge) {
+    return csr->weights ? csr->weights[edge] : 1.0;
+}
+
+/* Row u of graph: cleared, then the cheapest edge to each target */
+void csr_graph_expand_row(const CsrGraph *csr, Graph *graph, int u);
+
+/* Dense copy into graph (same vertex count), row by row */
+ReturnCode csr_graph_expand(const CsrGraph *csr, Graph *graph);
+
+#endif /* CSR_GRAPH_H */
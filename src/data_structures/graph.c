@@ -1,10 +1,17 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include "graph.h"
 #include "../utils/memory_manager.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
 
-Graph* graph_create(int vertices) {
+/* Heap storage without initialization; graph_copy overwrites every element anyway */
+static Graph* graph_allocate(int vertices) {
     if (vertices <= 0 || vertices > MAX_VERTICES) {
         return NULL;
     }
@@ -16,6 +23,7 @@ Graph* graph_create(int vertices) {
 
     graph->vertices = vertices;
     graph->is_initialized = false;
+    graph->storage = GRAPH_STORAGE_HEAP;
 
     /* Allocate distance matrix */
     graph->distance = allocate_2d_double(vertices, vertices);
@@ -32,6 +40,15 @@ Graph* graph_create(int vertices) {
         return NULL;
     }
 
+    return graph;
+}
+
+Graph* graph_create(int vertices) {
+    Graph *graph = graph_allocate(vertices);
+    if (!graph) {
+        return NULL;
+    }
+
     /* Initialize the graph */
     if (graph_initialize(graph) != SUCCESS) {
         graph_destroy(graph);
@@ -41,8 +58,26 @@ Graph* graph_create(int vertices) {
     return graph;
 }
 
+/* Layout of an image and its snapshots: distance block padded to a page, then next */
+static void image_layout(int vertices, size_t *distance_bytes, size_t *size) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t cells = (size_t)vertices * (size_t)vertices;
+    *distance_bytes = (cells * sizeof(double) + page - 1) / page * page;
+    *size = *distance_bytes + cells * sizeof(int);
+}
+
 void graph_destroy(Graph *graph) {
-    if (!graph) {
+    if (!graph || graph->storage == GRAPH_STORAGE_EXTERNAL) {
+        return;
+    }
+
+    if (graph->storage == GRAPH_STORAGE_MAPPED) {
+        size_t distance_bytes, size;
+        image_layout(graph->vertices, &distance_bytes, &size);
+        munmap(graph->distance[0], size);
+        free(graph->distance);
+        free(graph->next);
+        free(graph);
         return;
     }
 
@@ -146,22 +181,118 @@ Graph* graph_copy(const Graph *original) {
         return NULL;
     }
 
-    Graph *copy = graph_create(original->vertices);
+    int n = original->vertices;
+    Graph *copy = graph_allocate(n);
     if (!copy) {
         return NULL;
     }
 
-    /* Copy distance matrix */
-    for (int i = 0; i < original->vertices; i++) {
-        for (int j = 0; j < original->vertices; j++) {
-            copy->distance[i][j] = original->distance[i][j];
-            copy->next[i][j] = original->next[i][j];
+    /* Heap and mapped graphs are contiguous; externally owned rows may be padded */
+    if (original->storage != GRAPH_STORAGE_EXTERNAL) {
+        size_t cells = (size_t)n * (size_t)n;
+        memcpy(copy->distance[0], original->distance[0], cells * sizeof(double));
+        memcpy(copy->next[0], original->next[0], cells * sizeof(int));
+    } else {
+        for (int i = 0; i < n; i++) {
+            memcpy(copy->distance[i], original->distance[i], (size_t)n * sizeof(double));
+            memcpy(copy->next[i], original->next[i], (size_t)n * sizeof(int));
         }
     }
 
+    copy->is_initialized = true;
     return copy;
 }
 
+GraphImage* graph_image_create(const Graph *graph) {
+    if (!graph || !graph->is_initialized) {
+        return NULL;
+    }
+
+    GraphImage *image = (GraphImage*)malloc(sizeof(GraphImage));
+    if (!image) {
+        return NULL;
+    }
+    image->vertices = graph->vertices;
+    image_layout(graph->vertices, &image->distance_bytes, &image->size);
+
+    /* The name only lives until the descriptor exists */
+    static int sequence = 0;
+    char name[64];
+    snprintf(name, sizeof(name), "/floyd_warshall_image_%ld_%d", (long)getpid(), sequence++);
+    image->fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (image->fd < 0) {
+        free(image);
+        return NULL;
+    }
+    shm_unlink(name);
+
+    void *base = MAP_FAILED;
+    if (ftruncate(image->fd, (off_t)image->size) == 0) {
+        base = mmap(NULL, image->size, PROT_READ | PROT_WRITE, MAP_SHARED, image->fd, 0);
+    }
+    if (base == MAP_FAILED) {
+        close(image->fd);
+        free(image);
+        return NULL;
+    }
+
+    int n = graph->vertices;
+    double *distance = (double*)base;
+    int *next = (int*)((char*)base + image->distance_bytes);
+    for (int i = 0; i < n; i++) {
+        memcpy(distance + (size_t)i * n, graph->distance[i], (size_t)n * sizeof(double));
+        memcpy(next + (size_t)i * n, graph->next[i], (size_t)n * sizeof(int));
+    }
+    munmap(base, image->size);
+
+    return image;
+}
+
+/* Snapshots keep their own mapping and stay valid after the image is destroyed */
+void graph_image_destroy(GraphImage *image) {
+    if (!image) {
+        return;
+    }
+
+    close(image->fd);
+    free(image);
+}
+
+Graph* graph_snapshot(const GraphImage *image) {
+    if (!image) {
+        return NULL;
+    }
+
+    int n = image->vertices;
+    Graph *graph = (Graph*)malloc(sizeof(Graph));
+    double **distance_rows = (double**)malloc((size_t)n * sizeof(double*));
+    int **next_rows = (int**)malloc((size_t)n * sizeof(int*));
+    void *base = MAP_FAILED;
+    if (graph && distance_rows && next_rows) {
+        base = mmap(NULL, image->size, PROT_READ | PROT_WRITE, MAP_PRIVATE, image->fd, 0);
+    }
+    if (base == MAP_FAILED) {
+        free(graph);
+        free(distance_rows);
+        free(next_rows);
+        return NULL;
+    }
+
+    double *distance = (double*)base;
+    int *next = (int*)((char*)base + image->distance_bytes);
+    for (int i = 0; i < n; i++) {
+        distance_rows[i] = distance + (size_t)i * n;
+        next_rows[i] = next + (size_t)i * n;
+    }
+
+    graph->vertices = n;
+    graph->distance = distance_rows;
+    graph->next = next_rows;
+    graph->is_initialized = true;
+    graph->storage = GRAPH_STORAGE_MAPPED;
+    return graph;
+}
+
 void graph_print(const Graph *graph) {
     if (!graph || !graph->is_initialized) {
         printf("Invalid or uninitialized graph\n");
@@ -1,16 +1,37 @@
 #ifndef GRAPH_H
 #define GRAPH_H
 
+#include <stddef.h>
 #include "../core/constants.h"
 
+/* Who owns a graph's matrices; graph_destroy releases them accordingly */
+typedef enum {
+    GRAPH_STORAGE_HEAP = 0,     /* One contiguous n x n block per matrix (graph_create) */
+    GRAPH_STORAGE_MAPPED,       /* Private copy-on-write mapping of a GraphImage */
+    GRAPH_STORAGE_EXTERNAL      /* Rows owned elsewhere (Solver); not contiguous, never destroyed */
+} GraphStorage;
+
 /* Graph structure for Floyd-Warshall algorithm */
 typedef struct {
     int vertices;           /* Number of vertices in the graph */
     double **distance;      /* Distance matrix */
     int **next;            /* Next vertex matrix for path reconstruction */
     bool is_initialized;    /* Flag to check if graph is properly initialized */
+    GraphStorage storage;   /* Owner of the matrix memory */
 } Graph;
 
+/*
+ * Shared read-only image of a graph's matrices. Snapshots map it privately,
+ * so they start out sharing every page with the image and the kernel copies
+ * a page (512 distances) only when a snapshot first writes to it.
+ */
+typedef struct {
+    int vertices;
+    int fd;                 /* Unlinked shared memory object holding both matrices */
+    size_t distance_bytes;  /* Distance block, padded to a page; the next block follows */
+    size_t size;
+} GraphImage;
+
 /* Graph creation and destruction functions */
 Graph* graph_create(int vertices);
 void graph_destroy(Graph *graph);
@@ -26,6 +47,11 @@ Graph* graph_copy(const Graph *original);
 void graph_print(const Graph *graph);
 void graph_print_distances(const Graph *graph);
 
+/* Copy-on-write snapshots: image once, then snapshot as often as needed */
+GraphImage* graph_image_create(const Graph *graph);
+void graph_image_destroy(GraphImage *image);
+Graph* graph_snapshot(const GraphImage *image);
+
 /* Graph initialization helper */
 ReturnCode graph_initialize(Graph *graph);
 
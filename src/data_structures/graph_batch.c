@@ -0,0 +1,253 @@
+#include "graph_batch.h"
+#include "../utils/memory_manager.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+/* Lane vectors are loaded whole, so every matrix starts on a vector boundary */
+#define BATCH_ALIGNMENT 64
+
+static size_t group_elements(const GraphBatch *batch) {
+    return (size_t)batch->vertices * (size_t)batch->vertices * FW_BATCH_LANES;
+}
+
+static bool valid_graph_index(const GraphBatch *batch, int graph) {
+    return batch && batch->is_initialized && graph >= 0 && graph < batch->count;
+}
+
+static bool valid_vertex(const GraphBatch *batch, int vertex) {
+    return vertex >= 0 && vertex < batch->vertices;
+}
+
+/* Reset every graph (and padding lane) of a group to "no edges" */
+static void clear_group(GraphBatch *batch, int group) {
+    int n = batch->vertices;
+    double *distance = batch->distance + (size_t)group * group_elements(batch);
+    int64_t *next = batch->next + (size_t)group * group_elements(batch);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            for (int lane = 0; lane < FW_BATCH_LANES; lane++) {
+                *distance++ = (i == j) ? 0.0 : HUGE_VAL;
+                *next++ = -1;
+            }
+        }
+    }
+}
+
+GraphBatch* graph_batch_create(int vertices, int count) {
+    if (vertices <= 0 || vertices > MAX_VERTICES || count <= 0) {
+        return NULL;
+    }
+
+    GraphBatch *batch = (GraphBatch*)malloc(sizeof(GraphBatch));
+    if (!batch) {
+        return NULL;
+    }
+
+    batch->vertices = vertices;
+    batch->count = count;
+    batch->groups = (count + FW_BATCH_LANES - 1) / FW_BATCH_LANES;
+    batch->is_initialized = false;
+
+    size_t elements = (size_t)batch->groups * group_elements(batch);
+    batch->distance = (double*)allocate_aligned(elements * sizeof(double), BATCH_ALIGNMENT);
+    batch->next = (int64_t*)allocate_aligned(elements * sizeof(int64_t), BATCH_ALIGNMENT);
+    batch->negative_cycle = (bool*)calloc((size_t)count, sizeof(bool));
+    if (!batch->distance || !batch->next || !batch->negative_cycle) {
+        graph_batch_destroy(batch);
+        return NULL;
+    }
+
+    /* Padding lanes of the last group are solved too; they stay empty graphs */
+    for (int group = 0; group < batch->groups; group++) {
+        clear_group(batch, group);
+    }
+
+    batch->is_initialized = true;
+    return batch;
+}
+
+void graph_batch_destroy(GraphBatch *batch) {
+    if (!batch) {
+        return;
+    }
+
+    size_t elements = (size_t)batch->groups * group_elements(batch);
+    deallocate_aligned(batch->distance, elements * sizeof(double));
+    deallocate_aligned(batch->next, elements * sizeof(int64_t));
+    free(batch->negative_cycle);
+    free(batch);
+}
+
+size_t graph_batch_index(const GraphBatch *batch, int graph, int i, int j) {
+    int group = graph / FW_BATCH_LANES;
+    int lane = graph % FW_BATCH_LANES;
+    return (size_t)group * group_elements(batch) +
+           ((size_t)i * batch->vertices + j) * FW_BATCH_LANES + (size_t)lane;
+}
+
+ReturnCode graph_batch_add_edge(GraphBatch *batch, int graph, int from, int to, double weight) {
+    if (!batch || !batch->is_initialized) {
+        return ERROR_NULL_POINTER;
+    }
+
+    /* Self loops are rejected like graph_validate rejects a nonzero diagonal */
+    if (!valid_graph_index(batch, graph) || !valid_vertex(batch, from) ||
+        !valid_vertex(batch, to) || from == to) {
+        return ERROR_INVALID_INPUT;
+    }
+
+    if (weight >= INFINITY_VALUE) {
+        return SUCCESS;
+    }
+
+    size_t index = graph_batch_index(batch, graph, from, to);
+    if (weight < batch->distance[index]) {
+        batch->distance[index] = weight;
+        batch->next[index] = to;
+    }
+
+    return SUCCESS;
+}
+
+double graph_batch_get_distance(const GraphBatch *batch, int graph, int from, int to) {
+    if (!valid_graph_index(batch, graph) || !valid_vertex(batch, from) || !valid_vertex(batch, to)) {
+        return INFINITY_VALUE;
+    }
+
+    double distance = batch->distance[graph_batch_index(batch, graph, from, to)];
+    return distance >= INFINITY_VALUE ? INFINITY_VALUE : distance;
+}
+
+ReturnCode graph_batch_set_matrix(GraphBatch *batch, int graph, const double *weights) {
+    if (!batch || !weights) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if (!valid_graph_index(batch, graph)) {
+        return ERROR_INVALID_INPUT;
+    }
+
+    /* Every entry of the lane is written once, walking it with the lane stride */
+    int n = batch->vertices;
+    size_t index = graph_batch_index(batch, graph, 0, 0);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++, index += FW_BATCH_LANES) {
+            double weight = weights[(size_t)i * n + j];
+            bool edge = i != j && weight < INFINITY_VALUE;
+            batch->distance[index] = edge ? weight : (i == j ? 0.0 : HUGE_VAL);
+            batch->next[index] = edge ? j : -1;
+        }
+    }
+
+    return SUCCESS;
+}
+
+ReturnCode graph_batch_get_matrix(const GraphBatch *batch, int graph, double *distances) {
+    if (!batch || !distances) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if (!valid_graph_index(batch, graph)) {
+        return ERROR_INVALID_INPUT;
+    }
+
+    int n = batch->vertices;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            distances[(size_t)i * n + j] = graph_batch_get_distance(batch, graph, i, j);
+        }
+    }
+
+    return SUCCESS;
+}
+
+GraphBatch* graph_batch_from_matrices(int vertices, int count, const double *weights) {
+    if (!weights) {
+        return NULL;
+    }
+
+    GraphBatch *batch = graph_batch_create(vertices, count);
+    if (!batch) {
+        return NULL;
+    }
+
+    size_t matrix = (size_t)vertices * (size_t)vertices;
+    for (int g = 0; g < count; g++) {
+        graph_batch_set_matrix(batch, g, weights + (size_t)g * matrix);
+    }
+
+    return batch;
+}
+
+ReturnCode graph_batch_set_graph(GraphBatch *batch, int graph, const Graph *source) {
+    if (!batch || !source || !source->is_initialized) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if (!valid_graph_index(batch, graph) || source->vertices != batch->vertices) {
+        return ERROR_INVALID_INPUT;
+    }
+
+    int n = batch->vertices;
+    size_t index = graph_batch_index(batch, graph, 0, 0);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++, index += FW_BATCH_LANES) {
+            bool edge = i != j && source->distance[i][j] < INFINITY_VALUE;
+            batch->distance[index] = edge ? source->distance[i][j] : (i == j ? 0.0 : HUGE_VAL);
+            batch->next[index] = edge ? source->next[i][j] : -1;
+        }
+    }
+
+    return SUCCESS;
+}
+
+Graph* graph_batch_extract_graph(const GraphBatch *batch, int graph) {
+    if (!valid_graph_index(batch, graph)) {
+        return NULL;
+    }
+
+    Graph *result = graph_create(batch->vertices);
+    if (!result) {
+        return NULL;
+    }
+
+    int n = batch->vertices;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            size_t index = graph_batch_index(batch, graph, i, j);
+            result->distance[i][j] = graph_batch_get_distance(batch, graph, i, j);
+            result->next[i][j] = (int)batch->next[index];
+        }
+    }
+
+    return result;
+}
+
+void graph_batch_print_distances(const GraphBatch *batch, int graph) {
+    if (!valid_graph_index(batch, graph)) {
+        printf("Invalid batch or graph index\n");
+        return;
+    }
+
+    printf("=== Shortest Distance Matrix (graph %d) ===\n", graph);
+    printf("      ");
+    for (int j = 0; j < batch->vertices; j++) {
+        printf("%8d", j);
+    }
+    printf("\n");
+
+    for (int i = 0; i < batch->vertices; i++) {
+        printf("%4d: ", i);
+        for (int j = 0; j < batch->vertices; j++) {
+            double value = graph_batch_get_distance(batch, graph, i, j);
+            if (value >= INFINITY_VALUE) {
+                printf("     INF");
+            } else {
+                printf("%8.2f", value);
+            }
+        }
+        printf("\n");
+    }
+    printf("\n");
+}
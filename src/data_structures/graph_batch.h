@@ -0,0 +1,51 @@
+#ifndef GRAPH_BATCH_H
+#define GRAPH_BATCH_H
+
+#include "graph.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Many independent graphs with the same vertex count, stored
+ * structure-of-arrays: graphs are interleaved in groups of FW_BATCH_LANES so
+ * that element (i, j) of every graph in a group is one contiguous lane vector,
+ * laid out as [group][i][j][lane]. Unreachable pairs are held as HUGE_VAL
+ * internally; the accessors report them as INFINITY_VALUE like Graph does.
+ */
+typedef struct {
+    int vertices;           /* Vertices of every graph in the batch */
+    int count;              /* Number of graphs */
+    int groups;             /* ceil(count / FW_BATCH_LANES); the last group may be padded */
+    double *distance;       /* Interleaved distance matrices */
+    int64_t *next;          /* Interleaved next-hop matrices (-1: no path) */
+    bool *negative_cycle;   /* Per graph, set by floyd_warshall_execute_batch */
+    bool is_initialized;    /* Flag to check if batch is properly initialized */
+} GraphBatch;
+
+/* Creation and destruction functions */
+GraphBatch* graph_batch_create(int vertices, int count);
+void graph_batch_destroy(GraphBatch *batch);
+
+/* Offset of element (i, j) of a graph in distance/next */
+size_t graph_batch_index(const GraphBatch *batch, int graph, int i, int j);
+
+/* Edge management functions (parallel edges keep the lighter weight) */
+ReturnCode graph_batch_add_edge(GraphBatch *batch, int graph, int from, int to, double weight);
+double graph_batch_get_distance(const GraphBatch *batch, int graph, int from, int to);
+
+/*
+ * Array API: weights/distances are vertices x vertices row-major matrices;
+ * entries >= INFINITY_VALUE (and the diagonal) mean "no edge".
+ */
+ReturnCode graph_batch_set_matrix(GraphBatch *batch, int graph, const double *weights);
+ReturnCode graph_batch_get_matrix(const GraphBatch *batch, int graph, double *distances);
+GraphBatch* graph_batch_from_matrices(int vertices, int count, const double *weights);
+
+/* Conversion from/to the single-graph structure */
+ReturnCode graph_batch_set_graph(GraphBatch *batch, int graph, const Graph *source);
+Graph* graph_batch_extract_graph(const GraphBatch *batch, int graph);
+
+/* Output */
+void graph_batch_print_distances(const GraphBatch *batch, int graph);
+
+#endif /* GRAPH_BATCH_H */
@@ -0,0 +1,163 @@
+#include "symmetric_graph.h"
+#include "../utils/memory_manager.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+SymmetricGraph* symmetric_graph_create(int vertices) {
+    if (vertices <= 0 || vertices > MAX_VERTICES) {
+        return NULL;
+    }
+
+    SymmetricGraph *graph = (SymmetricGraph*)malloc(sizeof(SymmetricGraph));
+    if (!graph) {
+        return NULL;
+    }
+
+    graph->vertices = vertices;
+    graph->is_initialized = false;
+
+    graph->distance = allocate_triangle_double(vertices);
+    graph->via = allocate_triangle_int(vertices);
+    if (!graph->distance || !graph->via) {
+        symmetric_graph_destroy(graph);
+        return NULL;
+    }
+
+    for (int i = 0; i < vertices; i++) {
+        size_t row = symmetric_graph_index(vertices, i, i);
+        graph->distance[row] = 0.0;
+        graph->via[row] = -1;
+        for (int j = i + 1; j < vertices; j++) {
+            graph->distance[row + (size_t)(j - i)] = INFINITY_VALUE;
+            graph->via[row + (size_t)(j - i)] = -1;
+        }
+    }
+
+    graph->is_initialized = true;
+    return graph;
+}
+
+void symmetric_graph_destroy(SymmetricGraph *graph) {
+    if (!graph) {
+        return;
+    }
+
+    deallocate_triangle_double(graph->distance, graph->vertices);
+    deallocate_triangle_int(graph->via, graph->vertices);
+    free(graph);
+}
+
+size_t symmetric_graph_index(int vertices, int i, int j) {
+    if (i > j) {
+        int swap = i;
+        i = j;
+        j = swap;
+    }
+
+    /* Rows 0..i-1 hold n, n-1, ..., n-i+1 entries */
+    return (size_t)i * (size_t)(2 * vertices - i + 1) / 2 + (size_t)(j - i);
+}
+
+ReturnCode symmetric_graph_add_edge(SymmetricGraph *graph, int u, int v, double weight) {
+    if (!graph || !graph->is_initialized) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if (u < 0 || u >= graph->vertices ||
+        v < 0 || v >= graph->vertices) {
+        return ERROR_INVALID_INPUT;
+    }
+
+    size_t index = symmetric_graph_index(graph->vertices, u, v);
+    if (u == v || weight < graph->distance[index]) {
+        graph->distance[index] = weight;
+    }
+
+    return SUCCESS;
+}
+
+double symmetric_graph_get_edge(const SymmetricGraph *graph, int u, int v) {
+    if (!graph || !graph->is_initialized ||
+        u < 0 || u >= graph->vertices ||
+        v < 0 || v >= graph->vertices) {
+        return INFINITY_VALUE;
+    }
+
+    return graph->distance[symmetric_graph_index(graph->vertices, u, v)];
+}
+
+bool symmetric_graph_has_edge(const SymmetricGraph *graph, int u, int v) {
+    return symmetric_graph_get_edge(graph, u, v) < INFINITY_VALUE;
+}
+
+ReturnCode symmetric_graph_validate(const SymmetricGraph *graph) {
+    if (!graph) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if (!graph->is_initialized) {
+        return ERROR_INVALID_INPUT;
+    }
+
+    if (graph->vertices <= 0 || graph->vertices > MAX_VERTICES) {
+        return ERROR_INVALID_INPUT;
+    }
+
+    if (!graph->distance || !graph->via) {
+        return ERROR_NULL_POINTER;
+    }
+
+    /* Check diagonal elements are zero */
+    for (int i = 0; i < graph->vertices; i++) {
+        if (fabs(graph->distance[symmetric_graph_index(graph->vertices, i, i)]) > EPSILON) {
+            return ERROR_INVALID_INPUT;
+        }
+    }
+
+    return SUCCESS;
+}
+
+/* Full square view of the triangle, shared by both printers */
+static void print_matrix(const SymmetricGraph *graph) {
+    printf("      ");
+    for (int j = 0; j < graph->vertices; j++) {
+        printf("%8d", j);
+    }
+    printf("\n");
+
+    for (int i = 0; i < graph->vertices; i++) {
+        printf("%4d: ", i);
+        for (int j = 0; j < graph->vertices; j++) {
+            double value = graph->distance[symmetric_graph_index(graph->vertices, i, j)];
+            if (value >= INFINITY_VALUE) {
+                printf("     INF");
+            } else {
+                printf("%8.2f", value);
+            }
+        }
+        printf("\n");
+    }
+    printf("\n");
+}
+
+void symmetric_graph_print(const SymmetricGraph *graph) {
+    if (!graph || !graph->is_initialized) {
+        printf("Invalid or uninitialized graph\n");
+        return;
+    }
+
+    printf("Undirected graph with %d vertices:\n", graph->vertices);
+    printf("Adjacency Matrix (weights):\n");
+    print_matrix(graph);
+}
+
+void symmetric_graph_print_distances(const SymmetricGraph *graph) {
+    if (!graph || !graph->is_initialized) {
+        printf("Invalid or uninitialized graph\n");
+        return;
+    }
+
+    printf("=== Shortest Distance Matrix (undirected) ===\n");
+    print_matrix(graph);
+}
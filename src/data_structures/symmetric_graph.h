@@ -0,0 +1,37 @@
+#ifndef SYMMETRIC_GRAPH_H
+#define SYMMETRIC_GRAPH_H
+
+#include "../core/constants.h"
+#include <stddef.h>
+
+/*
+ * Undirected graph with packed upper-triangle storage: only d[i][j] with
+ * i <= j is stored, row-major, so both matrices take n * (n + 1) / 2
+ * entries. Instead of a next-hop matrix (which is not symmetric) each pair
+ * records the intermediate vertex its shortest path goes through.
+ */
+typedef struct {
+    int vertices;           /* Number of vertices in the graph */
+    double *distance;       /* Packed distance triangle */
+    int *via;               /* Packed intermediate vertex triangle (-1: direct edge or no path) */
+    bool is_initialized;    /* Flag to check if graph is properly initialized */
+} SymmetricGraph;
+
+/* Creation and destruction functions */
+SymmetricGraph* symmetric_graph_create(int vertices);
+void symmetric_graph_destroy(SymmetricGraph *graph);
+
+/* Packed index of (i, j) in either order */
+size_t symmetric_graph_index(int vertices, int i, int j);
+
+/* Edge management functions (parallel edges keep the lighter weight) */
+ReturnCode symmetric_graph_add_edge(SymmetricGraph *graph, int u, int v, double weight);
+double symmetric_graph_get_edge(const SymmetricGraph *graph, int u, int v);
+bool symmetric_graph_has_edge(const SymmetricGraph *graph, int u, int v);
+
+/* Graph utility functions */
+ReturnCode symmetric_graph_validate(const SymmetricGraph *graph);
+void symmetric_graph_print(const SymmetricGraph *graph);
+void symmetric_graph_print_distances(const SymmetricGraph *graph);
+
+#endif /* SYMMETRIC_GRAPH_H */
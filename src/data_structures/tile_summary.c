@@ -0,0 +1,115 @@
+#include "tile_summary.h"
+#include <stdlib.h>
+
+TileSummary* tile_summary_create(const Graph *graph, int tile_size) {
+    if (!graph || !graph->is_initialized || tile_size <= 0) {
+        return NULL;
+    }
+
+    TileSummary *summary = (TileSummary*)malloc(sizeof(TileSummary));
+    if (!summary) {
+        return NULL;
+    }
+
+    summary->vertices = graph->vertices;
+    summary->tile_size = tile_size;
+    summary->tiles_per_side = (graph->vertices + tile_size - 1) / tile_size;
+    summary->tiles = (TileInfo*)malloc((size_t)summary->tiles_per_side *
+                                       (size_t)summary->tiles_per_side * sizeof(TileInfo));
+    if (!summary->tiles) {
+        free(summary);
+        return NULL;
+    }
+
+    tile_summary_rebuild(summary, graph);
+    return summary;
+}
+
+void tile_summary_destroy(TileSummary *summary) {
+    if (!summary) {
+        return;
+    }
+
+    free(summary->tiles);
+    free(summary);
+}
+
+void tile_summary_refresh(TileSummary *summary, const Graph *graph, int tile_row, int tile_col) {
+    if (!summary || !graph) {
+        return;
+    }
+
+    int row_start = tile_row * summary->tile_size;
+    int col_start = tile_col * summary->tile_size;
+    int row_end = row_start + summary->tile_size < summary->vertices ? row_start + summary->tile_size : summary->vertices;
+    int col_end = col_start + summary->tile_size < summary->vertices ? col_start + summary->tile_size : summary->vertices;
+
+    TileInfo *info = &summary->tiles[tile_row * summary->tiles_per_side + tile_col];
+    info->finite_count = 0;
+    info->cell_count = (row_end - row_start) * (col_end - col_start);
+    info->min_value = INFINITY_VALUE;
+    info->max_value = -INFINITY_VALUE;
+
+    for (int i = row_start; i < row_end; i++) {
+        const double *row = graph->distance[i];
+        for (int j = col_start; j < col_end; j++) {
+            double value = row[j];
+            if (value < INFINITY_VALUE) {
+                info->finite_count++;
+                if (value < info->min_value) {
+                    info->min_value = value;
+                }
+                if (value > info->max_value) {
+                    info->max_value = value;
+                }
+            }
+        }
+    }
+
+    info->all_infinite = info->finite_count == 0;
+}
+
+/* Recompute every tile, e.g. after new weights were loaded into the same matrices */
+void tile_summary_rebuild(TileSummary *summary, const Graph *graph) {
+    if (!summary || !graph) {
+        return;
+    }
+
+    for (int tr = 0; tr < summary->tiles_per_side; tr++) {
+        for (int tc = 0; tc < summary->tiles_per_side; tc++) {
+            tile_summary_refresh(summary, graph, tr, tc);
+        }
+    }
+}
+
+const TileInfo* tile_summary_get(const TileSummary *summary, int tile_row, int tile_col) {
+    if (!summary || tile_row < 0 || tile_row >= summary->tiles_per_side ||
+        tile_col < 0 || tile_col >= summary->tiles_per_side) {
+        return NULL;
+    }
+
+    return &summary->tiles[tile_row * summary->tiles_per_side + tile_col];
+}
+
+bool tile_summary_can_improve(const TileSummary *summary, int tile_row, int tile_col, int pivot_tile) {
+    const TileInfo *column_tile = tile_summary_get(summary, tile_row, pivot_tile);
+    const TileInfo *row_tile = tile_summary_get(summary, pivot_tile, tile_col);
+    const TileInfo *target = tile_summary_get(summary, tile_row, tile_col);
+
+    if (!column_tile || !row_tile || !target) {
+        return true;
+    }
+
+    /* Every candidate d[i][k] + d[k][j] needs both halves finite */
+    if (column_tile->all_infinite || row_tile->all_infinite) {
+        return false;
+    }
+
+    /* A fully finite target already below every candidate cannot change */
+    if (target->finite_count == target->cell_count &&
+        column_tile->min_value + row_tile->min_value >= target->max_value) {
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,35 @@
+#ifndef TILE_SUMMARY_H
+#define TILE_SUMMARY_H
+
+#include "graph.h"
+
+/* Summary of one square tile of the distance matrix */
+typedef struct {
+    bool all_infinite;      /* No finite entry in the tile */
+    int finite_count;       /* Number of finite entries */
+    int cell_count;         /* Number of entries (edge tiles may be partial) */
+    double min_value;       /* Smallest finite entry (undefined if all_infinite) */
+    double max_value;       /* Largest finite entry (undefined if all_infinite) */
+} TileInfo;
+
+/* Per-tile metadata kept alongside a graph's distance matrix */
+typedef struct {
+    int vertices;           /* Vertex count of the summarized graph */
+    int tile_size;          /* Tile edge length in vertices */
+    int tiles_per_side;     /* ceil(vertices / tile_size) */
+    TileInfo *tiles;        /* tiles_per_side x tiles_per_side, row-major */
+} TileSummary;
+
+/* Creation and destruction functions */
+TileSummary* tile_summary_create(const Graph *graph, int tile_size);
+void tile_summary_destroy(TileSummary *summary);
+
+/* Maintenance functions */
+void tile_summary_refresh(TileSummary *summary, const Graph *graph, int tile_row, int tile_col);
+void tile_summary_rebuild(TileSummary *summary, const Graph *graph);
+const TileInfo* tile_summary_get(const TileSummary *summary, int tile_row, int tile_col);
+
+/* True unless the metadata proves tile (row, col) cannot improve through pivot tile */
+bool tile_summary_can_improve(const TileSummary *summary, int tile_row, int tile_col, int pivot_tile);
+
+#endif /* TILE_SUMMARY_H */
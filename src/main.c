@@ -1,9 +1,12 @@
 #include "core/floyd_warshall.h"
+#include "core/transitive_closure.h"
 #include "utils/file_io.h"
 #include "utils/memory_manager.h"
+#include "utils/trace.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <signal.h>
 
 void print_usage(const char *program_name) {
     printf("Usage: %s [options] <graph_file>\n", program_name);
@@ -13,9 +16,32 @@ void print_usage(const char *program_name) {
     printf("  -o <file>         Save results to file\n");
     printf("  -p <start> <end>  Show specific path\n");
     printf("  -s                Use optimized algorithm\n");
+    printf("  -e <engine>       Select engine:");
+    for (int e = 0; e < FW_ENGINE_COUNT; e++) {
+        printf(" %s", floyd_warshall_engine_name((FloydWarshallEngine)e));
+    }
+    printf("\n");
     printf("  -m                Show memory statistics\n");
+    printf("  -t <file>         Write phase trace (Chrome trace_event JSON)\n");
+    printf("  -r                Reachability only (bit-parallel transitive closure)\n");
+    printf("  -c                Only check for a negative cycle (stops at the first one)\n");
+    printf("  -u                Treat the graph as undirected (packed symmetric kernel)\n");
+    printf("  -P <processes>    Distributed run on a 2D grid of worker processes\n");
+    printf("  -T <transport>    Transport between workers: shm (default), tcp\n");
+    printf("  --checkpoint <file>            Checkpoint the standard engine to <file>\n");
+    printf("  --checkpoint-interval <sec>    Time between checkpoints (default %.0f)\n", FW_CHECKPOINT_INTERVAL);
+    printf("  --resume                       Continue from the checkpoint file if it is valid\n");
+    printf("  --progress                     Report pivots done, relaxations/s and ETA on stderr\n");
+    printf("  --reduce                       Contract leaf and chain vertices, solve the core, expand\n");
+    printf("  --reorder <order>              Renumber vertices for locality before compute:");
+    for (int s = 0; s < VERTEX_ORDER_COUNT; s++) {
+        printf(" %s", vertex_order_strategy_name((VertexOrderStrategy)s));
+    }
+    printf("\n");
+    printf("  (SIGINT/SIGTERM stop the run at the next pivot boundary; exit code 3)\n");
+    printf("  (a file starting with \"batch <count> <vertices>\" is solved as a batch of graphs)\n");
     printf("\nGraph file format:\n");
-    printf("  Line 1: number_of_vertices\n");
+    printf("  Line 1: number_of_vertices [undirected]\n");
     printf("  Line 2: number_of_edges\n");
     printf("  Following lines: from_vertex to_vertex weight\n");
     printf("\nExample:\n");
@@ -23,6 +49,291 @@ void print_usage(const char *program_name) {
     printf("  %s -p 0 3 graph.txt\n", program_name);
 }
 
+/* Run being executed, cancelled by SIGINT/SIGTERM */
+static ExecutionContext *interrupt_context = NULL;
+
+/*
+ * The first signal asks the engine to stop at its next boundary; it gets the
+ * default action back, so a second one terminates runs that do not poll
+ * (small kernels, or a component or repair pass that is still running).
+ */
+static void handle_interrupt(int signal_number) {
+    execution_context_cancel(interrupt_context);
+    signal(signal_number, SIG_DFL);
+}
+
+static void print_progress(const ExecutionProgress *progress, void *user_data) {
+    (void)user_data;
+    fprintf(stderr, "\rPivot %d/%d  %.3e relaxations/s  ", progress->pivots_done, progress->pivots_total,
+            progress->relaxations_per_second);
+    if (progress->eta_seconds >= 0.0) {
+        fprintf(stderr, "ETA %.1f s   ", progress->eta_seconds);
+    }
+    if (progress->pivots_done == progress->pivots_total) {
+        fprintf(stderr, "\n");
+    }
+}
+
+/* Write the collected trace, if tracing was requested, and release its buffers */
+static void finish_trace(const char *trace_file) {
+    if (!trace_file) {
+        return;
+    }
+
+    if (trace_write_chrome_json(trace_file) == SUCCESS) {
+        printf("Trace saved to: %s\n", trace_file);
+    } else {
+        printf("Error: Failed to save trace to: %s\n", trace_file);
+    }
+    trace_disable();
+}
+
+/* Reachability-only mode: answers "can i reach j" without computing distances */
+static int run_reachability(const char *input_file, bool verbose, const char *output_file,
+                            int path_start, int path_end) {
+    if (verbose) {
+        printf("Loading graph from file: %s\n", input_file);
+    }
+
+    /* Edges go straight into the bitsets; the dense matrices are never built */
+    TRACE_BEGIN(load_span);
+    ReachabilityMatrix *matrix = load_reachability_from_file(input_file);
+    TRACE_END(load_span, "load_reachability_from_file", "phase", NULL, TRACE_NO_ARG);
+    if (!matrix) {
+        printf("Error: Failed to load graph from file: %s\n", input_file);
+        return 1;
+    }
+
+    if (verbose) {
+        printf("Graph loaded successfully: %d vertices\n", matrix->vertices);
+    }
+
+    if (path_start >= 0 || path_end >= 0) {
+        if (path_start < 0 || path_start >= matrix->vertices ||
+            path_end < 0 || path_end >= matrix->vertices) {
+            printf("Error: Invalid path vertices. Valid range: 0-%d\n", matrix->vertices - 1);
+            reachability_destroy(matrix);
+            return 1;
+        }
+    }
+
+    if (verbose) {
+        printf("Executing bit-parallel transitive closure...\n");
+    }
+
+    TRACE_BEGIN(compute_span);
+    TransitiveClosureResult result = transitive_closure_execute(matrix);
+    TRACE_END(compute_span, "compute", "phase", NULL, TRACE_NO_ARG);
+
+    if (!result.success) {
+        printf("Error: Transitive closure failed\n");
+        reachability_destroy(matrix);
+        return 1;
+    }
+
+    if (verbose || (!output_file && path_start < 0)) {
+        printf("=== Transitive Closure Execution Result ===\n");
+        printf("Execution time: %.6f seconds\n", result.execution_time);
+        printf("Reachable pairs: %lld of %lld\n\n", result.reachable_pairs,
+               (long long)matrix->vertices * matrix->vertices);
+    }
+
+    if (verbose && path_start < 0) {
+        reachability_print(matrix);
+    }
+
+    if (path_start >= 0 && path_end >= 0) {
+        printf("Vertex %d can reach %d: %s\n", path_start, path_end,
+               reachability_is_reachable(matrix, path_start, path_end) ? "Yes" : "No");
+    }
+
+    if (output_file) {
+        TRACE_BEGIN(save_span);
+        ReturnCode saved = save_reachability_to_file(matrix, output_file);
+        TRACE_END(save_span, "save_reachability_to_file", "phase", NULL, TRACE_NO_ARG);
+        if (saved == SUCCESS) {
+            printf("Results saved to: %s\n", output_file);
+        } else {
+            printf("Error: Failed to save results to: %s\n", output_file);
+        }
+    }
+
+    reachability_destroy(matrix);
+    return 0;
+}
+
+/*
+ * Undirected mode: the graph is loaded into packed triangular storage and
+ * solved by the symmetric kernel; -e does not apply here.
+ */
+static int run_undirected(const char *input_file, bool verbose, const char *output_file,
+                          int path_start, int path_end) {
+    if (verbose) {
+        printf("Loading undirected graph from file: %s\n", input_file);
+    }
+
+    TRACE_BEGIN(load_span);
+    SymmetricGraph *graph = load_symmetric_graph_from_file(input_file);
+    TRACE_END(load_span, "load_symmetric_graph_from_file", "phase", NULL, TRACE_NO_ARG);
+    if (!graph) {
+        printf("Error: Failed to load graph from file: %s\n", input_file);
+        return 1;
+    }
+
+    if (verbose) {
+        printf("Graph loaded successfully: %d vertices\n", graph->vertices);
+        printf("Initial graph:\n");
+        symmetric_graph_print(graph);
+    }
+
+    if (path_start >= 0 || path_end >= 0) {
+        if (path_start < 0 || path_start >= graph->vertices ||
+            path_end < 0 || path_end >= graph->vertices) {
+            printf("Error: Invalid path vertices. Valid range: 0-%d\n", graph->vertices - 1);
+            symmetric_graph_destroy(graph);
+            return 1;
+        }
+    }
+
+    if (verbose) {
+        printf("Executing symmetric Floyd-Warshall algorithm...\n");
+    }
+
+    TRACE_BEGIN(compute_span);
+    FloydWarshallResult result = floyd_warshall_execute_symmetric(graph);
+    TRACE_END(compute_span, "compute", "phase", NULL, TRACE_NO_ARG);
+
+    if (!result.success) {
+        printf("Error: Algorithm execution failed\n");
+        symmetric_graph_destroy(graph);
+        return 1;
+    }
+
+    if (verbose || (!output_file && path_start < 0)) {
+        floyd_warshall_print_result(&result);
+    }
+
+    if (result.has_negative_cycle) {
+        /* Any negative undirected edge u -- v is the cycle u -> v -> u */
+        printf("Warning: Negative cycle detected in the graph.\n");
+        printf("Negative cycle involves vertex %d\n", result.negative_cycle_vertex);
+    } else {
+        if (verbose && path_start < 0) {
+            symmetric_graph_print_distances(graph);
+        }
+
+        if (path_start >= 0 && path_end >= 0) {
+            floyd_warshall_print_path_symmetric(graph, path_start, path_end);
+        }
+
+        if (output_file) {
+            TRACE_BEGIN(save_span);
+            ReturnCode saved = save_symmetric_result_to_file(graph, output_file);
+            TRACE_END(save_span, "save_symmetric_result_to_file", "phase", NULL, TRACE_NO_ARG);
+            if (saved == SUCCESS) {
+                printf("Results saved to: %s\n", output_file);
+            } else {
+                printf("Error: Failed to save results to: %s\n", output_file);
+            }
+        }
+    }
+
+    symmetric_graph_destroy(graph);
+    return 0;
+}
+
+/*
+ * Batch mode: every graph of a multi-graph file is solved by the interleaved
+ * batch kernel; -p shows the path in each graph.
+ */
+static int run_batch(const char *input_file, bool verbose, const char *output_file,
+                     int path_start, int path_end) {
+    if (verbose) {
+        printf("Loading graph batch from file: %s\n", input_file);
+    }
+
+    TRACE_BEGIN(load_span);
+    GraphBatch *batch = load_graph_batch_from_file(input_file);
+    TRACE_END(load_span, "load_graph_batch_from_file", "phase", NULL, TRACE_NO_ARG);
+    if (!batch) {
+        printf("Error: Failed to load graph batch from file: %s\n", input_file);
+        return 1;
+    }
+
+    if (path_start >= 0 || path_end >= 0) {
+        if (path_start < 0 || path_start >= batch->vertices ||
+            path_end < 0 || path_end >= batch->vertices) {
+            printf("Error: Invalid path vertices. Valid range: 0-%d\n", batch->vertices - 1);
+            graph_batch_destroy(batch);
+            return 1;
+        }
+    }
+
+    if (verbose) {
+        printf("Executing batched Floyd-Warshall on %d graphs of %d vertices...\n",
+               batch->count, batch->vertices);
+    }
+
+    TRACE_BEGIN(compute_span);
+    FloydWarshallBatchResult result = floyd_warshall_execute_batch(batch);
+    TRACE_END(compute_span, "compute", "phase", NULL, TRACE_NO_ARG);
+
+    if (!result.success) {
+        printf("Error: Algorithm execution failed\n");
+        graph_batch_destroy(batch);
+        return 1;
+    }
+
+    printf("=== Batch Execution Result ===\n");
+    printf("Graphs: %d (%d vertices each)\n", batch->count, batch->vertices);
+    printf("Execution time: %.6f seconds\n", result.execution_time);
+    printf("Throughput: %.0f graphs/second\n", result.graphs_per_second);
+    printf("Graphs with a negative cycle: %d\n\n", result.negative_cycle_graphs);
+
+    for (int g = 0; g < batch->count; g++) {
+        if (batch->negative_cycle[g]) {
+            if (verbose) {
+                printf("Graph %d: negative cycle detected\n", g);
+            }
+            continue;
+        }
+
+        if (verbose && path_start < 0) {
+            graph_batch_print_distances(batch, g);
+        }
+
+        if (path_start >= 0 && path_end >= 0) {
+            printf("Graph %d: ", g);
+            int path_length;
+            int *path = floyd_warshall_get_path_batch(batch, g, path_start, path_end, &path_length);
+            if (!path) {
+                printf("No path from %d to %d\n", path_start, path_end);
+                continue;
+            }
+
+            printf("%.2f via ", graph_batch_get_distance(batch, g, path_start, path_end));
+            for (int i = 0; i < path_length; i++) {
+                printf("%d%s", path[i], i < path_length - 1 ? " -> " : "\n");
+            }
+            free(path);
+        }
+    }
+
+    if (output_file) {
+        TRACE_BEGIN(save_span);
+        ReturnCode saved = save_batch_result_to_file(batch, output_file);
+        TRACE_END(save_span, "save_batch_result_to_file", "phase", NULL, TRACE_NO_ARG);
+        if (saved == SUCCESS) {
+            printf("Results saved to: %s\n", output_file);
+        } else {
+            printf("Error: Failed to save results to: %s\n", output_file);
+        }
+    }
+
+    graph_batch_destroy(batch);
+    return 0;
+}
+
 int main(int argc, char *argv[]) {
     if (argc < 2) {
         print_usage(argv[0]);
@@ -32,9 +343,22 @@ int main(int argc, char *argv[]) {
     /* Command line argument variables */
     bool verbose = false;
     bool show_memory = false;
-    bool use_optimized = false;
+    bool reachability_only = false;
+    bool cycle_check_only = false;
+    bool force_undirected = false;
+    FloydWarshallEngine engine = FW_ENGINE_STANDARD;
+    bool engine_selected = false;
+    int processes = 0;
+    TransportKind transport = TRANSPORT_SHM;
+    char *checkpoint_file = NULL;
+    double checkpoint_interval = FW_CHECKPOINT_INTERVAL;
+    bool resume = false;
+    bool show_progress = false;
+    bool reduce = false;
+    VertexOrderStrategy reorder = VERTEX_ORDER_COUNT;
     char *input_file = NULL;
     char *output_file = NULL;
+    char *trace_file = NULL;
     int path_start = -1, path_end = -1;
 
     /* Parse command line arguments */
@@ -46,10 +370,61 @@ int main(int argc, char *argv[]) {
             verbose = true;
         } else if (strcmp(argv[i], "-m") == 0) {
             show_memory = true;
+        } else if (strcmp(argv[i], "-r") == 0) {
+            reachability_only = true;
+        } else if (strcmp(argv[i], "-c") == 0) {
+            cycle_check_only = true;
+        } else if (strcmp(argv[i], "-u") == 0) {
+            force_undirected = true;
         } else if (strcmp(argv[i], "-s") == 0) {
-            use_optimized = true;
+            engine = FW_ENGINE_OPTIMIZED;
+            engine_selected = true;
+        } else if (strcmp(argv[i], "-e") == 0 && i + 1 < argc) {
+            engine = floyd_warshall_engine_from_name(argv[++i]);
+            if (engine == FW_ENGINE_COUNT) {
+                printf("Error: Unknown engine '%s'\n", argv[i]);
+                print_usage(argv[0]);
+                return 1;
+            }
+            engine_selected = true;
+        } else if (strcmp(argv[i], "-P") == 0 && i + 1 < argc) {
+            processes = atoi(argv[++i]);
+            if (processes < 1 || processes > FW_DISTRIBUTED_MAX_PROCESSES) {
+                printf("Error: Process count must be in 1-%d\n", FW_DISTRIBUTED_MAX_PROCESSES);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-T") == 0 && i + 1 < argc) {
+            transport = transport_kind_from_name(argv[++i]);
+            if (transport == TRANSPORT_COUNT) {
+                printf("Error: Unknown transport '%s'\n", argv[i]);
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc) {
+            checkpoint_file = argv[++i];
+        } else if (strcmp(argv[i], "--checkpoint-interval") == 0 && i + 1 < argc) {
+            checkpoint_interval = atof(argv[++i]);
+            if (checkpoint_interval <= 0.0) {
+                printf("Error: Checkpoint interval must be positive\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--resume") == 0) {
+            resume = true;
+        } else if (strcmp(argv[i], "--progress") == 0) {
+            show_progress = true;
+        } else if (strcmp(argv[i], "--reduce") == 0) {
+            reduce = true;
+        } else if (strcmp(argv[i], "--reorder") == 0 && i + 1 < argc) {
+            reorder = vertex_order_strategy_from_name(argv[++i]);
+            if (reorder == VERTEX_ORDER_COUNT) {
+                printf("Error: Unknown vertex order '%s'\n", argv[i]);
+                print_usage(argv[0]);
+                return 1;
+            }
         } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
             output_file = argv[++i];
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            trace_file = argv[++i];
         } else if (strcmp(argv[i], "-p") == 0 && i + 2 < argc) {
             path_start = atoi(argv[++i]);
             path_end = atoi(argv[++i]);
@@ -68,25 +443,91 @@ int main(int argc, char *argv[]) {
         return 1;
     }
 
+    /* Checkpoints cover the standard engine only */
+    if (resume && !checkpoint_file) {
+        printf("Error: --resume needs --checkpoint <file>\n");
+        return 1;
+    }
+    if (checkpoint_file && (engine != FW_ENGINE_STANDARD || processes > 0 || cycle_check_only ||
+                            reachability_only || force_undirected)) {
+        printf("Error: Checkpointing is only supported with the standard engine\n");
+        return 1;
+    }
+    if (reduce && (checkpoint_file || processes > 0 || cycle_check_only || reachability_only || force_undirected)) {
+        printf("Error: --reduce cannot be combined with -c, -r, -u, -P or checkpoints\n");
+        return 1;
+    }
+    if (reorder != VERTEX_ORDER_COUNT && (reduce || checkpoint_file || processes > 0 || cycle_check_only ||
+                                          reachability_only || force_undirected)) {
+        printf("Error: --reorder cannot be combined with --reduce, -c, -r, -u, -P or checkpoints\n");
+        return 1;
+    }
+
     /* Initialize memory tracking */
     if (show_memory) {
         reset_memory_tracking();
     }
 
+    /* Start tracing before the first phase */
+    if (trace_file && trace_enable(TRACE_DEFAULT_CAPACITY) != SUCCESS) {
+        printf("Error: Failed to allocate trace buffers\n");
+        return 1;
+    }
+
+    /* Multi-graph files bypass the single-graph pipeline */
+    if (is_graph_batch_file(input_file)) {
+        int status = run_batch(input_file, verbose, output_file, path_start, path_end);
+        if (show_memory) {
+            print_memory_stats();
+        }
+        finish_trace(trace_file);
+        return status;
+    }
+
     /* Validate input file */
-    if (validate_graph_file(input_file) != SUCCESS) {
+    TRACE_BEGIN(validate_span);
+    ReturnCode validation = validate_graph_file(input_file);
+    TRACE_END(validate_span, "validate_graph_file", "phase", NULL, TRACE_NO_ARG);
+    if (validation != SUCCESS) {
         printf("Error: Invalid graph file format: %s\n", input_file);
+        trace_disable();
         return 1;
     }
 
+    /* Reachability reads the file into bitsets; undirected edges set both directions */
+    if (reachability_only) {
+        int status = run_reachability(input_file, verbose, output_file, path_start, path_end);
+        if (show_memory) {
+            print_memory_stats();
+        }
+        finish_trace(trace_file);
+        return status;
+    }
+
+    /* Undirected graphs run on packed storage */
+    if (force_undirected || is_undirected_graph_file(input_file)) {
+        int status = run_undirected(input_file, verbose, output_file, path_start, path_end);
+        if (show_memory) {
+            print_memory_stats();
+        }
+        finish_trace(trace_file);
+        if (status == 0 && verbose) {
+            printf("Program completed successfully.\n");
+        }
+        return status;
+    }
+
     /* Load graph from file */
     if (verbose) {
         printf("Loading graph from file: %s\n", input_file);
     }
 
+    TRACE_BEGIN(load_span);
     Graph *graph = load_graph_from_file(input_file);
+    TRACE_END(load_span, "load_graph_from_file", "phase", NULL, TRACE_NO_ARG);
     if (!graph) {
         printf("Error: Failed to load graph from file: %s\n", input_file);
+        trace_disable();
         return 1;
     }
 
@@ -102,30 +543,207 @@ int main(int argc, char *argv[]) {
             path_end < 0 || path_end >= graph->vertices) {
             printf("Error: Invalid path vertices. Valid range: 0-%d\n", graph->vertices - 1);
             graph_destroy(graph);
+            trace_disable();
+            return 1;
+        }
+    }
+
+    /* Continue a previous run: the checkpoint replaces the freshly loaded graph */
+    CheckpointConfig checkpoint = {checkpoint_file, 0, checkpoint_interval, 0, 0};
+    if (checkpoint_file) {
+        checkpoint.input_hash = checkpoint_input_hash(graph);
+    }
+    if (resume) {
+        int next_pivot = 0;
+        uint64_t saved_hash = 0;
+        Graph *saved = load_checkpoint_from_file(checkpoint_file, &next_pivot, &saved_hash);
+        if (!saved) {
+            printf("No valid checkpoint in %s, starting from the beginning\n", checkpoint_file);
+        } else if (saved->vertices != graph->vertices) {
+            printf("Error: Checkpoint has %d vertices, graph has %d\n", saved->vertices, graph->vertices);
+            graph_destroy(saved);
+            graph_destroy(graph);
+            trace_disable();
             return 1;
+        } else if (saved_hash != checkpoint.input_hash) {
+            printf("Error: Checkpoint %s was written for a different input graph\n", checkpoint_file);
+            graph_destroy(saved);
+            graph_destroy(graph);
+            trace_disable();
+            return 1;
+        } else {
+            printf("Resuming from checkpoint %s at pivot %d of %d\n", checkpoint_file, next_pivot, graph->vertices);
+            graph_destroy(graph);
+            graph = saved;
+            checkpoint.start_pivot = next_pivot;
+        }
+    }
+
+    /* Unless an engine was chosen, the library's policy picks one */
+    if (!engine_selected && !checkpoint_file && processes == 0 && !cycle_check_only) {
+        char reason[128];
+        engine = floyd_warshall_select_engine(graph, reason, sizeof(reason));
+        if (verbose && reason[0]) {
+            printf("%s\n", reason);
+        }
+    }
+
+    /* Leaf and chain vertices are contracted away; the engine solves the core */
+    GraphReduction *reduction = NULL;
+    if (reduce) {
+        TRACE_BEGIN(reduce_span);
+        reduction = reduction_create(graph);
+        TRACE_END(reduce_span, "reduction_create", "phase", NULL, TRACE_NO_ARG);
+        if (!reduction) {
+            printf("Error: Failed to reduce the graph\n");
+            graph_destroy(graph);
+            trace_disable();
+            return 1;
+        }
+        if (verbose) {
+            printf("Reduced graph: %d of %d vertices remain (%d leaves, %d chain vertices, %d isolated removed; "
+                   "%d dominated edges dropped)\n", reduction->core->vertices, graph->vertices,
+                   reduction->leaves, reduction->chains, reduction->isolated, reduction->dominated_edges);
+        }
+    }
+
+    /* Compute runs in the permuted numbering; results come back in the file's */
+    VertexOrder *order = NULL;
+    if (reorder != VERTEX_ORDER_COUNT) {
+        TRACE_BEGIN(reorder_span);
+        order = vertex_order_create(graph, reorder);
+        TRACE_END(reorder_span, "vertex_order_create", "phase", NULL, TRACE_NO_ARG);
+        if (!order) {
+            printf("Error: Failed to reorder the graph\n");
+            graph_destroy(graph);
+            trace_disable();
+            return 1;
+        }
+        if (verbose) {
+            printf("Vertices renumbered in %s order\n", vertex_order_strategy_name(reorder));
         }
     }
 
     /* Execute Floyd-Warshall algorithm */
-    if (verbose) {
+    if (verbose && processes > 0) {
+        printf("Executing distributed Floyd-Warshall algorithm (%d processes, %s transport)...\n",
+               processes, transport_kind_name(transport));
+    } else if (verbose) {
         printf("Executing %s Floyd-Warshall algorithm...\n",
-               use_optimized ? "optimized" : "standard");
+               floyd_warshall_engine_name(engine));
     }
 
+    /*
+     * The reference kernel (also the integer kernel's fallback) watches for
+     * the first negative cycle as it runs; other engines get the -inf pairs
+     * marked from their final matrix.
+     */
     FloydWarshallResult result;
-    if (use_optimized) {
-        result = floyd_warshall_execute_optimized(graph);
+    NegativeCycleInfo cycle_info;
+    negative_cycle_info_init(&cycle_info);
+    ExecutionContext context;
+    execution_context_init(&context, show_progress ? print_progress : NULL, NULL, FW_PROGRESS_INTERVAL_MS);
+    interrupt_context = &context;
+    signal(SIGINT, handle_interrupt);
+    signal(SIGTERM, handle_interrupt);
+
+    TRACE_BEGIN(compute_span);
+    execution_begin(&context);
+    context.pivots_total = graph->vertices;
+    if (cycle_check_only) {
+        result = floyd_warshall_execute_checked(graph, FW_NEGATIVE_CYCLE_ABORT, &cycle_info);
+    } else if (processes > 0) {
+        result = floyd_warshall_execute_distributed(graph, processes, transport);
+        if (result.success && result.has_negative_cycle) {
+            negative_cycle_mark_unbounded(graph, &cycle_info);
+        }
+    } else if (checkpoint_file) {
+        int checkpoints_written = 0;
+        result = floyd_warshall_execute_checkpointed(graph, &checkpoint, &checkpoints_written);
+        if (result.success && result.has_negative_cycle) {
+            negative_cycle_mark_unbounded(graph, &cycle_info);
+        }
+        if (verbose) {
+            printf("Checkpoints written: %d\n", checkpoints_written);
+        }
+    } else if (reduction) {
+        result = floyd_warshall_execute_reduced(graph, reduction, engine);
+        if (result.success && result.has_negative_cycle) {
+            negative_cycle_mark_unbounded(graph, &cycle_info);
+        }
+    } else if (order) {
+        result = floyd_warshall_execute_reordered(graph, order, engine);
+        if (result.success && result.has_negative_cycle) {
+            negative_cycle_mark_unbounded(graph, &cycle_info);
+        }
+    } else if (engine == FW_ENGINE_STANDARD) {
+        result = floyd_warshall_execute_checked(graph, FW_NEGATIVE_CYCLE_COMPLETE, &cycle_info);
+    } else if (engine == FW_ENGINE_INTEGER) {
+        result = floyd_warshall_execute_integer_checked(graph, &cycle_info);
     } else {
-        result = floyd_warshall_execute(graph);
+        /*
+         * An automatically chosen engine still reports the cycle the reference
+         * kernel would (dag and bfs graphs cannot have one, so no copy there)
+         */
+        bool keep_input = !engine_selected && engine != FW_ENGINE_DAG && engine != FW_ENGINE_BFS;
+        Graph *pristine = keep_input ? graph_copy(graph) : NULL;
+        result = floyd_warshall_execute_engine(graph, engine);
+        if (result.success && result.has_negative_cycle && pristine) {
+            graph_destroy(graph);
+            graph = pristine;
+            pristine = NULL;
+            result = floyd_warshall_execute_checked(graph, FW_NEGATIVE_CYCLE_COMPLETE, &cycle_info);
+        } else if (result.success && result.has_negative_cycle) {
+            negative_cycle_mark_unbounded(graph, &cycle_info);
+        }
+        graph_destroy(pristine);
     }
+    execution_end(&context, result.success, result.iterations);
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+    TRACE_END(compute_span, "compute", "phase", NULL, TRACE_NO_ARG);
+    reduction_destroy(reduction);
+    vertex_order_destroy(order);
 
     /* Check execution result */
     if (!result.success) {
         printf("Error: Algorithm execution failed\n");
+        negative_cycle_info_free(&cycle_info);
         graph_destroy(graph);
+        trace_disable();
         return 1;
     }
 
+    /* Partial matrices are not shortest paths; only a checkpoint keeps the work */
+    if (context.status == EXECUTION_CANCELLED) {
+        if (show_progress) {
+            fprintf(stderr, "\n");
+        }
+        printf("Execution cancelled after %d of %d pivots\n", context.pivots_done, context.pivots_total);
+        if (checkpoint_file) {
+            printf("Checkpoint saved to %s; continue with --resume\n", checkpoint_file);
+        }
+        negative_cycle_info_free(&cycle_info);
+        finish_trace(trace_file);
+        graph_destroy(graph);
+        return 3;
+    }
+
+    if (cycle_check_only) {
+        printf("Negative cycle: %s\n", result.has_negative_cycle ? "Yes" : "No");
+        if (result.has_negative_cycle) {
+            negative_cycle_print(&cycle_info);
+        }
+        if (verbose) {
+            printf("Pivots examined: %d of %d\n", result.iterations / (graph->vertices * graph->vertices),
+                   graph->vertices);
+        }
+        negative_cycle_info_free(&cycle_info);
+        finish_trace(trace_file);
+        graph_destroy(graph);
+        return result.has_negative_cycle ? 2 : 0;
+    }
+
     /* Print results */
     if (verbose || (!output_file && path_start < 0)) {
         floyd_warshall_print_result(&result);
@@ -136,6 +754,7 @@ int main(int argc, char *argv[]) {
         if (result.negative_cycle_vertex >= 0) {
             printf("Negative cycle involves vertex %d\n", result.negative_cycle_vertex);
         }
+        negative_cycle_print(&cycle_info);
     } else {
         /* Show distance matrix if verbose or no specific output requested */
         if (verbose && path_start < 0) {
@@ -149,7 +768,10 @@ int main(int argc, char *argv[]) {
 
         /* Save results to file if requested */
         if (output_file) {
-            if (save_result_to_file(graph, output_file) == SUCCESS) {
+            TRACE_BEGIN(save_span);
+            ReturnCode saved = save_result_to_file(graph, output_file);
+            TRACE_END(save_span, "save_result_to_file", "phase", NULL, TRACE_NO_ARG);
+            if (saved == SUCCESS) {
                 printf("Results saved to: %s\n", output_file);
             } else {
                 printf("Error: Failed to save results to: %s\n", output_file);
@@ -157,12 +779,21 @@ int main(int argc, char *argv[]) {
         }
     }
 
+    /* The run is complete; its checkpoint would only repeat work */
+    if (checkpoint_file) {
+        remove(checkpoint_file);
+    }
+
     /* Show memory statistics if requested */
     if (show_memory) {
         print_memory_stats();
     }
 
+    /* Write trace collected over all phases */
+    finish_trace(trace_file);
+
     /* Clean up */
+    negative_cycle_info_free(&cycle_info);
     graph_destroy(graph);
 
     if (verbose) {
@@ -1,41 +1,62 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include "file_io.h"
 #include "../core/floyd_warshall.h"
+#include "graph_generator.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
+#include <unistd.h>
 
-Graph* load_graph_from_file(const char *filename) {
-    if (!filename) {
-        return NULL;
+/* Number of binary edge records read or written per block */
+#define BINARY_EDGE_BLOCK 4096
+
+/* Receives the contents of a graph file: begin() once with the header, then every edge */
+typedef struct {
+    ReturnCode (*begin)(void *context, int vertices, bool undirected);
+    ReturnCode (*edge)(void *context, int from, int to, double weight);
+    void *context;
+} EdgeSink;
+
+/*
+ * Text header: vertex count, an optional "directed"/"undirected" keyword on
+ * the same line, then the edge count.
+ */
+static ReturnCode read_text_graph_header(FILE *file, int *vertices, int *edges, bool *undirected) {
+    *undirected = false;
+
+    if (fscanf(file, "%d", vertices) != 1 || *vertices <= 0) {
+        return ERROR_INVALID_INPUT;
     }
 
-    FILE *file = fopen(filename, "r");
-    if (!file) {
-        fprintf(stderr, "Error: Cannot open file %s\n", filename);
-        return NULL;
+    char keyword[16];
+    if (fscanf(file, " %15[a-z]", keyword) == 1) {
+        if (strcmp(keyword, "undirected") == 0) {
+            *undirected = true;
+        } else if (strcmp(keyword, "directed") != 0) {
+            return ERROR_INVALID_INPUT;
+        }
     }
 
-    int vertices;
-    if (fscanf(file, "%d", &vertices) != 1 || vertices <= 0) {
-        fprintf(stderr, "Error: Invalid number of vertices in file %s\n", filename);
-        fclose(file);
-        return NULL;
+    if (fscanf(file, "%d", edges) != 1 || *edges < 0) {
+        return ERROR_INVALID_INPUT;
     }
 
-    Graph *graph = graph_create(vertices);
-    if (!graph) {
-        fprintf(stderr, "Error: Failed to create graph\n");
-        fclose(file);
-        return NULL;
+    return SUCCESS;
+}
+
+static ReturnCode read_text_graph(FILE *file, const char *filename, const EdgeSink *sink) {
+    int vertices, edges;
+    bool undirected;
+    if (read_text_graph_header(file, &vertices, &edges, &undirected) != SUCCESS) {
+        fprintf(stderr, "Error: Invalid graph header in file %s\n", filename);
+        return ERROR_INVALID_INPUT;
     }
 
-    int edges;
-    if (fscanf(file, "%d", &edges) != 1 || edges < 0) {
-        fprintf(stderr, "Error: Invalid number of edges in file %s\n", filename);
-        graph_destroy(graph);
-        fclose(file);
-        return NULL;
+    ReturnCode status = sink->begin(sink->context, vertices, undirected);
+    if (status != SUCCESS) {
+        fprintf(stderr, "Error: Failed to create graph\n");
+        return status;
     }
 
     /* Read edges */
@@ -45,23 +66,207 @@ Graph* load_graph_from_file(const char *filename) {
 
         if (fscanf(file, "%d %d %lf", &from, &to, &weight) != 3) {
             fprintf(stderr, "Error: Invalid edge format in file %s at line %d\n", filename, i + 3);
-            graph_destroy(graph);
-            fclose(file);
-            return NULL;
+            return ERROR_INVALID_INPUT;
         }
 
-        if (graph_add_edge(graph, from, to, weight) != SUCCESS) {
+        if (sink->edge(sink->context, from, to, weight) != SUCCESS) {
             fprintf(stderr, "Error: Failed to add edge (%d, %d) with weight %.2f\n", from, to, weight);
-            graph_destroy(graph);
-            fclose(file);
-            return NULL;
+            return ERROR_INVALID_INPUT;
+        }
+    }
+
+    return SUCCESS;
+}
+
+static ReturnCode read_binary_graph(FILE *file, const char *filename, const EdgeSink *sink) {
+    BinaryGraphHeader header;
+    if (read_binary_graph_header(file, &header) != SUCCESS) {
+        fprintf(stderr, "Error: Invalid binary graph header in file %s\n", filename);
+        return ERROR_INVALID_INPUT;
+    }
+
+    ReturnCode status = sink->begin(sink->context, header.vertices,
+                                    (header.flags & GRAPH_BINARY_FLAG_UNDIRECTED) != 0);
+    if (status != SUCCESS) {
+        fprintf(stderr, "Error: Failed to create graph\n");
+        return status;
+    }
+
+    BinaryEdgeRecord records[BINARY_EDGE_BLOCK];
+    int64_t remaining = header.edge_count;
+    while (remaining > 0) {
+        size_t block = remaining < BINARY_EDGE_BLOCK ? (size_t)remaining : BINARY_EDGE_BLOCK;
+        if (fread(records, sizeof(BinaryEdgeRecord), block, file) != block) {
+            fprintf(stderr, "Error: Truncated edge data in file %s\n", filename);
+            return ERROR_FILE_IO;
+        }
+
+        for (size_t e = 0; e < block; e++) {
+            if (sink->edge(sink->context, records[e].from, records[e].to, records[e].weight) != SUCCESS) {
+                fprintf(stderr, "Error: Failed to add edge (%d, %d) with weight %.2f\n",
+                        records[e].from, records[e].to, records[e].weight);
+                return ERROR_INVALID_INPUT;
+            }
         }
+        remaining -= (int64_t)block;
     }
 
+    return SUCCESS;
+}
+
+/* Open a graph file in either format and stream it into sink */
+static ReturnCode read_graph_file(const char *filename, bool binary, const EdgeSink *sink) {
+    FILE *file = fopen(filename, binary ? "rb" : "r");
+    if (!file) {
+        fprintf(stderr, "Error: Cannot open file %s\n", filename);
+        return ERROR_FILE_IO;
+    }
+
+    ReturnCode status = binary ? read_binary_graph(file, filename, sink)
+                               : read_text_graph(file, filename, sink);
     fclose(file);
+    return status;
+}
+
+/* Directed sink: undirected files add every edge in both directions */
+typedef struct {
+    Graph *graph;
+    bool undirected;
+} DirectedLoad;
+
+static ReturnCode directed_begin(void *context, int vertices, bool undirected) {
+    DirectedLoad *load = (DirectedLoad*)context;
+    load->graph = graph_create(vertices);
+    load->undirected = undirected;
+    return load->graph ? SUCCESS : ERROR_MEMORY_ALLOCATION;
+}
+
+/* A repeated edge overwrites the earlier one: the last occurrence in the file wins */
+static ReturnCode directed_edge(void *context, int from, int to, double weight) {
+    DirectedLoad *load = (DirectedLoad*)context;
+    ReturnCode status = graph_add_edge(load->graph, from, to, weight);
+    if (status == SUCCESS && load->undirected && from != to) {
+        status = graph_add_edge(load->graph, to, from, weight);
+    }
+    return status;
+}
+
+static Graph* load_directed_graph(const char *filename, bool binary) {
+    DirectedLoad load = {NULL, false};
+    EdgeSink sink = {directed_begin, directed_edge, &load};
+
+    if (read_graph_file(filename, binary, &sink) != SUCCESS) {
+        graph_destroy(load.graph);
+        return NULL;
+    }
+    return load.graph;
+}
+
+Graph* load_graph_from_file(const char *filename) {
+    if (!filename) {
+        return NULL;
+    }
+
+    return load_directed_graph(filename, is_binary_graph_file(filename));
+}
+
+static ReturnCode symmetric_begin(void *context, int vertices, bool undirected) {
+    (void)undirected;
+    SymmetricGraph **graph = (SymmetricGraph**)context;
+    *graph = symmetric_graph_create(vertices);
+    return *graph ? SUCCESS : ERROR_MEMORY_ALLOCATION;
+}
+
+static ReturnCode symmetric_edge(void *context, int from, int to, double weight) {
+    return symmetric_graph_add_edge(*(SymmetricGraph**)context, from, to, weight);
+}
+
+SymmetricGraph* load_symmetric_graph_from_file(const char *filename) {
+    if (!filename) {
+        return NULL;
+    }
+
+    SymmetricGraph *graph = NULL;
+    EdgeSink sink = {symmetric_begin, symmetric_edge, &graph};
+
+    if (read_graph_file(filename, is_binary_graph_file(filename), &sink) != SUCCESS) {
+        symmetric_graph_destroy(graph);
+        return NULL;
+    }
     return graph;
 }
 
+/* Reachability sink: one bit per edge, same rules as reachability_from_graph on the loaded graph */
+typedef struct {
+    ReachabilityMatrix *matrix;
+    bool undirected;
+} ReachabilityLoad;
+
+static ReturnCode reachability_begin(void *context, int vertices, bool undirected) {
+    ReachabilityLoad *load = (ReachabilityLoad*)context;
+    load->matrix = reachability_create(vertices);
+    load->undirected = undirected;
+    return load->matrix ? SUCCESS : ERROR_MEMORY_ALLOCATION;
+}
+
+static ReturnCode reachability_edge(void *context, int from, int to, double weight) {
+    ReachabilityLoad *load = (ReachabilityLoad*)context;
+    if (from < 0 || from >= load->matrix->vertices || to < 0 || to >= load->matrix->vertices) {
+        return ERROR_INVALID_INPUT;
+    }
+    if (weight >= INFINITY_VALUE) {
+        return SUCCESS;
+    }
+
+    reachability_add_edge(load->matrix, from, to);
+    if (load->undirected) {
+        reachability_add_edge(load->matrix, to, from);
+    }
+    return SUCCESS;
+}
+
+ReachabilityMatrix* load_reachability_from_file(const char *filename) {
+    if (!filename) {
+        return NULL;
+    }
+
+    ReachabilityLoad load = {NULL, false};
+    EdgeSink sink = {reachability_begin, reachability_edge, &load};
+
+    if (read_graph_file(filename, is_binary_graph_file(filename), &sink) != SUCCESS) {
+        reachability_destroy(load.matrix);
+        return NULL;
+    }
+    return load.matrix;
+}
+
+bool is_undirected_graph_file(const char *filename) {
+    if (!filename) {
+        return false;
+    }
+
+    bool binary = is_binary_graph_file(filename);
+    FILE *file = fopen(filename, binary ? "rb" : "r");
+    if (!file) {
+        return false;
+    }
+
+    bool undirected = false;
+    if (binary) {
+        BinaryGraphHeader header;
+        undirected = read_binary_graph_header(file, &header) == SUCCESS &&
+                     (header.flags & GRAPH_BINARY_FLAG_UNDIRECTED) != 0;
+    } else {
+        int vertices, edges;
+        if (read_text_graph_header(file, &vertices, &edges, &undirected) != SUCCESS) {
+            undirected = false;
+        }
+    }
+
+    fclose(file);
+    return undirected;
+}
+
 ReturnCode save_graph_to_file(const Graph *graph, const char *filename) {
     if (!graph || !filename) {
         return ERROR_NULL_POINTER;
@@ -171,6 +376,561 @@ ReturnCode save_result_to_file(const Graph *graph, const char *filename) {
     return SUCCESS;
 }
 
+ReturnCode save_symmetric_graph_to_file(const SymmetricGraph *graph, const char *filename,
+                                        GraphFileFormat format) {
+    if (!graph || !filename) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if (symmetric_graph_validate(graph) != SUCCESS) {
+        return ERROR_INVALID_INPUT;
+    }
+
+    FILE *file = fopen(filename, format == GRAPH_FORMAT_BINARY ? "wb" : "w");
+    if (!file) {
+        return ERROR_FILE_IO;
+    }
+
+    /* Each undirected edge is written once, as (i, j) with i < j */
+    int n = graph->vertices;
+    int64_t edge_count = 0;
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            if (graph->distance[symmetric_graph_index(n, i, j)] < INFINITY_VALUE) {
+                edge_count++;
+            }
+        }
+    }
+
+    bool written = true;
+    if (format == GRAPH_FORMAT_BINARY) {
+        BinaryGraphHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, GRAPH_BINARY_MAGIC, 4);
+        header.version = GRAPH_BINARY_VERSION;
+        header.vertices = n;
+        header.flags = GRAPH_BINARY_FLAG_UNDIRECTED;
+        header.edge_count = edge_count;
+        written = fwrite(&header, sizeof(header), 1, file) == 1;
+    } else {
+        fprintf(file, "%d undirected\n%lld\n", n, (long long)edge_count);
+    }
+
+    for (int i = 0; i < n && written; i++) {
+        for (int j = i + 1; j < n && written; j++) {
+            double weight = graph->distance[symmetric_graph_index(n, i, j)];
+            if (weight >= INFINITY_VALUE) {
+                continue;
+            }
+            if (format == GRAPH_FORMAT_BINARY) {
+                BinaryEdgeRecord record = {i, j, weight};
+                written = fwrite(&record, sizeof(record), 1, file) == 1;
+            } else {
+                fprintf(file, "%d %d %.6f\n", i, j, weight);
+            }
+        }
+    }
+
+    if (fclose(file) != 0 || !written) {
+        return ERROR_FILE_IO;
+    }
+    return SUCCESS;
+}
+
+ReturnCode save_symmetric_result_to_file(const SymmetricGraph *graph, const char *filename) {
+    if (!graph || !filename) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if (!graph->is_initialized) {
+        return ERROR_INVALID_INPUT;
+    }
+
+    FILE *file = fopen(filename, "w");
+    if (!file) {
+        return ERROR_FILE_IO;
+    }
+
+    int n = graph->vertices;
+    fprintf(file, "Floyd-Warshall Algorithm Results\n");
+    fprintf(file, "================================\n\n");
+
+    fprintf(file, "Undirected graph with %d vertices\n\n", n);
+
+    fprintf(file, "Shortest Distance Matrix:\n");
+    fprintf(file, "      ");
+    for (int j = 0; j < n; j++) {
+        fprintf(file, "%8d", j);
+    }
+    fprintf(file, "\n");
+
+    for (int i = 0; i < n; i++) {
+        fprintf(file, "%4d: ", i);
+        for (int j = 0; j < n; j++) {
+            double distance = graph->distance[symmetric_graph_index(n, i, j)];
+            if (distance >= INFINITY_VALUE) {
+                fprintf(file, "     INF");
+            } else {
+                fprintf(file, "%8.2f", distance);
+            }
+        }
+        fprintf(file, "\n");
+    }
+
+    /* A path and its reverse are the same, so each pair is listed once */
+    fprintf(file, "\nPath Information:\n");
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            double distance = graph->distance[symmetric_graph_index(n, i, j)];
+            if (distance >= INFINITY_VALUE) {
+                continue;
+            }
+
+            fprintf(file, "Path between %d and %d (distance: %.2f): ", i, j, distance);
+
+            int path_length;
+            int *path = floyd_warshall_get_path_symmetric(graph, i, j, &path_length);
+            if (path) {
+                for (int k = 0; k < path_length; k++) {
+                    fprintf(file, "%d", path[k]);
+                    if (k < path_length - 1) {
+                        fprintf(file, " -- ");
+                    }
+                }
+                free(path);
+            } else {
+                fprintf(file, "Path reconstruction failed");
+            }
+            fprintf(file, "\n");
+        }
+    }
+
+    fclose(file);
+    return SUCCESS;
+}
+
+/* Batch header: the "batch" keyword, graph count and shared vertex count */
+static ReturnCode read_batch_header(FILE *file, int *count, int *vertices) {
+    char keyword[16];
+    if (fscanf(file, " %15[a-z]", keyword) != 1 || strcmp(keyword, "batch") != 0) {
+        return ERROR_INVALID_INPUT;
+    }
+
+    if (fscanf(file, "%d %d", count, vertices) != 2 || *count <= 0 || *vertices <= 0) {
+        return ERROR_INVALID_INPUT;
+    }
+
+    return SUCCESS;
+}
+
+GraphBatch* load_graph_batch_from_file(const char *filename) {
+    if (!filename) {
+        return NULL;
+    }
+
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        fprintf(stderr, "Error: Cannot open file %s\n", filename);
+        return NULL;
+    }
+
+    int count, vertices;
+    if (read_batch_header(file, &count, &vertices) != SUCCESS) {
+        fprintf(stderr, "Error: Invalid batch header in file %s\n", filename);
+        fclose(file);
+        return NULL;
+    }
+
+    GraphBatch *batch = graph_batch_create(vertices, count);
+    if (!batch) {
+        fprintf(stderr, "Error: Failed to create batch\n");
+        fclose(file);
+        return NULL;
+    }
+
+    for (int g = 0; g < count; g++) {
+        int edges;
+        if (fscanf(file, "%d", &edges) != 1 || edges < 0) {
+            fprintf(stderr, "Error: Invalid edge count for graph %d in file %s\n", g, filename);
+            graph_batch_destroy(batch);
+            fclose(file);
+            return NULL;
+        }
+
+        for (int e = 0; e < edges; e++) {
+            int from, to;
+            double weight;
+
+            if (fscanf(file, "%d %d %lf", &from, &to, &weight) != 3 ||
+                graph_batch_add_edge(batch, g, from, to, weight) != SUCCESS) {
+                fprintf(stderr, "Error: Invalid edge %d of graph %d in file %s\n", e, g, filename);
+                graph_batch_destroy(batch);
+                fclose(file);
+                return NULL;
+            }
+        }
+    }
+
+    fclose(file);
+    return batch;
+}
+
+ReturnCode save_graph_batch_to_file(const GraphBatch *batch, const char *filename) {
+    if (!batch || !filename) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if (!batch->is_initialized) {
+        return ERROR_INVALID_INPUT;
+    }
+
+    FILE *file = fopen(filename, "w");
+    if (!file) {
+        return ERROR_FILE_IO;
+    }
+
+    int n = batch->vertices;
+    fprintf(file, "batch %d %d\n", batch->count, n);
+
+    for (int g = 0; g < batch->count; g++) {
+        int edge_count = 0;
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                if (i != j && graph_batch_get_distance(batch, g, i, j) < INFINITY_VALUE) {
+                    edge_count++;
+                }
+            }
+        }
+
+        fprintf(file, "%d\n", edge_count);
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                double weight = graph_batch_get_distance(batch, g, i, j);
+                if (i != j && weight < INFINITY_VALUE) {
+                    fprintf(file, "%d %d %.6f\n", i, j, weight);
+                }
+            }
+        }
+    }
+
+    if (fclose(file) != 0) {
+        return ERROR_FILE_IO;
+    }
+    return SUCCESS;
+}
+
+ReturnCode save_batch_result_to_file(const GraphBatch *batch, const char *filename) {
+    if (!batch || !filename) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if (!batch->is_initialized) {
+        return ERROR_INVALID_INPUT;
+    }
+
+    FILE *file = fopen(filename, "w");
+    if (!file) {
+        return ERROR_FILE_IO;
+    }
+
+    int n = batch->vertices;
+    fprintf(file, "Floyd-Warshall Batch Results\n");
+    fprintf(file, "============================\n\n");
+    fprintf(file, "%d graphs with %d vertices\n", batch->count, n);
+
+    for (int g = 0; g < batch->count; g++) {
+        fprintf(file, "\nGraph %d", g);
+        if (batch->negative_cycle[g]) {
+            fprintf(file, ": negative cycle detected\n");
+            continue;
+        }
+        fprintf(file, " shortest distance matrix:\n");
+
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                double distance = graph_batch_get_distance(batch, g, i, j);
+                if (distance >= INFINITY_VALUE) {
+                    fprintf(file, "     INF");
+                } else {
+                    fprintf(file, "%8.2f", distance);
+                }
+            }
+            fprintf(file, "\n");
+        }
+    }
+
+    fclose(file);
+    return SUCCESS;
+}
+
+ReturnCode read_binary_graph_header(FILE *file, BinaryGraphHeader *header) {
+    if (!file || !header) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if (fread(header, sizeof(BinaryGraphHeader), 1, file) != 1) {
+        return ERROR_FILE_IO;
+    }
+
+    if (memcmp(header->magic, GRAPH_BINARY_MAGIC, 4) != 0 ||
+        header->version != GRAPH_BINARY_VERSION ||
+        header->vertices <= 0 || header->edge_count < 0) {
+        return ERROR_INVALID_INPUT;
+    }
+
+    return SUCCESS;
+}
+
+Graph* load_graph_from_binary_file(const char *filename) {
+    if (!filename) {
+        return NULL;
+    }
+
+    return load_directed_graph(filename, true);
+}
+
+ReturnCode save_graph_to_binary_file(const Graph *graph, const char *filename) {
+    if (!graph || !filename) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if (graph_validate(graph) != SUCCESS) {
+        return ERROR_INVALID_INPUT;
+    }
+
+    FILE *file = fopen(filename, "wb");
+    if (!file) {
+        return ERROR_FILE_IO;
+    }
+
+    BinaryGraphHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, GRAPH_BINARY_MAGIC, 4);
+    header.version = GRAPH_BINARY_VERSION;
+    header.vertices = graph->vertices;
+
+    for (int i = 0; i < graph->vertices; i++) {
+        for (int j = 0; j < graph->vertices; j++) {
+            if (i != j && graph->distance[i][j] < INFINITY_VALUE) {
+                header.edge_count++;
+            }
+        }
+    }
+
+    if (fwrite(&header, sizeof(header), 1, file) != 1) {
+        fclose(file);
+        return ERROR_FILE_IO;
+    }
+
+    BinaryEdgeRecord records[BINARY_EDGE_BLOCK];
+    size_t pending = 0;
+    for (int i = 0; i < graph->vertices; i++) {
+        for (int j = 0; j < graph->vertices; j++) {
+            if (i != j && graph->distance[i][j] < INFINITY_VALUE) {
+                records[pending].from = i;
+                records[pending].to = j;
+                records[pending].weight = graph->distance[i][j];
+                if (++pending == BINARY_EDGE_BLOCK) {
+                    if (fwrite(records, sizeof(BinaryEdgeRecord), pending, file) != pending) {
+                        fclose(file);
+                        return ERROR_FILE_IO;
+                    }
+                    pending = 0;
+                }
+            }
+        }
+    }
+
+    if (pending > 0 && fwrite(records, sizeof(BinaryEdgeRecord), pending, file) != pending) {
+        fclose(file);
+        return ERROR_FILE_IO;
+    }
+
+    if (fclose(file) != 0) {
+        return ERROR_FILE_IO;
+    }
+    return SUCCESS;
+}
+
+bool is_binary_graph_file(const char *filename) {
+    if (!filename) {
+        return false;
+    }
+
+    FILE *file = fopen(filename, "rb");
+    if (!file) {
+        return false;
+    }
+
+    char magic[4];
+    bool binary = fread(magic, 1, 4, file) == 4 && memcmp(magic, GRAPH_BINARY_MAGIC, 4) == 0;
+    fclose(file);
+    return binary;
+}
+
+bool is_graph_batch_file(const char *filename) {
+    if (!filename) {
+        return false;
+    }
+
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        return false;
+    }
+
+    int count, vertices;
+    bool batch = read_batch_header(file, &count, &vertices) == SUCCESS;
+    fclose(file);
+    return batch;
+}
+
+/* 64-bit FNV-1a, continued from hash */
+static uint64_t checkpoint_hash(uint64_t hash, const void *data, size_t length) {
+    const unsigned char *bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+#define CHECKPOINT_HASH_SEED 14695981039346656037ULL
+
+static bool checkpoint_write(FILE *file, const void *data, size_t length, uint64_t *hash) {
+    *hash = checkpoint_hash(*hash, data, length);
+    return fwrite(data, 1, length, file) == length;
+}
+
+static bool checkpoint_read(FILE *file, void *data, size_t length, uint64_t *hash) {
+    if (fread(data, 1, length, file) != length) {
+        return false;
+    }
+    *hash = checkpoint_hash(*hash, data, length);
+    return true;
+}
+
+uint64_t checkpoint_input_hash(const Graph *graph) {
+    uint64_t hash = CHECKPOINT_HASH_SEED;
+    if (!graph || !graph->is_initialized) {
+        return hash;
+    }
+
+    size_t row = (size_t)graph->vertices;
+    for (int i = 0; i < graph->vertices; i++) {
+        hash = checkpoint_hash(hash, graph->distance[i], row * sizeof(double));
+    }
+    for (int i = 0; i < graph->vertices; i++) {
+        hash = checkpoint_hash(hash, graph->next[i], row * sizeof(graph->next[i][0]));
+    }
+    return hash;
+}
+
+ReturnCode save_checkpoint_to_file(const Graph *graph, int next_pivot, uint64_t input_hash, const char *filename) {
+    if (!graph || !graph->is_initialized || !filename) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if (next_pivot < 0 || next_pivot > graph->vertices ||
+        strlen(filename) + 5 > MAX_FILENAME_LENGTH) {
+        return ERROR_INVALID_INPUT;
+    }
+
+    int n = graph->vertices;
+    char temp_name[MAX_FILENAME_LENGTH];
+    snprintf(temp_name, sizeof(temp_name), "%s.tmp", filename);
+
+    int32_t *next_row = (int32_t*)malloc((size_t)n * sizeof(int32_t));
+    FILE *file = next_row ? fopen(temp_name, "wb") : NULL;
+    if (!file) {
+        free(next_row);
+        return next_row ? ERROR_FILE_IO : ERROR_MEMORY_ALLOCATION;
+    }
+
+    CheckpointHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CHECKPOINT_MAGIC, 4);
+    header.version = CHECKPOINT_VERSION;
+    header.vertices = n;
+    header.next_pivot = next_pivot;
+    header.input_hash = input_hash;
+
+    uint64_t hash = CHECKPOINT_HASH_SEED;
+    bool written = checkpoint_write(file, &header, sizeof(header), &hash);
+    for (int i = 0; i < n && written; i++) {
+        written = checkpoint_write(file, graph->distance[i], (size_t)n * sizeof(double), &hash);
+    }
+    for (int i = 0; i < n && written; i++) {
+        for (int j = 0; j < n; j++) {
+            next_row[j] = graph->next[i][j];
+        }
+        written = checkpoint_write(file, next_row, (size_t)n * sizeof(int32_t), &hash);
+    }
+    free(next_row);
+
+    /* The rename only happens once the data is on disk */
+    written = written && fwrite(&hash, sizeof(hash), 1, file) == 1 &&
+              fflush(file) == 0 && fsync(fileno(file)) == 0;
+    if (fclose(file) != 0 || !written || rename(temp_name, filename) != 0) {
+        remove(temp_name);
+        return ERROR_FILE_IO;
+    }
+
+    return SUCCESS;
+}
+
+Graph* load_checkpoint_from_file(const char *filename, int *next_pivot, uint64_t *input_hash) {
+    if (!filename || !next_pivot) {
+        return NULL;
+    }
+
+    FILE *file = fopen(filename, "rb");
+    if (!file) {
+        return NULL;
+    }
+
+    CheckpointHeader header;
+    uint64_t hash = CHECKPOINT_HASH_SEED;
+    if (!checkpoint_read(file, &header, sizeof(header), &hash) ||
+        memcmp(header.magic, CHECKPOINT_MAGIC, 4) != 0 ||
+        header.version != CHECKPOINT_VERSION ||
+        header.vertices <= 0 || header.vertices > MAX_VERTICES ||
+        header.next_pivot < 0 || header.next_pivot > header.vertices) {
+        fclose(file);
+        return NULL;
+    }
+
+    int n = header.vertices;
+    Graph *graph = graph_create(n);
+    int32_t *next_row = (int32_t*)malloc((size_t)n * sizeof(int32_t));
+    bool valid = graph && next_row;
+    for (int i = 0; i < n && valid; i++) {
+        valid = checkpoint_read(file, graph->distance[i], (size_t)n * sizeof(double), &hash);
+    }
+    for (int i = 0; i < n && valid; i++) {
+        valid = checkpoint_read(file, next_row, (size_t)n * sizeof(int32_t), &hash);
+        for (int j = 0; j < n && valid; j++) {
+            valid = next_row[j] >= -1 && next_row[j] < n;
+            graph->next[i][j] = next_row[j];
+        }
+    }
+    free(next_row);
+
+    uint64_t stored = 0;
+    valid = valid && fread(&stored, sizeof(stored), 1, file) == 1 && stored == hash;
+    fclose(file);
+
+    if (!valid) {
+        graph_destroy(graph);
+        return NULL;
+    }
+
+    *next_pivot = header.next_pivot;
+    if (input_hash) {
+        *input_hash = header.input_hash;
+    }
+    return graph;
+}
+
 bool file_exists(const char *filename) {
     if (!filename) {
         return false;
@@ -184,6 +944,42 @@ bool file_exists(const char *filename) {
     return false;
 }
 
+static ReturnCode validate_binary_graph_file(const char *filename) {
+    FILE *file = fopen(filename, "rb");
+    if (!file) {
+        return ERROR_FILE_IO;
+    }
+
+    BinaryGraphHeader header;
+    if (read_binary_graph_header(file, &header) != SUCCESS || header.vertices > MAX_VERTICES) {
+        fclose(file);
+        return ERROR_INVALID_INPUT;
+    }
+
+    /* Validate each edge record */
+    BinaryEdgeRecord records[BINARY_EDGE_BLOCK];
+    int64_t remaining = header.edge_count;
+    while (remaining > 0) {
+        size_t block = remaining < BINARY_EDGE_BLOCK ? (size_t)remaining : BINARY_EDGE_BLOCK;
+        if (fread(records, sizeof(BinaryEdgeRecord), block, file) != block) {
+            fclose(file);
+            return ERROR_INVALID_INPUT;
+        }
+
+        for (size_t e = 0; e < block; e++) {
+            if (records[e].from < 0 || records[e].from >= header.vertices ||
+                records[e].to < 0 || records[e].to >= header.vertices) {
+                fclose(file);
+                return ERROR_INVALID_INPUT;
+            }
+        }
+        remaining -= (int64_t)block;
+    }
+
+    fclose(file);
+    return SUCCESS;
+}
+
 ReturnCode validate_graph_file(const char *filename) {
     if (!filename) {
         return ERROR_NULL_POINTER;
@@ -193,18 +989,23 @@ ReturnCode validate_graph_file(const char *filename) {
         return ERROR_FILE_IO;
     }
 
+    if (is_binary_graph_file(filename)) {
+        return validate_binary_graph_file(filename);
+    }
+
     FILE *file = fopen(filename, "r");
     if (!file) {
         return ERROR_FILE_IO;
     }
 
     int vertices, edges;
-    if (fscanf(file, "%d %d", &vertices, &edges) != 2) {
+    bool undirected;
+    if (read_text_graph_header(file, &vertices, &edges, &undirected) != SUCCESS) {
         fclose(file);
         return ERROR_INVALID_INPUT;
     }
 
-    if (vertices <= 0 || vertices > MAX_VERTICES || edges < 0) {
+    if (vertices > MAX_VERTICES) {
         fclose(file);
         return ERROR_INVALID_INPUT;
     }
@@ -235,66 +1036,9 @@ ReturnCode generate_sample_graph_file(const char *filename, int vertices, double
         return ERROR_INVALID_INPUT;
     }
 
-    FILE *file = fopen(filename, "w");
-    if (!file) {
-        return ERROR_FILE_IO;
-    }
-
-    srand((unsigned int)time(NULL));
-
-    /* Write number of vertices */
-    fprintf(file, "%d\n", vertices);
-
-    /* Generate edges based on density */
-    int max_edges = vertices * (vertices - 1);
-    int target_edges = (int)(max_edges * density);
-    int actual_edges = 0;
-
-    /* Temporary storage for edges */
-    typedef struct {
-        int from, to;
-        double weight;
-    } Edge;
-
-    Edge *edges = (Edge*)malloc(target_edges * sizeof(Edge));
-    if (!edges) {
-        fclose(file);
-        return ERROR_MEMORY_ALLOCATION;
-    }
-
-    /* Generate random edges */
-    while (actual_edges < target_edges) {
-        int from = rand() % vertices;
-        int to = rand() % vertices;
+    /* Uniform random graph with exactly density * V * (V - 1) distinct edges */
+    GraphGeneratorConfig config;
+    graph_generator_default_config(&config, GRAPH_FAMILY_ERDOS_RENYI, vertices, density);
 
-        if (from != to) {
-            /* Check if edge already exists */
-            bool exists = false;
-            for (int i = 0; i < actual_edges; i++) {
-                if (edges[i].from == from && edges[i].to == to) {
-                    exists = true;
-                    break;
-                }
-            }
-
-            if (!exists) {
-                edges[actual_edges].from = from;
-                edges[actual_edges].to = to;
-                edges[actual_edges].weight = (double)(rand() % 100 + 1);
-                actual_edges++;
-            }
-        }
-    }
-
-    /* Write number of edges */
-    fprintf(file, "%d\n", actual_edges);
-
-    /* Write edges */
-    for (int i = 0; i < actual_edges; i++) {
-        fprintf(file, "%d %d %.2f\n", edges[i].from, edges[i].to, edges[i].weight);
-    }
-
-    free(edges);
-    fclose(file);
-    return SUCCESS;
-}
\ No newline at end of file
+    return graph_generate_file(&config, filename, GRAPH_FORMAT_TEXT, NULL);
+}
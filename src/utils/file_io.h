@@ -2,15 +2,101 @@
 #define FILE_IO_H
 
 #include "../data_structures/graph.h"
+#include "../data_structures/symmetric_graph.h"
+#include "../data_structures/graph_batch.h"
+#include "../core/transitive_closure.h"
+#include <stdio.h>
+#include <stdint.h>
+
+/* Binary graph format: header followed by edge_count BinaryEdgeRecord (host byte order) */
+#define GRAPH_BINARY_MAGIC "FWGB"
+#define GRAPH_BINARY_VERSION 1
+
+/* Header flag bits */
+#define GRAPH_BINARY_FLAG_UNDIRECTED 0x1u  /* Each record is an undirected edge */
+
+typedef struct {
+    char magic[4];           /* GRAPH_BINARY_MAGIC */
+    uint32_t version;        /* GRAPH_BINARY_VERSION */
+    int32_t vertices;        /* Number of vertices */
+    uint32_t flags;          /* GRAPH_BINARY_FLAG_* bits */
+    int64_t edge_count;      /* Number of edge records that follow */
+} BinaryGraphHeader;
+
+typedef struct {
+    int32_t from;
+    int32_t to;
+    double weight;
+} BinaryEdgeRecord;
+
+/*
+ * Checkpoint format: header, the distance matrix (double, row-major), the
+ * next-hop matrix (int32, row-major), then a 64-bit FNV-1a checksum of
+ * everything before it. Files are written to "<name>.tmp" and renamed, so
+ * the named file is always a complete checkpoint. The header carries
+ * checkpoint_input_hash of the graph the run started from, so a checkpoint
+ * is never resumed against a different input of the same size.
+ */
+#define CHECKPOINT_MAGIC "FWCK"
+#define CHECKPOINT_VERSION 2
+
+typedef struct {
+    char magic[4];           /* CHECKPOINT_MAGIC */
+    uint32_t version;        /* CHECKPOINT_VERSION */
+    int32_t vertices;        /* Number of vertices */
+    int32_t next_pivot;      /* Pivots 0..next_pivot-1 are applied */
+    uint64_t input_hash;     /* checkpoint_input_hash of the unsolved graph */
+} CheckpointHeader;
+
+/* Supported on-disk graph formats */
+typedef enum {
+    GRAPH_FORMAT_TEXT = 0,
+    GRAPH_FORMAT_BINARY
+} GraphFileFormat;
 
 /* Graph file I/O functions */
 Graph* load_graph_from_file(const char *filename);
 ReturnCode save_graph_to_file(const Graph *graph, const char *filename);
 ReturnCode save_result_to_file(const Graph *graph, const char *filename);
+Graph* load_graph_from_binary_file(const char *filename);
+ReturnCode save_graph_to_binary_file(const Graph *graph, const char *filename);
+
+/* Undirected graphs (text header "<vertices> undirected" or GRAPH_BINARY_FLAG_UNDIRECTED) */
+SymmetricGraph* load_symmetric_graph_from_file(const char *filename);
+ReturnCode save_symmetric_graph_to_file(const SymmetricGraph *graph, const char *filename,
+                                        GraphFileFormat format);
+ReturnCode save_symmetric_result_to_file(const SymmetricGraph *graph, const char *filename);
+
+/*
+ * Edges of a graph file streamed straight into reachability bits (no
+ * distance matrix); edges with weight >= INFINITY_VALUE are not edges, and
+ * undirected files set both directions.
+ */
+ReachabilityMatrix* load_reachability_from_file(const char *filename);
+
+/*
+ * Multi-graph files: "batch <graph_count> <vertices>", then for every graph
+ * its edge count followed by that many "from to weight" lines. Saving
+ * writes the current matrices, i.e. the input graphs until the batch is solved.
+ */
+GraphBatch* load_graph_batch_from_file(const char *filename);
+ReturnCode save_graph_batch_to_file(const GraphBatch *batch, const char *filename);
+ReturnCode save_batch_result_to_file(const GraphBatch *batch, const char *filename);
+
+/* Checkpoints of a partially solved graph (NULL if missing, truncated or corrupt; input_hash may be NULL) */
+ReturnCode save_checkpoint_to_file(const Graph *graph, int next_pivot, uint64_t input_hash, const char *filename);
+Graph* load_checkpoint_from_file(const char *filename, int *next_pivot, uint64_t *input_hash);
+
+/* 64-bit FNV-1a of the distance and next-hop matrices, taken before solving */
+uint64_t checkpoint_input_hash(const Graph *graph);
 
 /* Utility functions for file handling */
 bool file_exists(const char *filename);
 ReturnCode validate_graph_file(const char *filename);
+bool is_binary_graph_file(const char *filename);
+bool is_undirected_graph_file(const char *filename);
+bool is_graph_batch_file(const char *filename);
+ReturnCode read_binary_graph_header(FILE *file, BinaryGraphHeader *header);
 
 /* Sample data generation */
 ReturnCode generate_sample_graph_file(const char *filename, int vertices, double density);
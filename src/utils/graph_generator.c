@@ -0,0 +1,666 @@
+#include "graph_generator.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*
+ * Work is split into a fixed number of chunks that depends only on the
+ * configuration, never on the thread count, so output is reproducible.
+ */
+#define GENERATOR_MAX_CHUNKS 256
+#define RMAT_CHUNKS 64
+#define RMAT_MAX_ROUNDS 64
+#define WRITE_BUFFER_SIZE (1 << 20)
+
+/* R-MAT quadrant probabilities (Graph500 defaults, d = 0.05) */
+#define RMAT_A 0.57
+#define RMAT_B 0.19
+#define RMAT_C 0.19
+
+static const char *family_names[GRAPH_FAMILY_COUNT] = {
+    "er",
+    "grid",
+    "rmat",
+    "dag",
+    "negcycle"
+};
+
+/* splitmix64: tiny, fast and good enough for graph generation */
+static uint64_t rng_next(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static double rng_uniform(uint64_t *state) {
+    return (double)(rng_next(state) >> 11) / 9007199254740992.0;
+}
+
+static uint64_t rng_below(uint64_t *state, uint64_t bound) {
+    return rng_next(state) % bound;
+}
+
+/* Independent stream for a chunk, derived from the user seed */
+static uint64_t stream_seed(uint64_t seed, uint64_t stream) {
+    uint64_t state = seed ^ (stream * 0xD1B54A32D192ED03ULL);
+    return rng_next(&state);
+}
+
+static double rng_weight(uint64_t *state, const GraphGeneratorConfig *config) {
+    double span = floor(config->max_weight) - floor(config->min_weight) + 1.0;
+    double weight = floor(config->min_weight) + floor(rng_uniform(state) * span);
+    return weight > config->max_weight ? floor(config->max_weight) : weight;
+}
+
+/* Number of positions skipped before the next success of a Bernoulli(p) sequence */
+static int64_t rng_geometric_skip(uint64_t *state, double p) {
+    if (p >= 1.0) {
+        return 0;
+    }
+    double u = rng_uniform(state);
+    if (u <= 0.0) {
+        u = 1e-300;
+    }
+    return (int64_t)floor(log(u) / log(1.0 - p));
+}
+
+/* Open-addressing set of 64-bit keys, used for O(1) duplicate checks */
+typedef struct {
+    uint64_t *slots;          /* key + 1, 0 marks an empty slot */
+    uint64_t mask;
+} PairSet;
+
+static ReturnCode pair_set_init(PairSet *set, int64_t expected) {
+    uint64_t capacity = 16;
+    while (capacity < (uint64_t)expected * 2) {
+        capacity <<= 1;
+    }
+
+    set->slots = (uint64_t*)calloc(capacity, sizeof(uint64_t));
+    set->mask = capacity - 1;
+    return set->slots ? SUCCESS : ERROR_MEMORY_ALLOCATION;
+}
+
+static void pair_set_free(PairSet *set) {
+    free(set->slots);
+    set->slots = NULL;
+}
+
+static uint64_t pair_set_hash(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDULL;
+    key ^= key >> 33;
+    return key;
+}
+
+/* Returns true if the key was not present before */
+static bool pair_set_insert(PairSet *set, uint64_t key) {
+    uint64_t slot = pair_set_hash(key) & set->mask;
+    while (set->slots[slot] != 0) {
+        if (set->slots[slot] == key + 1) {
+            return false;
+        }
+        slot = (slot + 1) & set->mask;
+    }
+    set->slots[slot] = key + 1;
+    return true;
+}
+
+static bool pair_set_contains(const PairSet *set, uint64_t key) {
+    uint64_t slot = pair_set_hash(key) & set->mask;
+    while (set->slots[slot] != 0) {
+        if (set->slots[slot] == key + 1) {
+            return true;
+        }
+        slot = (slot + 1) & set->mask;
+    }
+    return false;
+}
+
+static ReturnCode edge_list_reserve(EdgeList *list, int64_t capacity) {
+    if (capacity <= list->capacity) {
+        return SUCCESS;
+    }
+
+    GeneratedEdge *edges = (GeneratedEdge*)realloc(list->edges, (size_t)capacity * sizeof(GeneratedEdge));
+    if (!edges) {
+        return ERROR_MEMORY_ALLOCATION;
+    }
+    list->edges = edges;
+    list->capacity = capacity;
+    return SUCCESS;
+}
+
+static ReturnCode edge_list_push(EdgeList *list, int from, int to, double weight) {
+    if (list->count == list->capacity &&
+        edge_list_reserve(list, list->capacity > 0 ? list->capacity * 2 : 64) != SUCCESS) {
+        return ERROR_MEMORY_ALLOCATION;
+    }
+
+    list->edges[list->count].from = from;
+    list->edges[list->count].to = to;
+    list->edges[list->count].weight = weight;
+    list->count++;
+    return SUCCESS;
+}
+
+void edge_list_free(EdgeList *list) {
+    if (!list) {
+        return;
+    }
+    free(list->edges);
+    list->edges = NULL;
+    list->count = 0;
+    list->capacity = 0;
+}
+
+/* Concatenate per-chunk lists in chunk order, releasing them */
+static ReturnCode merge_chunks(EdgeList *chunks, int chunk_count, EdgeList *list) {
+    int64_t total = 0;
+    for (int c = 0; c < chunk_count; c++) {
+        total += chunks[c].count;
+    }
+
+    ReturnCode status = edge_list_reserve(list, total > 0 ? total : 1);
+    for (int c = 0; c < chunk_count; c++) {
+        if (status == SUCCESS && chunks[c].count > 0) {
+            memcpy(list->edges + list->count, chunks[c].edges,
+                   (size_t)chunks[c].count * sizeof(GeneratedEdge));
+            list->count += chunks[c].count;
+        }
+        edge_list_free(&chunks[c]);
+    }
+    return status;
+}
+
+static int chunk_count_for(int rows) {
+    return rows < GENERATOR_MAX_CHUNKS ? rows : GENERATOR_MAX_CHUNKS;
+}
+
+static int chunk_row_start(int rows, int chunks, int chunk) {
+    return (int)((int64_t)rows * chunk / chunks);
+}
+
+static int64_t target_edge_count(const GraphGeneratorConfig *config) {
+    int64_t n = config->vertices;
+    int64_t possible = n * (n - 1);
+    int64_t target = config->edges > 0 ? config->edges : (int64_t)(possible * config->density);
+    return target < possible ? target : possible;
+}
+
+/*
+ * Erdos-Renyi G(n, m): each chunk of source rows receives its proportional
+ * share of m and samples distinct pairs with a hash set. Dense chunks sample
+ * the excluded pairs instead, so the expected work stays O(edges).
+ */
+static ReturnCode generate_erdos_renyi_chunk(const GraphGeneratorConfig *config, int row_start,
+                                             int row_end, int64_t target, uint64_t seed, EdgeList *out) {
+    int64_t n = config->vertices;
+    int64_t pairs = (int64_t)(row_end - row_start) * (n - 1);
+    bool sample_excluded = target > pairs / 2;
+    int64_t sampled = sample_excluded ? pairs - target : target;
+    uint64_t state = seed;
+    PairSet set;
+
+    if (pairs == 0 || target == 0) {
+        return SUCCESS;
+    }
+    if (pair_set_init(&set, sampled) != SUCCESS || edge_list_reserve(out, target) != SUCCESS) {
+        pair_set_free(&set);
+        return ERROR_MEMORY_ALLOCATION;
+    }
+
+    for (int64_t s = 0; s < sampled; ) {
+        uint64_t pair = rng_below(&state, (uint64_t)pairs);
+        if (!pair_set_insert(&set, pair)) {
+            continue;
+        }
+        s++;
+
+        if (!sample_excluded) {
+            int from = row_start + (int)(pair / (uint64_t)(n - 1));
+            int to = (int)(pair % (uint64_t)(n - 1));
+            to += (to >= from);
+            edge_list_push(out, from, to, rng_weight(&state, config));
+        }
+    }
+
+    if (sample_excluded) {
+        for (int64_t pair = 0; pair < pairs; pair++) {
+            if (!pair_set_contains(&set, (uint64_t)pair)) {
+                int from = row_start + (int)(pair / (n - 1));
+                int to = (int)(pair % (n - 1));
+                to += (to >= from);
+                edge_list_push(out, from, to, rng_weight(&state, config));
+            }
+        }
+    }
+
+    pair_set_free(&set);
+    return SUCCESS;
+}
+
+static ReturnCode generate_erdos_renyi(const GraphGeneratorConfig *config, EdgeList *list) {
+    int n = config->vertices;
+    int chunks = chunk_count_for(n);
+    int64_t target = target_edge_count(config);
+    double total_pairs = (double)n * (double)(n - 1);
+    EdgeList chunk_lists[GENERATOR_MAX_CHUNKS];
+    int failures = 0;
+
+    memset(chunk_lists, 0, sizeof(chunk_lists));
+
+    #pragma omp parallel for schedule(dynamic) reduction(+:failures)
+    for (int c = 0; c < chunks; c++) {
+        int row_start = chunk_row_start(n, chunks, c);
+        int row_end = chunk_row_start(n, chunks, c + 1);
+        /* Cumulative rounding keeps the chunk shares summing to exactly target */
+        double before = (double)row_start * (n - 1) / total_pairs;
+        double after = (double)row_end * (n - 1) / total_pairs;
+        int64_t share = (int64_t)floor(target * after + 0.5) - (int64_t)floor(target * before + 0.5);
+
+        if (generate_erdos_renyi_chunk(config, row_start, row_end, share,
+                                       stream_seed(config->seed, (uint64_t)c), &chunk_lists[c]) != SUCCESS) {
+            failures++;
+        }
+    }
+
+    ReturnCode status = merge_chunks(chunk_lists, chunks, list);
+    return failures > 0 ? ERROR_MEMORY_ALLOCATION : status;
+}
+
+/* Road-like lattice: every right/down link is kept with probability density, in both directions */
+static ReturnCode generate_grid(const GraphGeneratorConfig *config, EdgeList *list) {
+    int n = config->vertices;
+    int width = (int)ceil(sqrt((double)n));
+    int chunks = chunk_count_for(n);
+    double keep = config->density > 0.0 ? config->density : 1.0;
+    EdgeList chunk_lists[GENERATOR_MAX_CHUNKS];
+    int failures = 0;
+
+    memset(chunk_lists, 0, sizeof(chunk_lists));
+
+    #pragma omp parallel for schedule(dynamic) reduction(+:failures)
+    for (int c = 0; c < chunks; c++) {
+        uint64_t state = stream_seed(config->seed, (uint64_t)c);
+        int row_end = chunk_row_start(n, chunks, c + 1);
+
+        for (int v = chunk_row_start(n, chunks, c); v < row_end; v++) {
+            int right = (v % width + 1 < width && v + 1 < n) ? v + 1 : -1;
+            int down = (v + width < n) ? v + width : -1;
+            int neighbours[2] = {right, down};
+
+            for (int k = 0; k < 2; k++) {
+                if (neighbours[k] >= 0 && rng_uniform(&state) < keep) {
+                    double weight = rng_weight(&state, config);
+                    if (edge_list_push(&chunk_lists[c], v, neighbours[k], weight) != SUCCESS ||
+                        edge_list_push(&chunk_lists[c], neighbours[k], v, weight) != SUCCESS) {
+                        failures++;
+                    }
+                }
+            }
+        }
+    }
+
+    ReturnCode status = merge_chunks(chunk_lists, chunks, list);
+    return failures > 0 ? ERROR_MEMORY_ALLOCATION : status;
+}
+
+/*
+ * R-MAT: candidates are drawn in parallel rounds, then deduplicated in
+ * O(edges). Dense targets may stop short once the distribution saturates.
+ */
+static ReturnCode generate_rmat(const GraphGeneratorConfig *config, EdgeList *list) {
+    int n = config->vertices;
+    int64_t target = target_edge_count(config);
+    int scale = 0;
+    while ((1LL << scale) < n) {
+        scale++;
+    }
+
+    PairSet set;
+    if (pair_set_init(&set, target) != SUCCESS || edge_list_reserve(list, target > 0 ? target : 1) != SUCCESS) {
+        pair_set_free(&set);
+        return ERROR_MEMORY_ALLOCATION;
+    }
+
+    for (int round = 0; round < RMAT_MAX_ROUNDS && list->count < target; round++) {
+        int64_t needed = target - list->count;
+        int64_t candidates = needed + needed / 8 + RMAT_CHUNKS;
+        EdgeList chunk_lists[RMAT_CHUNKS];
+        int failures = 0;
+
+        memset(chunk_lists, 0, sizeof(chunk_lists));
+
+        #pragma omp parallel for schedule(dynamic) reduction(+:failures)
+        for (int c = 0; c < RMAT_CHUNKS; c++) {
+            uint64_t state = stream_seed(config->seed, (uint64_t)round * RMAT_CHUNKS + (uint64_t)c);
+            int64_t count = candidates / RMAT_CHUNKS;
+
+            if (edge_list_reserve(&chunk_lists[c], count > 0 ? count : 1) != SUCCESS) {
+                failures++;
+                continue;
+            }
+            for (int64_t e = 0; e < count; e++) {
+                int64_t from = 0, to = 0;
+                for (int bit = 0; bit < scale; bit++) {
+                    double r = rng_uniform(&state);
+                    int row_bit = r >= RMAT_A + RMAT_B;
+                    int col_bit = (r >= RMAT_A && r < RMAT_A + RMAT_B) || r >= RMAT_A + RMAT_B + RMAT_C;
+                    from = (from << 1) | row_bit;
+                    to = (to << 1) | col_bit;
+                }
+                edge_list_push(&chunk_lists[c], (int)from, (int)to, rng_weight(&state, config));
+            }
+        }
+
+        int64_t before = list->count;
+        for (int c = 0; c < RMAT_CHUNKS; c++) {
+            for (int64_t e = 0; e < chunk_lists[c].count && list->count < target; e++) {
+                const GeneratedEdge *edge = &chunk_lists[c].edges[e];
+                if (edge->from != edge->to && edge->from < n && edge->to < n &&
+                    pair_set_insert(&set, (uint64_t)edge->from * (uint64_t)n + (uint64_t)edge->to)) {
+                    list->edges[list->count++] = *edge;
+                }
+            }
+            edge_list_free(&chunk_lists[c]);
+        }
+
+        if (failures > 0) {
+            pair_set_free(&set);
+            return ERROR_MEMORY_ALLOCATION;
+        }
+
+        /* Skewed quadrants saturate long before n^2; stop once rounds stop paying off */
+        if (list->count - before < needed / 100) {
+            break;
+        }
+    }
+
+    pair_set_free(&set);
+    return SUCCESS;
+}
+
+/* Layered DAG: vertex in layer l links to each vertex of layer l + 1 with probability density */
+static ReturnCode generate_layered_dag(const GraphGeneratorConfig *config, EdgeList *list) {
+    int n = config->vertices;
+    int layers = config->layers > 0 ? config->layers : (int)ceil(sqrt((double)n));
+    int chunks = chunk_count_for(n);
+    EdgeList chunk_lists[GENERATOR_MAX_CHUNKS];
+    int failures = 0;
+
+    if (layers < 2) {
+        layers = 2;
+    }
+    if (layers > n) {
+        layers = n;
+    }
+    memset(chunk_lists, 0, sizeof(chunk_lists));
+
+    #pragma omp parallel for schedule(dynamic) reduction(+:failures)
+    for (int c = 0; c < chunks; c++) {
+        uint64_t state = stream_seed(config->seed, (uint64_t)c);
+        int row_end = chunk_row_start(n, chunks, c + 1);
+
+        for (int v = chunk_row_start(n, chunks, c); v < row_end; v++) {
+            int layer = (int)(((int64_t)v * layers) / n);
+            if (layer + 1 >= layers || config->density <= 0.0) {
+                continue;
+            }
+
+            /* First vertex of layer l is ceil(l * n / layers) */
+            int next_start = (int)(((int64_t)(layer + 1) * n + layers - 1) / layers);
+            int next_end = (int)(((int64_t)(layer + 2) * n + layers - 1) / layers);
+            if (next_end > n) {
+                next_end = n;
+            }
+
+            for (int64_t to = next_start + rng_geometric_skip(&state, config->density);
+                 to < next_end;
+                 to += 1 + rng_geometric_skip(&state, config->density)) {
+                if (edge_list_push(&chunk_lists[c], v, (int)to, rng_weight(&state, config)) != SUCCESS) {
+                    failures++;
+                    break;
+                }
+            }
+        }
+    }
+
+    ReturnCode status = merge_chunks(chunk_lists, chunks, list);
+    return failures > 0 ? ERROR_MEMORY_ALLOCATION : status;
+}
+
+/* Erdos-Renyi background plus a planted cycle of total weight -1 */
+static ReturnCode generate_negative_cycle(const GraphGeneratorConfig *config, EdgeList *list) {
+    int n = config->vertices;
+    int length = config->cycle_length > 0 ? config->cycle_length : 3;
+    if (length > n) {
+        length = n;
+    }
+    if (n < 2) {
+        return ERROR_INVALID_INPUT;
+    }
+    if (length < 2) {
+        length = 2;
+    }
+
+    ReturnCode status = generate_erdos_renyi(config, list);
+    if (status != SUCCESS) {
+        return status;
+    }
+
+    /* Pick distinct cycle vertices from a dedicated stream */
+    int *cycle = (int*)malloc((size_t)length * sizeof(int));
+    PairSet chosen;
+    if (!cycle || pair_set_init(&chosen, length) != SUCCESS) {
+        free(cycle);
+        return ERROR_MEMORY_ALLOCATION;
+    }
+
+    uint64_t state = stream_seed(config->seed, UINT64_MAX);
+    for (int c = 0; c < length; ) {
+        int v = (int)rng_below(&state, (uint64_t)n);
+        if (pair_set_insert(&chosen, (uint64_t)v)) {
+            cycle[c++] = v;
+        }
+    }
+    pair_set_free(&chosen);
+
+    /* Cycle edges weigh 1 except the closing edge, which makes the total -1 */
+    PairSet cycle_pairs;
+    if (pair_set_init(&cycle_pairs, length) != SUCCESS) {
+        free(cycle);
+        return ERROR_MEMORY_ALLOCATION;
+    }
+    for (int c = 0; c < length; c++) {
+        pair_set_insert(&cycle_pairs, (uint64_t)cycle[c] * (uint64_t)n + (uint64_t)cycle[(c + 1) % length]);
+    }
+
+    /* Drop background edges that coincide with the cycle, then append the cycle */
+    int64_t kept = 0;
+    for (int64_t e = 0; e < list->count; e++) {
+        const GeneratedEdge *edge = &list->edges[e];
+        if (!pair_set_contains(&cycle_pairs, (uint64_t)edge->from * (uint64_t)n + (uint64_t)edge->to)) {
+            list->edges[kept++] = *edge;
+        }
+    }
+    list->count = kept;
+    pair_set_free(&cycle_pairs);
+
+    for (int c = 0; c < length && status == SUCCESS; c++) {
+        double weight = (c == length - 1) ? -(double)length : 1.0;
+        status = edge_list_push(list, cycle[c], cycle[(c + 1) % length], weight);
+    }
+
+    free(cycle);
+    return status;
+}
+
+void graph_generator_default_config(GraphGeneratorConfig *config, GraphFamily family, int vertices, double density) {
+    if (!config) {
+        return;
+    }
+
+    memset(config, 0, sizeof(*config));
+    config->family = family;
+    config->vertices = vertices;
+    config->density = density;
+    config->seed = GENERATOR_DEFAULT_SEED;
+    config->min_weight = 1.0;
+    config->max_weight = 100.0;
+}
+
+const char* graph_family_name(GraphFamily family) {
+    if (family < 0 || family >= GRAPH_FAMILY_COUNT) {
+        return "unknown";
+    }
+    return family_names[family];
+}
+
+GraphFamily graph_family_from_name(const char *name) {
+    if (!name) {
+        return GRAPH_FAMILY_COUNT;
+    }
+
+    for (int f = 0; f < GRAPH_FAMILY_COUNT; f++) {
+        if (strcmp(name, family_names[f]) == 0) {
+            return (GraphFamily)f;
+        }
+    }
+    return GRAPH_FAMILY_COUNT;
+}
+
+ReturnCode graph_generate_edges(const GraphGeneratorConfig *config, EdgeList *list) {
+    if (!config || !list) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if (config->vertices <= 0 || config->density < 0.0 || config->density > 1.0 ||
+        config->edges < 0 || config->min_weight > config->max_weight) {
+        return ERROR_INVALID_INPUT;
+    }
+
+    memset(list, 0, sizeof(*list));
+
+    ReturnCode status;
+    switch (config->family) {
+        case GRAPH_FAMILY_ERDOS_RENYI:
+            status = generate_erdos_renyi(config, list);
+            break;
+        case GRAPH_FAMILY_GRID:
+            status = generate_grid(config, list);
+            break;
+        case GRAPH_FAMILY_RMAT:
+            status = generate_rmat(config, list);
+            break;
+        case GRAPH_FAMILY_LAYERED_DAG:
+            status = generate_layered_dag(config, list);
+            break;
+        case GRAPH_FAMILY_NEGATIVE_CYCLE:
+            status = generate_negative_cycle(config, list);
+            break;
+        default:
+            status = ERROR_INVALID_INPUT;
+            break;
+    }
+
+    if (status != SUCCESS) {
+        edge_list_free(list);
+    }
+    return status;
+}
+
+Graph* graph_generate(const GraphGeneratorConfig *config) {
+    EdgeList list;
+    if (graph_generate_edges(config, &list) != SUCCESS) {
+        return NULL;
+    }
+
+    Graph *graph = graph_create(config->vertices);
+    if (graph) {
+        for (int64_t e = 0; e < list.count; e++) {
+            graph_add_edge(graph, list.edges[e].from, list.edges[e].to, list.edges[e].weight);
+        }
+    }
+
+    edge_list_free(&list);
+    return graph;
+}
+
+static ReturnCode write_text_edges(FILE *file, const GraphGeneratorConfig *config, const EdgeList *list) {
+    fprintf(file, "%d\n%lld\n", config->vertices, (long long)list->count);
+    for (int64_t e = 0; e < list->count; e++) {
+        const GeneratedEdge *edge = &list->edges[e];
+        fprintf(file, "%d %d %.2f\n", edge->from, edge->to, edge->weight);
+    }
+    return ferror(file) ? ERROR_FILE_IO : SUCCESS;
+}
+
+static ReturnCode write_binary_edges(FILE *file, const GraphGeneratorConfig *config, const EdgeList *list) {
+    BinaryGraphHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, GRAPH_BINARY_MAGIC, 4);
+    header.version = GRAPH_BINARY_VERSION;
+    header.vertices = config->vertices;
+    header.edge_count = list->count;
+
+    if (fwrite(&header, sizeof(header), 1, file) != 1) {
+        return ERROR_FILE_IO;
+    }
+
+    BinaryEdgeRecord records[1024];
+    for (int64_t e = 0; e < list->count; ) {
+        size_t block = 0;
+        for (; block < 1024 && e < list->count; block++, e++) {
+            records[block].from = list->edges[e].from;
+            records[block].to = list->edges[e].to;
+            records[block].weight = list->edges[e].weight;
+        }
+        if (fwrite(records, sizeof(BinaryEdgeRecord), block, file) != block) {
+            return ERROR_FILE_IO;
+        }
+    }
+    return SUCCESS;
+}
+
+ReturnCode graph_generate_file(const GraphGeneratorConfig *config, const char *filename,
+                               GraphFileFormat format, int64_t *edges_written) {
+    if (!config || !filename) {
+        return ERROR_NULL_POINTER;
+    }
+
+    EdgeList list;
+    ReturnCode status = graph_generate_edges(config, &list);
+    if (status != SUCCESS) {
+        return status;
+    }
+
+    FILE *file = fopen(filename, format == GRAPH_FORMAT_BINARY ? "wb" : "w");
+    if (!file) {
+        edge_list_free(&list);
+        return ERROR_FILE_IO;
+    }
+    setvbuf(file, NULL, _IOFBF, WRITE_BUFFER_SIZE);
+
+    if (format == GRAPH_FORMAT_BINARY) {
+        status = write_binary_edges(file, config, &list);
+    } else {
+        status = write_text_edges(file, config, &list);
+    }
+
+    if (fclose(file) != 0 && status == SUCCESS) {
+        status = ERROR_FILE_IO;
+    }
+    if (edges_written) {
+        *edges_written = status == SUCCESS ? list.count : 0;
+    }
+
+    edge_list_free(&list);
+    return status;
+}
@@ -0,0 +1,59 @@
+#ifndef GRAPH_GENERATOR_H
+#define GRAPH_GENERATOR_H
+
+#include "../data_structures/graph.h"
+#include "file_io.h"
+#include <stdint.h>
+
+/* Seed used when the caller does not supply one */
+#define GENERATOR_DEFAULT_SEED 42ULL
+
+/* Graph families produced by the generator */
+typedef enum {
+    GRAPH_FAMILY_ERDOS_RENYI = 0,  /* Uniform random digraph with an exact edge count */
+    GRAPH_FAMILY_GRID,             /* Road-like 2D lattice, bidirectional links */
+    GRAPH_FAMILY_RMAT,             /* Recursive-matrix power-law digraph */
+    GRAPH_FAMILY_LAYERED_DAG,      /* Edges only from layer l to layer l+1 */
+    GRAPH_FAMILY_NEGATIVE_CYCLE,   /* Erdos-Renyi plus one planted negative cycle */
+    GRAPH_FAMILY_COUNT
+} GraphFamily;
+
+/* Generator parameters; zero-valued optional fields select defaults */
+typedef struct {
+    GraphFamily family;
+    int vertices;             /* Number of vertices (not limited by MAX_VERTICES) */
+    double density;           /* Edge probability / fraction of possible edges */
+    int64_t edges;            /* Exact edge target; 0 derives it from density */
+    uint64_t seed;            /* Output is identical for identical seeds */
+    double min_weight;        /* Integral weights drawn from [min_weight, max_weight] */
+    double max_weight;
+    int layers;               /* Layered DAG only; 0 selects sqrt(vertices) */
+    int cycle_length;         /* Negative cycle only; 0 selects 3 */
+} GraphGeneratorConfig;
+
+/* Generated edge list */
+typedef struct {
+    int from;
+    int to;
+    double weight;
+} GeneratedEdge;
+
+typedef struct {
+    GeneratedEdge *edges;
+    int64_t count;
+    int64_t capacity;
+} EdgeList;
+
+/* Configuration helpers */
+void graph_generator_default_config(GraphGeneratorConfig *config, GraphFamily family, int vertices, double density);
+const char* graph_family_name(GraphFamily family);
+GraphFamily graph_family_from_name(const char *name);
+
+/* Generation functions */
+ReturnCode graph_generate_edges(const GraphGeneratorConfig *config, EdgeList *list);
+Graph* graph_generate(const GraphGeneratorConfig *config);
+ReturnCode graph_generate_file(const GraphGeneratorConfig *config, const char *filename,
+                               GraphFileFormat format, int64_t *edges_written);
+void edge_list_free(EdgeList *list);
+
+#endif /* GRAPH_GENERATOR_H */
@@ -1,3 +1,5 @@
+#define _POSIX_C_SOURCE 200112L
+
 #include "memory_manager.h"
 #include <stdlib.h>
 #include <stdio.h>
@@ -7,6 +9,7 @@ static size_t total_allocated = 0;
 static size_t current_allocated = 0;
 static int allocation_count = 0;
 
+/* Rows are views into one contiguous rows x cols block owned by array[0] */
 double** allocate_2d_double(int rows, int cols) {
     if (rows <= 0 || cols <= 0) {
         return NULL;
@@ -17,16 +20,13 @@ double** allocate_2d_double(int rows, int cols) {
         return NULL;
     }
 
+    double *block = (double*)malloc((size_t)rows * (size_t)cols * sizeof(double));
+    if (!block) {
+        free(array);
+        return NULL;
+    }
     for (int i = 0; i < rows; i++) {
-        array[i] = (double*)malloc(cols * sizeof(double));
-        if (!array[i]) {
-            /* Free previously allocated memory on failure */
-            for (int j = 0; j < i; j++) {
-                free(array[j]);
-            }
-            free(array);
-            return NULL;
-        }
+        array[i] = block + (size_t)i * cols;
     }
 
     /* Update memory tracking */
@@ -48,16 +48,13 @@ int** allocate_2d_int(int rows, int cols) {
         return NULL;
     }
 
+    int *block = (int*)malloc((size_t)rows * (size_t)cols * sizeof(int));
+    if (!block) {
+        free(array);
+        return NULL;
+    }
     for (int i = 0; i < rows; i++) {
-        array[i] = (int*)malloc(cols * sizeof(int));
-        if (!array[i]) {
-            /* Free previously allocated memory on failure */
-            for (int j = 0; j < i; j++) {
-                free(array[j]);
-            }
-            free(array);
-            return NULL;
-        }
+        array[i] = block + (size_t)i * cols;
     }
 
     /* Update memory tracking */
@@ -74,11 +71,7 @@ void deallocate_2d_double(double **array, int rows) {
         return;
     }
 
-    for (int i = 0; i < rows; i++) {
-        if (array[i]) {
-            free(array[i]);
-        }
-    }
+    free(array[0]);
     free(array);
 
     /* Update memory tracking */
@@ -93,11 +86,7 @@ void deallocate_2d_int(int **array, int rows) {
         return;
     }
 
-    for (int i = 0; i < rows; i++) {
-        if (array[i]) {
-            free(array[i]);
-        }
-    }
+    free(array[0]);
     free(array);
 
     /* Update memory tracking */
@@ -107,6 +96,107 @@ void deallocate_2d_int(int **array, int rows) {
     }
 }
 
+size_t triangle_size(int n) {
+    return n > 0 ? (size_t)n * (size_t)(n + 1) / 2 : 0;
+}
+
+double* allocate_triangle_double(int n) {
+    if (n <= 0) {
+        return NULL;
+    }
+
+    size_t allocated_size = triangle_size(n) * sizeof(double);
+    double *array = (double*)malloc(allocated_size);
+    if (!array) {
+        return NULL;
+    }
+
+    /* Update memory tracking */
+    total_allocated += allocated_size;
+    current_allocated += allocated_size;
+    allocation_count++;
+
+    return array;
+}
+
+int* allocate_triangle_int(int n) {
+    if (n <= 0) {
+        return NULL;
+    }
+
+    size_t allocated_size = triangle_size(n) * sizeof(int);
+    int *array = (int*)malloc(allocated_size);
+    if (!array) {
+        return NULL;
+    }
+
+    /* Update memory tracking */
+    total_allocated += allocated_size;
+    current_allocated += allocated_size;
+    allocation_count++;
+
+    return array;
+}
+
+void deallocate_triangle_double(double *array, int n) {
+    if (!array) {
+        return;
+    }
+
+    free(array);
+
+    /* Update memory tracking */
+    size_t deallocated_size = triangle_size(n) * sizeof(double);
+    if (current_allocated >= deallocated_size) {
+        current_allocated -= deallocated_size;
+    }
+}
+
+void deallocate_triangle_int(int *array, int n) {
+    if (!array) {
+        return;
+    }
+
+    free(array);
+
+    /* Update memory tracking */
+    size_t deallocated_size = triangle_size(n) * sizeof(int);
+    if (current_allocated >= deallocated_size) {
+        current_allocated -= deallocated_size;
+    }
+}
+
+void* allocate_aligned(size_t size, size_t alignment) {
+    if (size == 0) {
+        return NULL;
+    }
+
+    void *array = NULL;
+    if (posix_memalign(&array, alignment, size) != 0) {
+        return NULL;
+    }
+
+    /* Update memory tracking */
+    total_allocated += size;
+    current_allocated += size;
+    allocation_count++;
+
+    return array;
+}
+
+void deallocate_aligned(void *array, size_t size) {
+    if (!array) {
+        return;
+    }
+
+    free(array);
+
+    /* Update memory tracking */
+    if (current_allocated >= size) {
+        current_allocated -= size;
+    }
+}
+
 size_t get_memory_usage(void) {
     return current_allocated;
 }
@@ -4,12 +4,23 @@
 #include <stddef.h>
 #include "../core/constants.h"
 
-/* 2D array allocation and deallocation functions */
+/* 2D array allocation and deallocation functions (rows point into one contiguous block) */
 double** allocate_2d_double(int rows, int cols);
 int** allocate_2d_int(int rows, int cols);
 void deallocate_2d_double(double **array, int rows);
 void deallocate_2d_int(int **array, int rows);
 
+/* Packed upper-triangle storage: n * (n + 1) / 2 contiguous elements */
+size_t triangle_size(int n);
+double* allocate_triangle_double(int n);
+int* allocate_triangle_int(int n);
+void deallocate_triangle_double(double *array, int n);
+void deallocate_triangle_int(int *array, int n);
+
+/* Aligned flat buffers (alignment: power of two, multiple of sizeof(void*)) */
+void* allocate_aligned(size_t size, size_t alignment);
+void deallocate_aligned(void *array, size_t size);
+
 /* Memory usage tracking functions */
 size_t get_memory_usage(void);
 void reset_memory_tracking(void);
@@ -0,0 +1,180 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include "trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Single completed span ("ph":"X" event in the Chrome format) */
+typedef struct {
+    const char *name;
+    const char *category;
+    uint64_t start_ns;
+    uint64_t duration_ns;
+    const char *arg_name;   /* Key of arg in the exported "args" object */
+    int arg;
+} TraceEvent;
+
+/* Per-thread ring buffer; only the owning thread writes to it */
+typedef struct {
+    TraceEvent *events;
+    uint64_t written;       /* Total events written, wraps into the ring */
+} TraceBuffer;
+
+bool trace_active = false;
+
+static TraceBuffer trace_buffers[TRACE_MAX_THREADS];
+static int trace_thread_count = 0;
+static int trace_capacity = 0;
+static uint64_t trace_origin_ns = 0;
+
+static int trace_thread_slot(void) {
+#ifdef _OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+}
+
+static int trace_max_threads(void) {
+#ifdef _OPENMP
+    int threads = omp_get_max_threads();
+    return threads < TRACE_MAX_THREADS ? threads : TRACE_MAX_THREADS;
+#else
+    return 1;
+#endif
+}
+
+uint64_t trace_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+ReturnCode trace_enable(int events_per_thread) {
+    if (events_per_thread <= 0) {
+        events_per_thread = TRACE_DEFAULT_CAPACITY;
+    }
+
+    trace_disable();
+
+    /* Buffers for every thread are allocated up front so recording never allocates */
+    trace_thread_count = trace_max_threads();
+    for (int t = 0; t < trace_thread_count; t++) {
+        trace_buffers[t].events = (TraceEvent*)malloc((size_t)events_per_thread * sizeof(TraceEvent));
+        if (!trace_buffers[t].events) {
+            trace_disable();
+            return ERROR_MEMORY_ALLOCATION;
+        }
+    }
+
+    trace_capacity = events_per_thread;
+    trace_origin_ns = trace_now_ns();
+    trace_active = true;
+    return SUCCESS;
+}
+
+void trace_disable(void) {
+    trace_active = false;
+
+    for (int t = 0; t < TRACE_MAX_THREADS; t++) {
+        free(trace_buffers[t].events);
+        trace_buffers[t].events = NULL;
+        trace_buffers[t].written = 0;
+    }
+    trace_thread_count = 0;
+    trace_capacity = 0;
+}
+
+void trace_reset(void) {
+    for (int t = 0; t < TRACE_MAX_THREADS; t++) {
+        trace_buffers[t].written = 0;
+    }
+    trace_origin_ns = trace_now_ns();
+}
+
+bool trace_is_enabled(void) {
+    return trace_active;
+}
+
+void trace_record(const char *name, const char *category, uint64_t start_ns, const char *arg_name, int arg) {
+    if (!trace_active || !name) {
+        return;
+    }
+
+    int slot = trace_thread_slot();
+    if (slot < 0 || slot >= trace_thread_count) {
+        return;
+    }
+
+    uint64_t end_ns = trace_now_ns();
+    TraceBuffer *buffer = &trace_buffers[slot];
+    TraceEvent *event = &buffer->events[buffer->written % (uint64_t)trace_capacity];
+
+    event->name = name;
+    event->category = category ? category : "default";
+    event->start_ns = start_ns;
+    event->duration_ns = end_ns - start_ns;
+    event->arg_name = arg_name ? arg_name : "arg";
+    event->arg = arg;
+    buffer->written++;
+}
+
+int trace_event_count(void) {
+    if (trace_capacity == 0) {
+        return 0;
+    }
+
+    uint64_t count = 0;
+    for (int t = 0; t < trace_thread_count; t++) {
+        uint64_t written = trace_buffers[t].written;
+        count += written < (uint64_t)trace_capacity ? written : (uint64_t)trace_capacity;
+    }
+    return (int)count;
+}
+
+ReturnCode trace_write_chrome_json(const char *filename) {
+    if (!filename) {
+        return ERROR_NULL_POINTER;
+    }
+
+    FILE *file = fopen(filename, "w");
+    if (!file) {
+        return ERROR_FILE_IO;
+    }
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    bool first = true;
+    for (int t = 0; t < trace_thread_count; t++) {
+        const TraceBuffer *buffer = &trace_buffers[t];
+        uint64_t written = buffer->written;
+        uint64_t begin = written > (uint64_t)trace_capacity ? written - (uint64_t)trace_capacity : 0;
+
+        for (uint64_t e = begin; e < written; e++) {
+            const TraceEvent *event = &buffer->events[e % (uint64_t)trace_capacity];
+            uint64_t offset_ns = event->start_ns > trace_origin_ns ? event->start_ns - trace_origin_ns : 0;
+            double ts_us = (double)offset_ns / 1000.0;
+            double dur_us = (double)event->duration_ns / 1000.0;
+
+            fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d",
+                    first ? "" : ",\n", event->name, event->category, ts_us, dur_us, t);
+            if (event->arg != TRACE_NO_ARG) {
+                fprintf(file, ",\"args\":{\"%s\":%d}", event->arg_name, event->arg);
+            }
+            fprintf(file, "}");
+            first = false;
+        }
+    }
+
+    fprintf(file, "\n]}\n");
+
+    if (fclose(file) != 0) {
+        return ERROR_FILE_IO;
+    }
+    return SUCCESS;
+}
@@ -0,0 +1,50 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include "../core/constants.h"
+
+/* Maximum number of threads with their own trace ring buffer */
+#define TRACE_MAX_THREADS 64
+
+/* Default number of events kept per thread (oldest events are overwritten) */
+#define TRACE_DEFAULT_CAPACITY 65536
+
+/* Argument value meaning "no argument attached to the span" */
+#define TRACE_NO_ARG -1
+
+/* Runtime switch, read inline so disabled spans cost a single branch */
+extern bool trace_active;
+
+/* Tracing control functions */
+ReturnCode trace_enable(int events_per_thread);
+void trace_disable(void);
+void trace_reset(void);
+bool trace_is_enabled(void);
+
+/* Event recording functions */
+uint64_t trace_now_ns(void);
+void trace_record(const char *name, const char *category, uint64_t start_ns, const char *arg_name, int arg);
+int trace_event_count(void);
+
+/* Export in Chrome trace_event JSON format (chrome://tracing, Perfetto) */
+ReturnCode trace_write_chrome_json(const char *filename);
+
+/*
+ * Span helpers. Names, categories and argument names must be string literals
+ * or otherwise outlive the trace; spans without an argument pass NULL and
+ * TRACE_NO_ARG. Compile with -DTRACE_DISABLED to remove them entirely.
+ */
+#ifdef TRACE_DISABLED
+#define TRACE_BEGIN(var) do { } while (0)
+#define TRACE_END(var, name, category, arg_name, arg) do { } while (0)
+#else
+#define TRACE_BEGIN(var) uint64_t var = trace_active ? trace_now_ns() : 0
+#define TRACE_END(var, name, category, arg_name, arg) do { \
+    if (var) { \
+        trace_record((name), (category), (var), (arg_name), (arg)); \
+    } \
+} while (0)
+#endif
+
+#endif /* TRACE_H */
@@ -0,0 +1,471 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "transport.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <semaphore.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+/* Bytes moved per hand-off on a shared memory channel */
+#define TRANSPORT_SHM_CHUNK 32768
+
+/* How often a blocked shared memory wait re-checks the abort flag */
+#define TRANSPORT_SHM_POLL_NS 100000000L
+
+/*
+ * One directed channel per ordered pair of ranks: a single chunk slot with
+ * "empty" and "filled" process-shared semaphores, so the sender and the
+ * receiver hand the slot back and forth.
+ */
+typedef struct {
+    sem_t empty;
+    sem_t filled;
+    size_t length;
+    unsigned char data[TRANSPORT_SHM_CHUNK];
+} ShmChannel;
+
+typedef struct {
+    volatile int aborted;
+    int size;
+} ShmHeader;
+
+struct TransportGroup {
+    TransportKind kind;
+    int size;
+
+    /* TRANSPORT_SHM: header followed by size * size channels */
+    void *segment;
+    size_t segment_size;
+
+    /* TRANSPORT_TCP: one listening socket per rank, bound before fork */
+    int *listen_fds;
+    unsigned short *ports;
+};
+
+typedef struct {
+    int *fds;                  /* Connected socket per peer (-1 for self) */
+} TcpState;
+
+static const char *transport_names[TRANSPORT_COUNT] = {
+    "shm",
+    "tcp"
+};
+
+const char* transport_kind_name(TransportKind kind) {
+    if (kind < 0 || kind >= TRANSPORT_COUNT) {
+        return "unknown";
+    }
+    return transport_names[kind];
+}
+
+TransportKind transport_kind_from_name(const char *name) {
+    if (!name) {
+        return TRANSPORT_COUNT;
+    }
+
+    for (int k = 0; k < TRANSPORT_COUNT; k++) {
+        if (strcmp(name, transport_names[k]) == 0) {
+            return (TransportKind)k;
+        }
+    }
+    return TRANSPORT_COUNT;
+}
+
+/* Shared memory transport */
+
+static ShmHeader* shm_header(TransportGroup *group) {
+    return (ShmHeader*)group->segment;
+}
+
+static ShmChannel* shm_channel(TransportGroup *group, int from, int to) {
+    ShmChannel *channels = (ShmChannel*)((char*)group->segment + sizeof(ShmChannel));
+    return channels + (size_t)from * group->size + to;
+}
+
+/* Block on a semaphore, giving up once any worker has aborted the group */
+static ReturnCode shm_wait(TransportGroup *group, sem_t *semaphore) {
+    while (!shm_header(group)->aborted) {
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += TRANSPORT_SHM_POLL_NS;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+
+        if (sem_timedwait(semaphore, &deadline) == 0) {
+            return SUCCESS;
+        }
+        if (errno != ETIMEDOUT && errno != EINTR) {
+            return ERROR_COMMUNICATION;
+        }
+    }
+    return ERROR_COMMUNICATION;
+}
+
+static ReturnCode shm_send(Transport *transport, int peer, const void *data, size_t length) {
+    TransportGroup *group = (TransportGroup*)transport->state;
+    ShmChannel *channel = shm_channel(group, transport->rank, peer);
+    const unsigned char *bytes = (const unsigned char*)data;
+
+    while (length > 0) {
+        if (shm_wait(group, &channel->empty) != SUCCESS) {
+            return ERROR_COMMUNICATION;
+        }
+        size_t chunk = length < TRANSPORT_SHM_CHUNK ? length : TRANSPORT_SHM_CHUNK;
+        memcpy(channel->data, bytes, chunk);
+        channel->length = chunk;
+        sem_post(&channel->filled);
+        bytes += chunk;
+        length -= chunk;
+    }
+    return SUCCESS;
+}
+
+static ReturnCode shm_recv(Transport *transport, int peer, void *data, size_t length) {
+    TransportGroup *group = (TransportGroup*)transport->state;
+    ShmChannel *channel = shm_channel(group, peer, transport->rank);
+    unsigned char *bytes = (unsigned char*)data;
+
+    while (length > 0) {
+        if (shm_wait(group, &channel->filled) != SUCCESS) {
+            return ERROR_COMMUNICATION;
+        }
+        size_t chunk = channel->length;
+        if (chunk > length) {
+            /* Sender and receiver disagree on the message size */
+            transport_group_abort(group);
+            return ERROR_COMMUNICATION;
+        }
+        memcpy(bytes, channel->data, chunk);
+        sem_post(&channel->empty);
+        bytes += chunk;
+        length -= chunk;
+    }
+    return SUCCESS;
+}
+
+static void shm_close(Transport *transport) {
+    free(transport);
+}
+
+static ReturnCode shm_group_init(TransportGroup *group) {
+    /* The name only lives until the mapping exists; forked workers inherit it */
+    char name[64];
+    snprintf(name, sizeof(name), "/floyd_warshall_%ld", (long)getpid());
+
+    size_t channels = (size_t)group->size * group->size;
+    group->segment_size = sizeof(ShmChannel) * (channels + 1);
+
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        return ERROR_COMMUNICATION;
+    }
+    shm_unlink(name);
+
+    if (ftruncate(fd, (off_t)group->segment_size) != 0) {
+        close(fd);
+        return ERROR_COMMUNICATION;
+    }
+
+    void *segment = mmap(NULL, group->segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (segment == MAP_FAILED) {
+        return ERROR_COMMUNICATION;
+    }
+    group->segment = segment;
+
+    /* The first channel-sized slot holds the header, keeping channels aligned */
+    shm_header(group)->aborted = 0;
+    shm_header(group)->size = group->size;
+    for (int from = 0; from < group->size; from++) {
+        for (int to = 0; to < group->size; to++) {
+            ShmChannel *channel = shm_channel(group, from, to);
+            if (sem_init(&channel->empty, 1, 1) != 0 || sem_init(&channel->filled, 1, 0) != 0) {
+                return ERROR_COMMUNICATION;
+            }
+        }
+    }
+
+    return SUCCESS;
+}
+
+/* TCP transport */
+
+static ReturnCode tcp_write_all(int fd, const void *data, size_t length) {
+    const unsigned char *bytes = (const unsigned char*)data;
+    while (length > 0) {
+        ssize_t written = send(fd, bytes, length, MSG_NOSIGNAL);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            return ERROR_COMMUNICATION;
+        }
+        bytes += written;
+        length -= (size_t)written;
+    }
+    return SUCCESS;
+}
+
+static ReturnCode tcp_read_all(int fd, void *data, size_t length) {
+    unsigned char *bytes = (unsigned char*)data;
+    while (length > 0) {
+        ssize_t received = recv(fd, bytes, length, 0);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            /* 0: the peer closed its end (it exited or aborted) */
+            return ERROR_COMMUNICATION;
+        }
+        bytes += received;
+        length -= (size_t)received;
+    }
+    return SUCCESS;
+}
+
+static ReturnCode tcp_send(Transport *transport, int peer, const void *data, size_t length) {
+    TcpState *state = (TcpState*)transport->state;
+    return tcp_write_all(state->fds[peer], data, length);
+}
+
+static ReturnCode tcp_recv(Transport *transport, int peer, void *data, size_t length) {
+    TcpState *state = (TcpState*)transport->state;
+    return tcp_read_all(state->fds[peer], data, length);
+}
+
+static void tcp_close(Transport *transport) {
+    TcpState *state = (TcpState*)transport->state;
+    for (int peer = 0; peer < transport->size; peer++) {
+        if (state->fds[peer] >= 0) {
+            close(state->fds[peer]);
+        }
+    }
+    free(state->fds);
+    free(state);
+    free(transport);
+}
+
+static ReturnCode tcp_group_init(TransportGroup *group) {
+    group->listen_fds = (int*)malloc((size_t)group->size * sizeof(int));
+    group->ports = (unsigned short*)calloc((size_t)group->size, sizeof(unsigned short));
+    if (!group->listen_fds || !group->ports) {
+        return ERROR_MEMORY_ALLOCATION;
+    }
+    for (int rank = 0; rank < group->size; rank++) {
+        group->listen_fds[rank] = -1;
+    }
+
+    /* Ephemeral ports on the loopback; connects succeed before the peer accepts */
+    for (int rank = 0; rank < group->size; rank++) {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) {
+            return ERROR_COMMUNICATION;
+        }
+        group->listen_fds[rank] = fd;
+
+        struct sockaddr_in address;
+        socklen_t address_length = sizeof(address);
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        if (bind(fd, (struct sockaddr*)&address, sizeof(address)) != 0 ||
+            listen(fd, group->size) != 0 ||
+            getsockname(fd, (struct sockaddr*)&address, &address_length) != 0) {
+            return ERROR_COMMUNICATION;
+        }
+        group->ports[rank] = ntohs(address.sin_port);
+    }
+
+    return SUCCESS;
+}
+
+/*
+ * Full mesh: every rank connects to the ranks below it and accepts the ones
+ * above it. The connecting side announces its rank as the first message.
+ */
+static ReturnCode tcp_connect_mesh(TransportGroup *group, int rank, int *fds) {
+    int one = 1;
+
+    for (int peer = 0; peer < rank; peer++) {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) {
+            return ERROR_COMMUNICATION;
+        }
+        fds[peer] = fd;
+
+        struct sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(group->ports[peer]);
+        if (connect(fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+            return ERROR_COMMUNICATION;
+        }
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        if (tcp_write_all(fd, &rank, sizeof(rank)) != SUCCESS) {
+            return ERROR_COMMUNICATION;
+        }
+    }
+
+    for (int accepted = rank + 1; accepted < group->size; accepted++) {
+        int fd = accept(group->listen_fds[rank], NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                accepted--;
+                continue;
+            }
+            return ERROR_COMMUNICATION;
+        }
+
+        int peer = -1;
+        if (tcp_read_all(fd, &peer, sizeof(peer)) != SUCCESS ||
+            peer <= rank || peer >= group->size || fds[peer] >= 0) {
+            close(fd);
+            return ERROR_COMMUNICATION;
+        }
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        fds[peer] = fd;
+    }
+
+    return SUCCESS;
+}
+
+static Transport* tcp_attach(TransportGroup *group, Transport *transport, int rank) {
+    TcpState *state = (TcpState*)malloc(sizeof(TcpState));
+    int *fds = (int*)malloc((size_t)group->size * sizeof(int));
+    if (!state || !fds) {
+        free(state);
+        free(fds);
+        free(transport);
+        return NULL;
+    }
+    for (int peer = 0; peer < group->size; peer++) {
+        fds[peer] = -1;
+    }
+    state->fds = fds;
+    transport->state = state;
+    transport->send = tcp_send;
+    transport->recv = tcp_recv;
+    transport->close = tcp_close;
+
+    /* Other ranks' listening sockets were inherited through fork; drop them */
+    for (int other = 0; other < group->size; other++) {
+        if (other != rank && group->listen_fds[other] >= 0) {
+            close(group->listen_fds[other]);
+            group->listen_fds[other] = -1;
+        }
+    }
+
+    ReturnCode connected = tcp_connect_mesh(group, rank, fds);
+    close(group->listen_fds[rank]);
+    group->listen_fds[rank] = -1;
+
+    if (connected != SUCCESS) {
+        tcp_close(transport);
+        return NULL;
+    }
+    return transport;
+}
+
+/* Group management */
+
+TransportGroup* transport_group_create(TransportKind kind, int size) {
+    if (kind < 0 || kind >= TRANSPORT_COUNT || size <= 0 || size > FW_DISTRIBUTED_MAX_PROCESSES) {
+        return NULL;
+    }
+
+    TransportGroup *group = (TransportGroup*)calloc(1, sizeof(TransportGroup));
+    if (!group) {
+        return NULL;
+    }
+    group->kind = kind;
+    group->size = size;
+
+    ReturnCode status = (kind == TRANSPORT_SHM) ? shm_group_init(group) : tcp_group_init(group);
+    if (status != SUCCESS) {
+        transport_group_destroy(group);
+        return NULL;
+    }
+
+    return group;
+}
+
+void transport_group_destroy(TransportGroup *group) {
+    if (!group) {
+        return;
+    }
+
+    if (group->segment) {
+        for (int from = 0; from < group->size; from++) {
+            for (int to = 0; to < group->size; to++) {
+                ShmChannel *channel = shm_channel(group, from, to);
+                sem_destroy(&channel->empty);
+                sem_destroy(&channel->filled);
+            }
+        }
+        munmap(group->segment, group->segment_size);
+    }
+
+    if (group->listen_fds) {
+        for (int rank = 0; rank < group->size; rank++) {
+            if (group->listen_fds[rank] >= 0) {
+                close(group->listen_fds[rank]);
+            }
+        }
+    }
+    free(group->listen_fds);
+    free(group->ports);
+    free(group);
+}
+
+void transport_group_abort(TransportGroup *group) {
+    if (!group) {
+        return;
+    }
+
+    /* TCP peers notice through the closed sockets once the worker exits */
+    if (group->segment) {
+        shm_header(group)->aborted = 1;
+    }
+}
+
+Transport* transport_attach(TransportGroup *group, int rank) {
+    if (!group || rank < 0 || rank >= group->size) {
+        return NULL;
+    }
+
+    Transport *transport = (Transport*)malloc(sizeof(Transport));
+    if (!transport) {
+        return NULL;
+    }
+    transport->rank = rank;
+    transport->size = group->size;
+
+    if (group->kind == TRANSPORT_TCP) {
+        return tcp_attach(group, transport, rank);
+    }
+
+    transport->state = group;
+    transport->send = shm_send;
+    transport->recv = shm_recv;
+    transport->close = shm_close;
+    return transport;
+}
+
+void transport_close(Transport *transport) {
+    if (transport) {
+        transport->close(transport);
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include <stddef.h>
+#include "../core/constants.h"
+
+/*
+ * Point-to-point message transport between the worker processes of a
+ * distributed run. A TransportGroup is created once by the launcher before
+ * the workers are forked; every worker then attaches to it with its rank.
+ * Messages between a pair of ranks arrive in the order they were sent and
+ * send/recv block until the whole buffer has been transferred.
+ */
+typedef enum {
+    TRANSPORT_SHM = 0,         /* POSIX shared memory channels (local processes) */
+    TRANSPORT_TCP,             /* TCP sockets on 127.0.0.1 (stand-in for separate nodes) */
+    TRANSPORT_COUNT
+} TransportKind;
+
+typedef struct TransportGroup TransportGroup;
+typedef struct Transport Transport;
+
+struct Transport {
+    int rank;                  /* This worker, 0..size-1 */
+    int size;                  /* Number of workers */
+    ReturnCode (*send)(Transport *transport, int peer, const void *data, size_t length);
+    ReturnCode (*recv)(Transport *transport, int peer, void *data, size_t length);
+    void (*close)(Transport *transport);
+    void *state;               /* Implementation specific */
+};
+
+/* Group setup (launcher, before fork) and teardown (launcher, after the workers exit) */
+TransportGroup* transport_group_create(TransportKind kind, int size);
+void transport_group_destroy(TransportGroup *group);
+
+/* Per-worker endpoint (after fork); the group must outlive it */
+Transport* transport_attach(TransportGroup *group, int rank);
+void transport_close(Transport *transport);
+
+/* Mark the group as failed so that peers blocked in recv/send give up */
+void transport_group_abort(TransportGroup *group);
+
+/* Transport names used on the command line */
+const char* transport_kind_name(TransportKind kind);
+TransportKind transport_kind_from_name(const char *name);
+
+#endif /* TRANSPORT_H */
@@ -58,5 +58,10 @@ void run_graph_tests(void);
 void run_floyd_warshall_tests(void);
 void run_memory_tests(void);
 void run_file_io_tests(void);
+void run_trace_tests(void);
+void run_generator_tests(void);
+void run_transitive_closure_tests(void);
+void run_minplus_gemm_tests(void);
+void run_symmetric_tests(void);
 
 #endif /* TEST_FRAMEWORK_H */
\ No newline at end of file
@@ -1,7 +1,13 @@
 #include "test_framework.h"
 #include "../src/core/floyd_warshall.h"
+#include "../src/core/transitive_closure.h"
+#include "../src/core/minplus_gemm.h"
+#include "../src/core/solver.h"
 #include "../src/utils/file_io.h"
 #include "../src/utils/memory_manager.h"
+#include "../src/utils/trace.h"
+#include "../src/utils/graph_generator.h"
+#include <string.h>
 #include <stdlib.h>
 
 /* Graph tests */
@@ -55,10 +61,175 @@ void test_graph_edge_operations(void) {
     graph_destroy(graph);
 }
 
+void test_graph_copy_and_snapshot(void) {
+    printf("\n=== Graph Copy and Snapshot Tests ===\n");
+
+    Graph *base = graph_create(200);
+    graph_add_edge(base, 0, 1, 1.0);
+    graph_add_edge(base, 1, 199, 2.0);
+    graph_add_edge(base, 150, 3, 4.0);
+
+    Graph *copy = graph_copy(base);
+    ASSERT(copy && copy->storage == GRAPH_STORAGE_HEAP, "Copy is a heap graph");
+    ASSERT(copy->distance[199] == copy->distance[0] + 199 * 200, "Copy rows are contiguous");
+    ASSERT(memcmp(copy->distance[0], base->distance[0], 200 * 200 * sizeof(double)) == 0 &&
+           memcmp(copy->next[0], base->next[0], 200 * 200 * sizeof(int)) == 0, "Copy matches original");
+    graph_destroy(copy);
+
+    /* Snapshots share the image until written; writes stay private */
+    GraphImage *image = graph_image_create(base);
+    ASSERT(image != NULL, "Create graph image");
+    Graph *scenario = graph_snapshot(image);
+    Graph *untouched = graph_snapshot(image);
+    ASSERT(scenario && untouched && scenario->storage == GRAPH_STORAGE_MAPPED, "Take snapshots");
+    graph_image_destroy(image);
+
+    graph_add_edge(scenario, 199, 150, 0.5);
+    floyd_warshall_execute(scenario);
+    ASSERT_DOUBLE_EQUAL(7.5, floyd_warshall_get_distance(scenario, 0, 3), EPSILON, "Scenario solves on its snapshot");
+    ASSERT(graph_get_edge(untouched, 199, 150) >= INFINITY_VALUE, "Other snapshot unaffected");
+    ASSERT(graph_get_edge(base, 199, 150) >= INFINITY_VALUE, "Base graph unaffected");
+    ASSERT_DOUBLE_EQUAL(2.0, graph_get_edge(untouched, 1, 199), EPSILON, "Snapshot outlives its image");
+
+    /* Copies of mapped and externally owned graphs */
+    Graph *from_snapshot = graph_copy(scenario);
+    ASSERT_DOUBLE_EQUAL(7.5, floyd_warshall_get_distance(from_snapshot, 0, 3), EPSILON, "Copy of a snapshot");
+    Solver *solver = solver_create(200, FW_ENGINE_STANDARD);
+    solver_load_graph(solver, base);
+    Graph *from_solver = graph_copy(solver_graph(solver));
+    ASSERT(from_solver && memcmp(from_solver->distance[0], base->distance[0], 200 * 200 * sizeof(double)) == 0,
+           "Copy of padded solver rows");
+    graph_destroy(solver_graph(solver));
+    solver_destroy(solver);
+
+    graph_destroy(from_solver);
+    graph_destroy(from_snapshot);
+    graph_destroy(scenario);
+    graph_destroy(untouched);
+    graph_destroy(base);
+}
+
+/* Solve csr with engine and compare against the reference kernel on the expanded graph */
+static bool csr_matches_reference(const CsrGraph *csr, FloydWarshallEngine engine) {
+    Graph *reference = graph_create(csr->vertices);
+    Graph *candidate = graph_create(csr->vertices);
+    if (!reference || !candidate) {
+        graph_destroy(reference);
+        graph_destroy(candidate);
+        return false;
+    }
+
+    csr_graph_expand(csr, reference);
+    floyd_warshall_execute_engine(reference, FW_ENGINE_STANDARD);
+    FloydWarshallResult result = floyd_warshall_execute_csr(csr, engine, candidate);
+
+    bool match = result.success;
+    for (int i = 0; i < csr->vertices && match; i++) {
+        for (int j = 0; j < csr->vertices && match; j++) {
+            if (fabs(reference->distance[i][j] - candidate->distance[i][j]) > 1e-6) {
+                match = false;
+            }
+        }
+    }
+
+    graph_destroy(reference);
+    graph_destroy(candidate);
+    return match;
+}
+
+void test_csr_graph(void) {
+    printf("\n=== CSR Graph Tests ===\n");
+
+    /* 0 -> 1 (twice), 0 -> 2, 1 -> 2, 2 -> 2 (ignored self-loop) */
+    int row_ptr[] = {0, 3, 4, 5, 5};
+    int col_idx[] = {1, 2, 1, 2, 2};
+    double weights[] = {4.0, 7.0, 1.5, 2.0, 3.0};
+    CsrGraph *csr = csr_graph_wrap(4, row_ptr, col_idx, weights);
+    ASSERT(csr != NULL, "Wrap caller-owned CSR arrays");
+    ASSERT(csr->col_idx == col_idx && csr->weights == weights && !csr->owns_arrays, "CSR arrays referenced, not copied");
+    ASSERT_EQUAL(5, csr->edges, "CSR edge count");
+
+    Graph *graph = graph_create(4);
+    ASSERT_EQUAL(SUCCESS, csr_graph_expand(csr, graph), "Expand CSR to dense");
+    ASSERT_DOUBLE_EQUAL(1.5, graph_get_edge(graph, 0, 1), EPSILON, "Expanded parallel edge keeps lighter weight");
+    ASSERT_DOUBLE_EQUAL(0.0, graph_get_edge(graph, 2, 2), EPSILON, "Non-negative self-loop ignored");
+    ASSERT(!graph_has_edge(graph, 3, 0), "Expanded graph has no extra edges");
+
+    FloydWarshallResult result = floyd_warshall_execute_csr(csr, FW_ENGINE_COUNT, graph);
+    ASSERT(result.success, "Execute from CSR");
+    ASSERT_DOUBLE_EQUAL(3.5, floyd_warshall_get_distance(graph, 0, 2), EPSILON, "CSR distance (0,2)");
+    csr_graph_destroy(csr);
+    graph_destroy(graph);
+
+    int bad_rows[] = {0, 2, 1, 3, 3};
+    int bad_columns[] = {1, 4, 0};
+    ASSERT(csr_graph_wrap(4, bad_rows, col_idx, weights) == NULL, "Decreasing row_ptr rejected");
+    ASSERT(csr_graph_wrap(4, row_ptr, bad_columns, weights) == NULL, "Out-of-range column rejected");
+    int from[] = {0, 4};
+    int to[] = {1, 0};
+    ASSERT(csr_graph_from_edges(4, from, to, NULL, 2) == NULL, "Out-of-range edge rejected");
+
+    /* Edge arrays over more than FW_SMALL_MAX_VERTICES vertices, one graph per dispatch path */
+    int n = 90;
+    int count = 4 * n;
+    int *sources = (int*)malloc((size_t)count * sizeof(int));
+    int *targets = (int*)malloc((size_t)count * sizeof(int));
+    double *costs = (double*)malloc((size_t)count * sizeof(double));
+    for (int e = 0; e < count; e++) {
+        int u = e % n;
+        int v = (u + 1 + (e * 13) % 7) % n;
+        sources[e] = u;
+        targets[e] = v;
+        costs[e] = 1.0 + (e * 5) % 9;
+    }
+    csr = csr_graph_from_edges(n, sources, targets, costs, count);
+    ASSERT(csr != NULL && csr->owns_arrays && csr->row_ptr[n] == count, "CSR built from edge array");
+    bool rows_grouped = true;
+    for (int u = 0; csr && u < n; u++) {
+        for (int e = csr->row_ptr[u]; e < csr->row_ptr[u + 1]; e++) {
+            bool found = false;
+            for (int k = 0; k < count && !found; k++) {
+                found = sources[k] == u && targets[k] == csr->col_idx[e] && costs[k] == csr->weights[e];
+            }
+            rows_grouped = rows_grouped && found;
+        }
+    }
+    ASSERT(rows_grouped, "Edges grouped under their source");
+    ASSERT(csr_matches_reference(csr, FW_ENGINE_COUNT), "Cyclic CSR graph expanded and dispatched");
+    ASSERT(csr_matches_reference(csr, FW_ENGINE_BLOCKED), "CSR graph through a dense engine");
+    csr_graph_destroy(csr);
+
+    /* Unit weights (weights == NULL) go to BFS */
+    csr = csr_graph_from_edges(n, sources, targets, NULL, count);
+    ASSERT(floyd_warshall_uniform_weight_csr(csr, NULL), "Unit weights detected on CSR");
+    ASSERT(csr_matches_reference(csr, FW_ENGINE_COUNT), "Unit-weight CSR graph matches reference");
+    csr_graph_destroy(csr);
+
+    /* Forward edges with negative weights go to the DAG engine */
+    for (int e = 0; e < count; e++) {
+        int u = sources[e] < targets[e] ? sources[e] : targets[e];
+        int v = sources[e] < targets[e] ? targets[e] : sources[e];
+        sources[e] = u;
+        targets[e] = v;
+        costs[e] -= 4.5;
+    }
+    csr = csr_graph_from_edges(n, sources, targets, costs, count);
+    ASSERT(floyd_warshall_topological_order_csr(csr, NULL), "Acyclic CSR graph detected");
+    ASSERT(csr_matches_reference(csr, FW_ENGINE_COUNT), "Acyclic CSR graph matches reference");
+    ASSERT(csr_matches_reference(csr, FW_ENGINE_DAG), "DAG engine reads CSR");
+    csr_graph_destroy(csr);
+
+    free(sources);
+    free(targets);
+    free(costs);
+}
+
 void run_graph_tests(void) {
     printf("Starting Graph Tests...\n");
     test_graph_creation();
     test_graph_edge_operations();
+    test_graph_copy_and_snapshot();
+    test_csr_graph();
 }
 
 /* Floyd-Warshall algorithm tests */
@@ -101,6 +272,71 @@ void test_negative_cycle_detection(void) {
     graph_destroy(graph);
 }
 
+void test_negative_cycle_extraction(void) {
+    printf("\n=== Negative Cycle Extraction Tests ===\n");
+
+    /* 0 -> 1 -> [2 -> 3 -> 4 -> 2] -> 5, plus an unrelated edge 6 -> 7 */
+    Graph *graph = graph_create(8);
+    graph_add_edge(graph, 0, 1, 2.0);
+    graph_add_edge(graph, 1, 2, 2.0);
+    graph_add_edge(graph, 2, 3, 1.0);
+    graph_add_edge(graph, 3, 4, -3.0);
+    graph_add_edge(graph, 4, 2, 1.0);
+    graph_add_edge(graph, 4, 5, 4.0);
+    graph_add_edge(graph, 6, 7, 1.0);
+    Graph *copy = graph_copy(graph);
+
+    NegativeCycleInfo info;
+    negative_cycle_info_init(&info);
+    FloydWarshallResult result = floyd_warshall_execute_checked(graph, FW_NEGATIVE_CYCLE_COMPLETE, &info);
+    ASSERT(result.success && result.has_negative_cycle, "Checked kernel reports the cycle");
+    ASSERT_EQUAL(3, info.cycle_length, "Extracted cycle length");
+    int cycle_sum = 0;
+    for (int t = 0; t < info.cycle_length; t++) {
+        cycle_sum += info.cycle[t];
+    }
+    ASSERT_EQUAL(2 + 3 + 4, cycle_sum, "Extracted cycle vertices");
+    ASSERT(info.weight_bound < 0.0, "Cycle weight bound is negative");
+    /* Sources {0..4} reach the cycle, which reaches {2..5} */
+    ASSERT_EQUAL(20, (int)info.unbounded_pairs, "Unbounded pair count");
+    ASSERT(negative_cycle_is_unbounded(&info, 0, 5), "Pair through the cycle is -inf");
+    ASSERT(!negative_cycle_is_unbounded(&info, 5, 2), "Pair after the cycle is bounded");
+    ASSERT(!negative_cycle_is_unbounded(&info, 6, 7), "Unrelated pair is bounded");
+    negative_cycle_info_free(&info);
+
+    /* Yes/no mode stops before running every pivot */
+    result = floyd_warshall_execute_checked(copy, FW_NEGATIVE_CYCLE_ABORT, NULL);
+    ASSERT(result.has_negative_cycle, "Abort mode reports the cycle");
+    ASSERT(result.iterations < 8 * 8 * 8, "Abort mode stops early");
+    graph_destroy(copy);
+    graph_destroy(graph);
+
+    /* On a generated graph the extracted cycle uses real edges and is negative */
+    GraphGeneratorConfig config;
+    graph_generator_default_config(&config, GRAPH_FAMILY_NEGATIVE_CYCLE, 80, 0.05);
+    graph = graph_generate(&config);
+    copy = graph_copy(graph);
+    negative_cycle_info_init(&info);
+    floyd_warshall_execute_checked(graph, FW_NEGATIVE_CYCLE_COMPLETE, &info);
+    ASSERT(info.found && info.cycle_length > 0, "Generated cycle extracted");
+
+    double weight = 0.0;
+    bool edges_exist = true;
+    for (int t = 0; t < info.cycle_length; t++) {
+        int from = info.cycle[t];
+        int to = info.cycle[(t + 1) % info.cycle_length];
+        if (!graph_has_edge(copy, from, to)) {
+            edges_exist = false;
+        }
+        weight += graph_get_edge(copy, from, to);
+    }
+    ASSERT(edges_exist, "Extracted cycle follows graph edges");
+    ASSERT(weight < 0.0 && weight >= info.weight_bound - 1e-6, "Extracted cycle weight within bound");
+    negative_cycle_info_free(&info);
+    graph_destroy(copy);
+    graph_destroy(graph);
+}
+
 void test_path_reconstruction(void) {
     printf("\n=== Path Reconstruction Tests ===\n");
 
@@ -129,11 +365,1228 @@ void test_path_reconstruction(void) {
     graph_destroy(graph);
 }
 
+void test_engine_registry(void) {
+    printf("\n=== Engine Registry Tests ===\n");
+
+    for (int e = 0; e < FW_ENGINE_COUNT; e++) {
+        const char *name = floyd_warshall_engine_name((FloydWarshallEngine)e);
+        ASSERT_EQUAL(e, (int)floyd_warshall_engine_from_name(name), "Engine name round trip");
+    }
+    ASSERT(floyd_warshall_engine_from_name("no-such-engine") == FW_ENGINE_COUNT, "Unknown engine name rejected");
+
+    Graph *graph = graph_create(3);
+    graph_add_edge(graph, 0, 1, 2.0);
+    graph_add_edge(graph, 1, 2, 2.0);
+    FloydWarshallResult result = floyd_warshall_execute_engine(graph, FW_ENGINE_STANDARD);
+    ASSERT(result.success, "Execute through engine registry");
+    ASSERT_DOUBLE_EQUAL(4.0, floyd_warshall_get_distance(graph, 0, 2), EPSILON, "Registry engine distance (0,2)");
+
+    result = floyd_warshall_execute_engine(graph, FW_ENGINE_COUNT);
+    ASSERT(!result.success, "Invalid engine fails");
+
+    graph_destroy(graph);
+}
+
+/* Compare an engine against the reference kernel on a generated graph */
+static bool engine_matches_reference(FloydWarshallEngine engine, GraphFamily family,
+                                     int vertices, double density, bool compare_next) {
+    GraphGeneratorConfig config;
+    graph_generator_default_config(&config, family, vertices, density);
+
+    Graph *reference = graph_generate(&config);
+    Graph *candidate = graph_copy(reference);
+    if (!reference || !candidate) {
+        graph_destroy(reference);
+        graph_destroy(candidate);
+        return false;
+    }
+
+    floyd_warshall_execute_engine(reference, FW_ENGINE_STANDARD);
+    FloydWarshallResult result = floyd_warshall_execute_engine(candidate, engine);
+
+    bool match = result.success;
+    for (int i = 0; i < vertices && match; i++) {
+        for (int j = 0; j < vertices && match; j++) {
+            if (fabs(reference->distance[i][j] - candidate->distance[i][j]) > 1e-6 ||
+                (compare_next && reference->next[i][j] != candidate->next[i][j])) {
+                match = false;
+            }
+        }
+    }
+
+    graph_destroy(reference);
+    graph_destroy(candidate);
+    return match;
+}
+
+/* Every finite pair's next hops arrive at the target within n hops */
+static bool next_hops_reach_targets(const Graph *graph) {
+    int n = graph->vertices;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (graph->distance[i][j] >= INFINITY_VALUE) {
+                continue;
+            }
+            int current = i;
+            for (int hops = 0; current != j && current >= 0 && hops < n; hops++) {
+                current = graph->next[current][j];
+            }
+            if (current != j) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*
+ * Random graph with weights in [-1, 4]: for the seeds used below it has
+ * zero-weight cycles but no negative one, so equal-length routes tie and
+ * a kernel that breaks ties out of pivot order can leave hops going round.
+ */
+static Graph* zero_cycle_graph(int vertices, uint64_t seed) {
+    GraphGeneratorConfig config;
+    graph_generator_default_config(&config, GRAPH_FAMILY_ERDOS_RENYI, vertices, 0.03);
+    config.seed = seed;
+    config.min_weight = -1.0;
+    config.max_weight = 4.0;
+    return graph_generate(&config);
+}
+
+/* Engine distances match the reference on a zero-cycle graph and its hops reach every target */
+static bool engine_hops_valid(FloydWarshallEngine engine, Graph *edges) {
+    Graph *reference = graph_copy(edges);
+    Graph *candidate = graph_copy(edges);
+    if (!reference || !candidate) {
+        graph_destroy(reference);
+        graph_destroy(candidate);
+        return false;
+    }
+
+    FloydWarshallResult expected = floyd_warshall_execute_engine(reference, FW_ENGINE_STANDARD);
+    FloydWarshallResult result = floyd_warshall_execute_engine(candidate, engine);
+
+    bool valid = expected.success && !expected.has_negative_cycle && result.success;
+    for (int i = 0; i < edges->vertices && valid; i++) {
+        for (int j = 0; j < edges->vertices && valid; j++) {
+            valid = fabs(reference->distance[i][j] - candidate->distance[i][j]) <= 1e-6;
+        }
+    }
+    valid = valid && next_hops_reach_targets(candidate);
+
+    graph_destroy(reference);
+    graph_destroy(candidate);
+    return valid;
+}
+
+void test_pruned_engine(void) {
+    printf("\n=== Pruned Engine Tests ===\n");
+
+    ASSERT(engine_matches_reference(FW_ENGINE_PRUNED, GRAPH_FAMILY_ERDOS_RENYI, 60, 0.05, true),
+           "Pruned engine matches reference on sparse graph");
+    ASSERT(engine_matches_reference(FW_ENGINE_PRUNED, GRAPH_FAMILY_LAYERED_DAG, 60, 0.3, true),
+           "Pruned engine matches reference on layered DAG");
+    ASSERT(engine_matches_reference(FW_ENGINE_PRUNED, GRAPH_FAMILY_ERDOS_RENYI, 40, 0.5, true),
+           "Pruned engine matches reference on dense graph");
+
+    /* Two disconnected components: cross pairs are never visited */
+    Graph *graph = graph_create(6);
+    graph_add_edge(graph, 0, 1, 1.0);
+    graph_add_edge(graph, 1, 2, 1.0);
+    graph_add_edge(graph, 3, 4, 1.0);
+    graph_add_edge(graph, 4, 5, 1.0);
+    FloydWarshallResult result = floyd_warshall_execute_pruned(graph);
+    ASSERT(result.success, "Pruned engine execution success");
+    ASSERT(result.iterations < 6 * 6 * 6, "Pruned engine skips unreachable work");
+    ASSERT_DOUBLE_EQUAL(2.0, floyd_warshall_get_distance(graph, 3, 5), EPSILON, "Pruned distance (3,5)");
+    ASSERT_DOUBLE_EQUAL(INFINITY_VALUE, floyd_warshall_get_distance(graph, 0, 5), EPSILON, "Pruned unreachable pair");
+    graph_destroy(graph);
+}
+
+void test_blocked_engine(void) {
+    printf("\n=== Blocked Engine Tests ===\n");
+
+    ASSERT(engine_matches_reference(FW_ENGINE_BLOCKED, GRAPH_FAMILY_ERDOS_RENYI, 150, 0.05, false),
+           "Blocked engine matches reference on random graph");
+    ASSERT(engine_matches_reference(FW_ENGINE_BLOCKED, GRAPH_FAMILY_GRID, 200, 0.8, false),
+           "Blocked engine matches reference on grid graph");
+
+    Graph *zero_cycles = zero_cycle_graph(83, 41);
+    ASSERT(engine_hops_valid(FW_ENGINE_BLOCKED, zero_cycles), "Blocked engine hops reach targets on zero-weight cycles");
+    Solver *solver = solver_create(83, FW_ENGINE_COUNT);
+    ASSERT(solver && solver_load_graph(solver, zero_cycles) == SUCCESS && solver_run(solver).success,
+           "Solver run on zero-weight cycles");
+    ASSERT(solver && next_hops_reach_targets(solver_graph(solver)), "Solver hops reach targets on zero-weight cycles");
+    solver_destroy(solver);
+    graph_destroy(zero_cycles);
+
+    /* Two components of 2 * FW_TILE_SIZE vertices each: cross tiles stay infinite */
+    int half = 2 * FW_TILE_SIZE;
+    Graph *graph = graph_create(2 * half);
+    for (int v = 0; v + 1 < half; v++) {
+        graph_add_edge(graph, v, v + 1, 1.0);
+        graph_add_edge(graph, half + v + 1, half + v, 1.0);
+    }
+
+    FloydWarshallResult result = floyd_warshall_execute_blocked(graph);
+    ASSERT(result.success, "Blocked engine execution success");
+    ASSERT(result.tiles_skipped > 0, "All-infinite tiles skipped");
+    ASSERT_DOUBLE_EQUAL((double)(half - 1), floyd_warshall_get_distance(graph, 0, half - 1), EPSILON,
+                        "Blocked chain distance");
+    ASSERT_DOUBLE_EQUAL(INFINITY_VALUE, floyd_warshall_get_distance(graph, 0, half), EPSILON,
+                        "Blocked cross-component pair unreachable");
+
+    int path_length;
+    int *path = floyd_warshall_get_path(graph, 2 * half - 1, half, &path_length);
+    ASSERT(path != NULL && path_length == half, "Blocked engine path reconstruction");
+    free(path);
+
+    graph_destroy(graph);
+}
+
+void test_recursive_engine(void) {
+    printf("\n=== Recursive Engine Tests ===\n");
+
+    ASSERT(engine_matches_reference(FW_ENGINE_RECURSIVE, GRAPH_FAMILY_ERDOS_RENYI, 150, 0.05, false),
+           "Recursive engine matches reference on random graph");
+    ASSERT(engine_matches_reference(FW_ENGINE_RECURSIVE, GRAPH_FAMILY_GRID, 100, 0.8, false),
+           "Recursive engine matches reference on grid graph");
+
+    Graph *zero_cycles = zero_cycle_graph(83, 18);
+    ASSERT(engine_hops_valid(FW_ENGINE_RECURSIVE, zero_cycles),
+           "Recursive engine hops reach targets on zero-weight cycles");
+    graph_destroy(zero_cycles);
+
+    /* Row-major layout and Morton layout agree, and every path costs its distance */
+    GraphGeneratorConfig config;
+    graph_generator_default_config(&config, GRAPH_FAMILY_ERDOS_RENYI, 97, 0.04);
+    Graph *edges = graph_generate(&config);
+    Graph *morton = graph_copy(edges);
+    Graph *row_major = graph_copy(edges);
+
+    FloydWarshallResult result = floyd_warshall_execute_recursive_layout(morton, FW_LAYOUT_MORTON);
+    ASSERT(result.success, "Recursive engine Morton layout success");
+    result = floyd_warshall_execute_recursive_layout(row_major, FW_LAYOUT_ROW_MAJOR);
+    ASSERT(result.success, "Recursive engine row-major layout success");
+
+    bool layouts_agree = true;
+    bool paths_consistent = true;
+    for (int i = 0; i < config.vertices; i++) {
+        for (int j = 0; j < config.vertices; j++) {
+            if (morton->distance[i][j] != row_major->distance[i][j]) {
+                layouts_agree = false;
+            }
+            if (i == j || morton->distance[i][j] >= INFINITY_VALUE) {
+                continue;
+            }
+            int path_length;
+            int *path = floyd_warshall_get_path(morton, i, j, &path_length);
+            double cost = 0.0;
+            for (int p = 0; path && p + 1 < path_length; p++) {
+                cost += graph_get_edge(edges, path[p], path[p + 1]);
+            }
+            if (!path || fabs(cost - morton->distance[i][j]) > 1e-6) {
+                paths_consistent = false;
+            }
+            free(path);
+        }
+    }
+    ASSERT(layouts_agree, "Recursive engine layouts agree");
+    ASSERT(paths_consistent, "Recursive engine paths match distances");
+
+    graph_destroy(edges);
+    graph_destroy(morton);
+    graph_destroy(row_major);
+}
+
+void test_squaring_engine(void) {
+    printf("\n=== Squaring Engine Tests ===\n");
+
+    ASSERT(engine_matches_reference(FW_ENGINE_SQUARING, GRAPH_FAMILY_ERDOS_RENYI, 150, 0.05, false),
+           "Squaring engine matches reference on random graph");
+    ASSERT(engine_matches_reference(FW_ENGINE_SQUARING, GRAPH_FAMILY_LAYERED_DAG, 120, 0.3, false),
+           "Squaring engine matches reference on layered DAG");
+
+    /* A 64-vertex chain needs all six rounds */
+    Graph *graph = graph_create(64);
+    for (int v = 0; v + 1 < 64; v++) {
+        graph_add_edge(graph, v, v + 1, 1.0);
+    }
+    FloydWarshallResult result = floyd_warshall_execute_squaring(graph);
+    ASSERT(result.success, "Squaring engine execution success");
+    ASSERT_DOUBLE_EQUAL(63.0, floyd_warshall_get_distance(graph, 0, 63), EPSILON, "Squaring chain distance");
+
+    int path_length;
+    int *path = floyd_warshall_get_path(graph, 0, 63, &path_length);
+    ASSERT(path != NULL && path_length == 64 && path[1] == 1, "Squaring engine path reconstruction");
+    free(path);
+    graph_destroy(graph);
+}
+
+void test_small_engine(void) {
+    printf("\n=== Small Engine Tests ===\n");
+
+    /* Exact sizes and sizes padded up to the next specialized kernel */
+    const int sizes[] = {3, 8, 13, 16, 27, 32, 50, 64};
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        ASSERT(engine_matches_reference(FW_ENGINE_SMALL, GRAPH_FAMILY_ERDOS_RENYI, sizes[s], 0.15, true),
+               "Small engine matches reference distances and next hops");
+    }
+    ASSERT(engine_matches_reference(FW_ENGINE_SMALL, GRAPH_FAMILY_LAYERED_DAG, 40, 0.3, true),
+           "Small engine matches reference on layered DAG");
+    ASSERT(engine_matches_reference(FW_ENGINE_SMALL, GRAPH_FAMILY_ERDOS_RENYI, 100, 0.05, true),
+           "Small engine falls back above FW_SMALL_MAX_VERTICES");
+
+    GraphGeneratorConfig config;
+    graph_generator_default_config(&config, GRAPH_FAMILY_NEGATIVE_CYCLE, 20, 0.2);
+    Graph *graph = graph_generate(&config);
+    FloydWarshallResult result = floyd_warshall_execute_small(graph);
+    ASSERT(result.success && result.has_negative_cycle, "Small engine detects negative cycle");
+    ASSERT(result.negative_cycle_vertex >= 0, "Small engine reports negative cycle vertex");
+
+    /* The selector tries the size before any property of the weights */
+    char reason[128];
+    ASSERT(floyd_warshall_select_engine(graph, reason, sizeof(reason)) == FW_ENGINE_SMALL &&
+           strcmp(reason, "Small graph detected (20 <= 64 vertices)") == 0, "Selector picks small engine");
+    graph_destroy(graph);
+}
+
+void test_mixed_engine(void) {
+    printf("\n=== Mixed Precision Engine Tests ===\n");
+
+    ASSERT(engine_matches_reference(FW_ENGINE_MIXED, GRAPH_FAMILY_ERDOS_RENYI, 120, 0.05, false),
+           "Mixed engine matches reference on random graph");
+    ASSERT(engine_matches_reference(FW_ENGINE_MIXED, GRAPH_FAMILY_GRID, 100, 0.3, false),
+           "Mixed engine matches reference on grid");
+    ASSERT(engine_matches_reference(FW_ENGINE_MIXED, GRAPH_FAMILY_LAYERED_DAG, 90, 0.3, false),
+           "Mixed engine matches reference on layered DAG");
+
+    /* Near 1e8 floats are 8 apart: the float kernel cannot see that 0 -> 1 -> 2 is shorter */
+    Graph *graph = graph_create(5);
+    graph_add_edge(graph, 0, 2, 100000000.5);
+    graph_add_edge(graph, 0, 1, 100000000.25);
+    graph_add_edge(graph, 1, 2, 0.125);
+    graph_add_edge(graph, 3, 0, 1.0);
+    graph_add_edge(graph, 2, 4, 2.0);
+    FloydWarshallResult result = floyd_warshall_execute_mixed(graph);
+    ASSERT(result.success && !result.has_negative_cycle, "Mixed engine success");
+    ASSERT_DOUBLE_EQUAL(100000000.375, floyd_warshall_get_distance(graph, 0, 2), EPSILON, "Repaired distance is exact");
+    ASSERT_DOUBLE_EQUAL(100000001.375, floyd_warshall_get_distance(graph, 3, 2), EPSILON, "Predecessor row repaired");
+    ASSERT_DOUBLE_EQUAL(100000003.375, floyd_warshall_get_distance(graph, 3, 4), EPSILON, "Repair reaches later hops");
+    ASSERT_EQUAL(1, graph->next[0][2], "Repaired next hop");
+    ASSERT_EQUAL(4, result.repaired_entries, "Only the affected entries are repaired");
+    graph_destroy(graph);
+
+    GraphGeneratorConfig config;
+    graph_generator_default_config(&config, GRAPH_FAMILY_NEGATIVE_CYCLE, 30, 0.2);
+    graph = graph_generate(&config);
+    result = floyd_warshall_execute_mixed(graph);
+    ASSERT(result.success && result.has_negative_cycle, "Mixed engine falls back on negative cycles");
+    graph_destroy(graph);
+}
+
+void test_integer_engine(void) {
+    printf("\n=== Integer Engine Tests ===\n");
+
+    ASSERT(engine_matches_reference(FW_ENGINE_INTEGER, GRAPH_FAMILY_ERDOS_RENYI, 150, 0.05, true),
+           "Integer engine matches reference distances and next hops");
+    ASSERT(engine_matches_reference(FW_ENGINE_INTEGER, GRAPH_FAMILY_GRID, 100, 0.3, true),
+           "Integer engine matches reference on grid");
+    ASSERT(engine_matches_reference(FW_ENGINE_INTEGER, GRAPH_FAMILY_RMAT, 128, 0.1, true),
+           "Integer engine matches reference on R-MAT graph");
+
+    /* Detection: fractions and weights that could overflow a path sum are rejected */
+    Graph *graph = graph_create(4);
+    graph_add_edge(graph, 0, 1, 3.0);
+    graph_add_edge(graph, 1, 2, -2.0);
+    ASSERT(floyd_warshall_integral_weights(graph), "Integral weights detected");
+    graph_add_edge(graph, 2, 3, 0.5);
+    ASSERT(!floyd_warshall_integral_weights(graph), "Fractional weight rejected");
+    graph_add_edge(graph, 2, 3, (double)FW_INTEGER_PATH_LIMIT / 3.0 + 1.0);
+    ASSERT(!floyd_warshall_integral_weights(graph), "Weight beyond the path limit rejected");
+
+    /* Fractional weights fall back to the double kernel */
+    graph_add_edge(graph, 2, 3, 0.5);
+    FloydWarshallResult result = floyd_warshall_execute_integer(graph);
+    ASSERT(result.success, "Integer engine falls back on fractional weights");
+    ASSERT_DOUBLE_EQUAL(1.5, floyd_warshall_get_distance(graph, 0, 3), EPSILON, "Fallback distance");
+    graph_destroy(graph);
+
+    /* Large integral weights convert back exactly; unreachable entries keep their value */
+    int n = 100;
+    graph = graph_create(n);
+    for (int v = 0; v + 1 < n; v++) {
+        graph_add_edge(graph, v, v + 1, 2000000.0);
+    }
+    ASSERT(floyd_warshall_integral_weights(graph), "Large integral chain detected");
+    Graph *cycle = graph_copy(graph);
+    graph_add_edge(cycle, n - 1, 0, 3.0);
+    char reason[128];
+    ASSERT(floyd_warshall_select_engine(cycle, reason, sizeof(reason)) == FW_ENGINE_INTEGER &&
+           strcmp(reason, "Integral weights detected") == 0, "Selector picks integer engine on one cycle");
+    graph_destroy(cycle);
+    result = floyd_warshall_execute_auto(graph);
+    ASSERT(result.success && !result.has_negative_cycle, "Default dispatch on integral weights");
+    ASSERT_DOUBLE_EQUAL(198000000.0, floyd_warshall_get_distance(graph, 0, n - 1), EPSILON, "Long integral path");
+    ASSERT(floyd_warshall_get_distance(graph, n - 1, 0) >= INFINITY_VALUE, "Unreachable entry unchanged");
+    graph_destroy(graph);
+
+    /* Negative cycles go to the reference kernel, which names the first one */
+    GraphGeneratorConfig config;
+    graph_generator_default_config(&config, GRAPH_FAMILY_NEGATIVE_CYCLE, 80, 0.1);
+    graph = graph_generate(&config);
+    NegativeCycleInfo info;
+    negative_cycle_info_init(&info);
+    result = floyd_warshall_execute_integer_checked(graph, &info);
+    ASSERT(result.success && result.has_negative_cycle, "Integer engine detects negative cycle");
+    ASSERT(info.found && info.cycle_length > 0, "Integer engine reports the negative cycle");
+    negative_cycle_info_free(&info);
+    graph_destroy(graph);
+}
+
+void test_scc_engine(void) {
+    printf("\n=== SCC Engine Tests ===\n");
+
+    /* Two cycles joined one way, plus an isolated vertex */
+    Graph *graph = graph_create(6);
+    graph_add_edge(graph, 3, 4, 1.0);
+    graph_add_edge(graph, 4, 3, 1.0);
+    graph_add_edge(graph, 0, 1, 2.0);
+    graph_add_edge(graph, 1, 2, 2.0);
+    graph_add_edge(graph, 2, 0, 2.0);
+    graph_add_edge(graph, 2, 3, 5.0);
+    SccDecomposition *scc = scc_decompose(graph);
+    ASSERT(scc != NULL, "SCC decomposition success");
+    ASSERT_EQUAL(3, scc->count, "Component count");
+    ASSERT_EQUAL(3, scc->largest, "Largest component");
+    ASSERT(scc->component[0] == scc->component[2] && scc->component[3] == scc->component[4],
+           "Cycle vertices share a component");
+    ASSERT(scc->component[2] < scc->component[3], "Components in topological order");
+    scc_destroy(scc);
+    graph_destroy(graph);
+
+    ASSERT(engine_matches_reference(FW_ENGINE_SCC, GRAPH_FAMILY_ERDOS_RENYI, 150, 0.01, false),
+           "SCC engine matches reference on sparse random graph");
+    ASSERT(engine_matches_reference(FW_ENGINE_SCC, GRAPH_FAMILY_LAYERED_DAG, 120, 0.3, false),
+           "SCC engine matches reference on layered DAG");
+    ASSERT(engine_matches_reference(FW_ENGINE_SCC, GRAPH_FAMILY_RMAT, 128, 0.05, false),
+           "SCC engine matches reference on R-MAT graph");
+
+    /* Eight strongly connected blocks linked forward, fractional weights */
+    int n = 160;
+    int block = 20;
+    graph = graph_create(n);
+    for (int v = 0; v < n; v++) {
+        int base = v / block * block;
+        graph_add_edge(graph, v, base + (v - base + 1) % block, 1.5 + v % 7);
+        graph_add_edge(graph, v, base + (v - base + 7) % block, 9.25);
+        if (base + block < n && v % 5 == 0) {
+            graph_add_edge(graph, v, (v * 37 + block) % (n - base - block) + base + block, 0.75 + v % 3);
+        }
+    }
+    Graph *reference = graph_copy(graph);
+    floyd_warshall_execute_engine(reference, FW_ENGINE_STANDARD);
+    ASSERT(floyd_warshall_select_engine(graph, NULL, 0) == FW_ENGINE_SCC, "Selector picks SCC engine");
+    size_t memory = get_memory_usage();
+    FloydWarshallResult result = floyd_warshall_execute_auto(graph);
+    ASSERT(result.success && !result.has_negative_cycle, "Default dispatch splits into components");
+    ASSERT(get_memory_usage() == memory, "Component copies are all released");
+
+    bool distances_match = true;
+    bool paths_consistent = true;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (fabs(reference->distance[i][j] - graph->distance[i][j]) > 1e-6) {
+                distances_match = false;
+            }
+            if (i == j || graph->distance[i][j] >= INFINITY_VALUE) {
+                continue;
+            }
+            /* Following next hops adds up the original edges to the distance */
+            double cost = 0.0;
+            int v = i;
+            for (int hops = 0; v != j && v >= 0 && hops < n; hops++) {
+                int hop = graph->next[v][j];
+                cost += hop >= 0 ? graph_get_edge(reference, v, hop) : 0.0;
+                v = hop;
+            }
+            if (v != j || fabs(cost - graph->distance[i][j]) > 1e-6) {
+                paths_consistent = false;
+            }
+        }
+    }
+    ASSERT(distances_match, "Component results match reference");
+    ASSERT(paths_consistent, "Component next hops trace shortest paths");
+    graph_destroy(reference);
+    graph_destroy(graph);
+
+    /* A negative cycle inside one component falls back to the reference kernel */
+    graph = graph_create(70);
+    for (int v = 0; v + 1 < 70; v++) {
+        graph_add_edge(graph, v, v + 1, 1.0);
+    }
+    graph_add_edge(graph, 41, 40, -3.0);
+    result = floyd_warshall_execute_scc(graph);
+    ASSERT(result.success && result.has_negative_cycle, "SCC engine detects negative cycle");
+    graph_destroy(graph);
+}
+
+void test_bfs_engine(void) {
+    printf("\n=== BFS Engine Tests ===\n");
+
+    /*
+     * Hop-count graph over more than one bitset word: a one-way ring with
+     * chords, so early levels run top-down and later ones bottom-up, and a
+     * tail of vertices without out-edges
+     */
+    int n = 150;
+    Graph *graph = graph_create(n);
+    for (int v = 0; v < n; v++) {
+        graph_add_edge(graph, v, (v + 1) % n, 2.5);
+        graph_add_edge(graph, v, (v * 7 + 3) % n == v ? (v + 2) % n : (v * 7 + 3) % n, 2.5);
+    }
+    for (int v = 140; v < n; v++) {
+        for (int w = 0; w < n; w++) {
+            graph->distance[v][w] = v == w ? 0.0 : INFINITY_VALUE;
+            graph->next[v][w] = -1;
+        }
+    }
+    graph_add_edge(graph, 139, 140, 2.5);
+    graph_add_edge(graph, 141, 0, 2.5);
+
+    double weight = 0.0;
+    ASSERT(floyd_warshall_uniform_weight(graph, &weight), "Uniform weights detected");
+    ASSERT_DOUBLE_EQUAL(2.5, weight, EPSILON, "Common edge weight");
+
+    Graph *edges = graph_copy(graph);
+    Graph *reference = graph_copy(graph);
+    floyd_warshall_execute_engine(reference, FW_ENGINE_STANDARD);
+    FloydWarshallResult result = floyd_warshall_execute_bfs(graph);
+    ASSERT(result.success && !result.has_negative_cycle, "BFS engine execution success");
+
+    bool distances_match = true;
+    bool paths_consistent = true;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (fabs(reference->distance[i][j] - graph->distance[i][j]) > 1e-6) {
+                distances_match = false;
+            }
+            if (i == j || graph->distance[i][j] >= INFINITY_VALUE) {
+                continue;
+            }
+            int path_length;
+            int *path = floyd_warshall_get_path(graph, i, j, &path_length);
+            if (!path || fabs((path_length - 1) * 2.5 - graph->distance[i][j]) > 1e-6) {
+                paths_consistent = false;
+            }
+            for (int p = 0; path && p + 1 < path_length; p++) {
+                if (!graph_has_edge(edges, path[p], path[p + 1])) {
+                    paths_consistent = false;
+                }
+            }
+            free(path);
+        }
+    }
+    ASSERT(distances_match, "BFS distances match reference");
+    ASSERT(paths_consistent, "BFS next hops follow shortest hop paths");
+    ASSERT_DOUBLE_EQUAL(INFINITY_VALUE, floyd_warshall_get_distance(graph, 142, 0), EPSILON,
+                        "Vertex without edges reaches nothing");
+
+    /* floyd_warshall_execute_auto routes uniform weights to the same engine */
+    graph_destroy(graph);
+    graph = graph_copy(edges);
+    ASSERT(floyd_warshall_select_engine(graph, NULL, 0) == FW_ENGINE_BFS, "Selector picks BFS engine");
+    result = floyd_warshall_execute_auto(graph);
+    ASSERT(result.success && fabs(graph->distance[141][139] - reference->distance[141][139]) < 1e-6,
+           "Automatic dispatch on uniform weights");
+    graph_destroy(graph);
+    graph_destroy(reference);
+
+    /* A second weight (or a negative one) sends the graph to the reference kernel */
+    graph = graph_copy(edges);
+    graph_add_edge(graph, 5, 9, 1.0);
+    ASSERT(!floyd_warshall_uniform_weight(graph, NULL), "Mixed weights rejected");
+    reference = graph_copy(graph);
+    floyd_warshall_execute_engine(reference, FW_ENGINE_STANDARD);
+    result = floyd_warshall_execute_bfs(graph);
+    ASSERT(result.success && fabs(graph->distance[5][10] - reference->distance[5][10]) < 1e-6,
+           "BFS engine falls back on mixed weights");
+    graph_destroy(reference);
+    graph_destroy(graph);
+
+    graph = graph_create(3);
+    graph_add_edge(graph, 0, 1, -1.0);
+    graph_add_edge(graph, 1, 2, -1.0);
+    ASSERT(!floyd_warshall_uniform_weight(graph, NULL), "Negative uniform weight rejected");
+    graph_destroy(graph);
+    graph_destroy(edges);
+}
+
+void test_reduction(void) {
+    printf("\n=== Graph Reduction Tests ===\n");
+
+    /*
+     * Road-like graph: a ring of 8 junctions whose links are chains of three
+     * vertices (two-way, fractional weights), a one-way chain, and a tree of
+     * leaves hanging off junction 0.
+     */
+    int n = 40;
+    Graph *graph = graph_create(n);
+    int next_vertex = 8;
+    for (int j = 0; j < 8; j++) {
+        int previous = j;
+        for (int c = 0; c < 3; c++) {
+            int v = next_vertex++;
+            graph_add_edge(graph, previous, v, 1.25 + (j + c) % 4);
+            graph_add_edge(graph, v, previous, 1.75 + (j * c) % 3);
+            previous = v;
+        }
+        graph_add_edge(graph, previous, (j + 1) % 8, 2.0);
+        graph_add_edge(graph, (j + 1) % 8, previous, 2.5);
+    }
+    graph_add_edge(graph, 2, 32, 1.0);
+    graph_add_edge(graph, 32, 33, 1.0);
+    graph_add_edge(graph, 33, 6, 1.0);
+    graph_add_edge(graph, 2, 6, 30.0);
+    for (int v = 34; v < n; v++) {
+        graph_add_edge(graph, v == 34 ? 0 : v - 1 - (v % 2), v, 0.5);
+        graph_add_edge(graph, v, v == 34 ? 0 : v - 1 - (v % 2), 0.5);
+    }
+
+    GraphReduction *reduction = reduction_create(graph);
+    ASSERT(reduction != NULL, "Reduction success");
+    ASSERT(reduction->core->vertices <= 8, "Chains and leaves contracted into the junctions");
+    ASSERT_EQUAL(n - reduction->core->vertices, reduction->step_count, "One undo step per removed vertex");
+    ASSERT(reduction->dominated_edges >= 1, "Direct edge dominated by the one-way chain");
+
+    Graph *edges = graph_copy(graph);
+    Graph *reference = graph_copy(graph);
+    floyd_warshall_execute_engine(reference, FW_ENGINE_STANDARD);
+    FloydWarshallResult result = floyd_warshall_execute_reduced(graph, reduction, FW_ENGINE_STANDARD);
+    ASSERT(result.success && !result.has_negative_cycle, "Reduced execution success");
+
+    bool distances_match = true;
+    bool paths_consistent = true;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (fabs(reference->distance[i][j] - graph->distance[i][j]) > 1e-6) {
+                distances_match = false;
+            }
+            if (i == j || graph->distance[i][j] >= INFINITY_VALUE) {
+                continue;
+            }
+            int path_length;
+            int *path = floyd_warshall_get_path(graph, i, j, &path_length);
+            double cost = 0.0;
+            for (int p = 0; path && p + 1 < path_length; p++) {
+                cost += graph_get_edge(edges, path[p], path[p + 1]);
+            }
+            if (!path || fabs(cost - graph->distance[i][j]) > 1e-6) {
+                paths_consistent = false;
+            }
+            free(path);
+        }
+    }
+    ASSERT(distances_match, "Expanded distances match reference");
+    ASSERT(paths_consistent, "Expanded next hops follow original edges");
+    reduction_destroy(reduction);
+    graph_destroy(reference);
+    graph_destroy(graph);
+
+    /* A negative cycle through the core is solved on the full graph instead */
+    graph = graph_copy(edges);
+    graph_add_edge(graph, 6, 2, -10.0);
+    reduction = reduction_create(graph);
+    result = floyd_warshall_execute_reduced(graph, reduction, FW_ENGINE_STANDARD);
+    ASSERT(result.success && result.has_negative_cycle, "Reduced execution detects negative cycle");
+    reduction_destroy(reduction);
+    graph_destroy(graph);
+
+    /* Vertices on a negative two-edge cycle stay in the core */
+    graph = graph_create(3);
+    graph_add_edge(graph, 0, 1, 1.0);
+    graph_add_edge(graph, 1, 0, -2.0);
+    graph_add_edge(graph, 1, 2, 1.0);
+    reduction = reduction_create(graph);
+    ASSERT(reduction != NULL && reduction->core->vertices == 2, "Negative two-edge cycle kept");
+    reduction_destroy(reduction);
+    graph_destroy(graph);
+    graph_destroy(edges);
+
+    /*
+     * Chain vertex 1 between junctions 0 and 2 on a zero-weight two-cycle
+     * with 0: from 1, going back to 0 ties with going on to 2, but 0's own
+     * route to 2 runs through 1, so only the hop to 2 terminates.
+     */
+    n = 6;
+    graph = graph_create(n);
+    graph_add_edge(graph, 0, 1, 1.0);
+    graph_add_edge(graph, 1, 0, -1.0);
+    graph_add_edge(graph, 1, 2, 1.0);
+    for (int a = 2; a < n; a++) {
+        for (int b = 0; b < n; b++) {
+            if (b != a && b != 1) {
+                graph_add_edge(graph, a, b, 10.0);
+                graph_add_edge(graph, b, a, 10.0);
+            }
+        }
+    }
+    reference = graph_copy(graph);
+    floyd_warshall_execute_engine(reference, FW_ENGINE_STANDARD);
+    reduction = reduction_create(graph);
+    ASSERT(reduction != NULL && reduction->chains >= 1, "Zero-weight two-cycle chain removed");
+    result = floyd_warshall_execute_reduced(graph, reduction, FW_ENGINE_STANDARD);
+    distances_match = result.success;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            distances_match = distances_match && fabs(reference->distance[i][j] - graph->distance[i][j]) <= 1e-6;
+        }
+    }
+    ASSERT(distances_match, "Zero-weight two-cycle distances match reference");
+    ASSERT(next_hops_reach_targets(graph), "Zero-weight two-cycle hops reach targets");
+    reduction_destroy(reduction);
+    graph_destroy(reference);
+    graph_destroy(graph);
+}
+
+void test_dag_engine(void) {
+    printf("\n=== DAG Engine Tests ===\n");
+
+    ASSERT(engine_matches_reference(FW_ENGINE_DAG, GRAPH_FAMILY_LAYERED_DAG, 150, 0.3, false),
+           "DAG engine matches reference on layered DAG");
+
+    /* Scattered numbering, negative weights, several paths per pair */
+    int n = 100;
+    int edge_count = 0;
+    Graph *graph = graph_create(n);
+    for (int a = 0; a < n; a++) {
+        for (int b = a + 1; b < n && b <= a + 6; b++) {
+            graph_add_edge(graph, (a * 37) % n, (b * 37) % n, (double)((a * 7 + b * 3) % 11) - 4.5);
+            edge_count++;
+        }
+    }
+
+    int *order = (int*)malloc((size_t)n * sizeof(int));
+    ASSERT(floyd_warshall_topological_order(graph, order), "Acyclic graph detected");
+    int *rank = (int*)malloc((size_t)n * sizeof(int));
+    for (int p = 0; p < n; p++) {
+        rank[order[p]] = p;
+    }
+    bool topological = true;
+    for (int u = 0; u < n; u++) {
+        for (int v = 0; v < n; v++) {
+            if (u != v && graph->distance[u][v] < INFINITY_VALUE && rank[u] >= rank[v]) {
+                topological = false;
+            }
+        }
+    }
+    ASSERT(topological, "Every edge goes forward in the topological order");
+    free(rank);
+    free(order);
+
+    Graph *edges = graph_copy(graph);
+    Graph *reference = graph_copy(graph);
+    floyd_warshall_execute_engine(reference, FW_ENGINE_STANDARD);
+    FloydWarshallResult result = floyd_warshall_execute_dag(graph);
+    ASSERT(result.success && !result.has_negative_cycle, "DAG engine execution success");
+    ASSERT(result.iterations <= n * edge_count, "DAG engine relaxes each edge at most once per source");
+
+    bool distances_match = true;
+    bool paths_consistent = true;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (fabs(reference->distance[i][j] - graph->distance[i][j]) > 1e-6) {
+                distances_match = false;
+            }
+            if (i == j || graph->distance[i][j] >= INFINITY_VALUE) {
+                continue;
+            }
+            int path_length;
+            int *path = floyd_warshall_get_path(graph, i, j, &path_length);
+            double cost = 0.0;
+            for (int p = 0; path && p + 1 < path_length; p++) {
+                cost += graph_get_edge(edges, path[p], path[p + 1]);
+            }
+            if (!path || fabs(cost - graph->distance[i][j]) > 1e-6) {
+                paths_consistent = false;
+            }
+            free(path);
+        }
+    }
+    ASSERT(distances_match, "DAG distances match reference (negative weights)");
+    ASSERT(paths_consistent, "DAG next hops follow original edges");
+
+    /* floyd_warshall_execute_auto routes acyclic graphs to the same engine */
+    graph_destroy(graph);
+    graph = graph_copy(edges);
+    ASSERT(floyd_warshall_select_engine(graph, NULL, 0) == FW_ENGINE_DAG, "Selector picks DAG engine");
+    result = floyd_warshall_execute_auto(graph);
+    ASSERT(result.success && fabs(graph->distance[0][(98 * 37) % n] - reference->distance[0][(98 * 37) % n]) < 1e-6,
+           "Automatic dispatch on acyclic graph");
+    graph_destroy(graph);
+    graph_destroy(reference);
+
+    /* A cycle (or a negative self-loop) sends the graph to the reference kernel */
+    graph = graph_copy(edges);
+    graph_add_edge(graph, (90 * 37) % n, (10 * 37) % n, -40.0);
+    ASSERT(!floyd_warshall_topological_order(graph, NULL), "Cycle detected");
+    result = floyd_warshall_execute_dag(graph);
+    ASSERT(result.success && result.has_negative_cycle, "DAG engine falls back on a negative cycle");
+    graph_destroy(graph);
+
+    graph = graph_copy(edges);
+    graph_add_edge(graph, 3, 3, -1.0);
+    ASSERT(!floyd_warshall_topological_order(graph, NULL), "Negative self-loop is a cycle");
+    graph_destroy(graph);
+    graph_destroy(edges);
+}
+
+void test_vertex_order(void) {
+    printf("\n=== Vertex Reordering Tests ===\n");
+
+    /*
+     * Four clusters of FW_TILE_SIZE vertices (two-way rings) joined one way,
+     * with the vertex numbers scattered so no tile holds a single cluster.
+     */
+    int clusters = 4;
+    int n = clusters * FW_TILE_SIZE;
+    Graph *graph = graph_create(n);
+    for (int c = 0; c < clusters; c++) {
+        for (int k = 0; k < FW_TILE_SIZE; k++) {
+            int u = ((c * FW_TILE_SIZE + k) * 97) % n;
+            int v = ((c * FW_TILE_SIZE + (k + 1) % FW_TILE_SIZE) * 97) % n;
+            graph_add_edge(graph, u, v, 1.0 + (k % 3) * 0.5);
+            graph_add_edge(graph, v, u, 2.0 + (k % 2) * 0.25);
+        }
+        if (c + 1 < clusters) {
+            graph_add_edge(graph, (c * FW_TILE_SIZE * 97) % n, ((c + 1) * FW_TILE_SIZE * 97) % n, 3.0);
+        }
+    }
+
+    Graph *edges = graph_copy(graph);
+    Graph *reference = graph_copy(graph);
+    FloydWarshallResult plain = floyd_warshall_execute_engine(reference, FW_ENGINE_BLOCKED);
+
+    for (int s = 0; s < VERTEX_ORDER_COUNT; s++) {
+        VertexOrderStrategy strategy = (VertexOrderStrategy)s;
+        const char *name = vertex_order_strategy_name(strategy);
+        ASSERT(vertex_order_strategy_from_name(name) == strategy, "Vertex order name round trip");
+
+        VertexOrder *order = vertex_order_create(edges, strategy);
+        ASSERT(order != NULL, "Vertex order creation");
+        if (!order) {
+            continue;
+        }
+        bool permutation = true;
+        for (int i = 0; i < n; i++) {
+            if (order->order[i] < 0 || order->order[i] >= n || order->rank[order->order[i]] != i) {
+                permutation = false;
+            }
+        }
+        ASSERT(permutation, "Order is a permutation and rank its inverse");
+
+        Graph *candidate = graph_copy(edges);
+        FloydWarshallResult result = floyd_warshall_execute_reordered(candidate, order, FW_ENGINE_BLOCKED);
+        ASSERT(result.success && !result.has_negative_cycle, "Reordered execution success");
+        ASSERT(result.tiles_skipped > plain.tiles_skipped, "Reordering leaves more tiles infinite");
+
+        bool distances_match = true;
+        bool paths_consistent = true;
+        for (int i = 0; i < n; i += 7) {
+            for (int j = 0; j < n; j++) {
+                if (fabs(reference->distance[i][j] - candidate->distance[i][j]) > 1e-6) {
+                    distances_match = false;
+                }
+                if (i == j || candidate->distance[i][j] >= INFINITY_VALUE) {
+                    continue;
+                }
+                int path_length;
+                int *path = floyd_warshall_get_path(candidate, i, j, &path_length);
+                double cost = 0.0;
+                for (int p = 0; path && p + 1 < path_length; p++) {
+                    cost += graph_get_edge(edges, path[p], path[p + 1]);
+                }
+                if (!path || fabs(cost - candidate->distance[i][j]) > 1e-6) {
+                    paths_consistent = false;
+                }
+                free(path);
+            }
+        }
+        ASSERT(distances_match, "Reordered distances match reference");
+        ASSERT(paths_consistent, "Reordered paths use original vertex numbers");
+
+        graph_destroy(candidate);
+        vertex_order_destroy(order);
+    }
+    ASSERT(vertex_order_strategy_from_name("none") == VERTEX_ORDER_COUNT, "Unknown vertex order rejected");
+
+    /* The reported cycle vertex is in the original numbering */
+    Graph *cyclic = graph_create(5);
+    graph_add_edge(cyclic, 0, 4, 1.0);
+    graph_add_edge(cyclic, 4, 2, 1.0);
+    graph_add_edge(cyclic, 2, 4, -3.0);
+    VertexOrder *order = vertex_order_create(cyclic, VERTEX_ORDER_RCM);
+    FloydWarshallResult result = floyd_warshall_execute_reordered(cyclic, order, FW_ENGINE_STANDARD);
+    ASSERT(result.success && result.has_negative_cycle, "Reordered execution detects negative cycle");
+    ASSERT(result.negative_cycle_vertex == 2 || result.negative_cycle_vertex == 4, "Cycle vertex mapped back");
+    vertex_order_destroy(order);
+    graph_destroy(cyclic);
+
+    graph_destroy(reference);
+    graph_destroy(edges);
+    graph_destroy(graph);
+}
+
+void test_distributed_engine(void) {
+    printf("\n=== Distributed Engine Tests ===\n");
+
+    GraphGeneratorConfig config;
+    graph_generator_default_config(&config, GRAPH_FAMILY_ERDOS_RENYI, 45, 0.1);
+    Graph *reference = graph_generate(&config);
+    floyd_warshall_execute_engine(reference, FW_ENGINE_STANDARD);
+
+    /* 6 processes: a 2 x 3 grid with uneven blocks */
+    for (int t = 0; t < TRANSPORT_COUNT; t++) {
+        Graph *graph = graph_generate(&config);
+        FloydWarshallResult result = floyd_warshall_execute_distributed(graph, 6, (TransportKind)t);
+        ASSERT(result.success && !result.has_negative_cycle, "Distributed execution success");
+
+        int mismatches = 0;
+        for (int i = 0; i < graph->vertices; i++) {
+            for (int j = 0; j < graph->vertices; j++) {
+                mismatches += reference->distance[i][j] != graph->distance[i][j] ||
+                              reference->next[i][j] != graph->next[i][j];
+            }
+        }
+        ASSERT_EQUAL(0, mismatches, "Distributed result identical to reference");
+        graph_destroy(graph);
+    }
+    graph_destroy(reference);
+
+    graph_generator_default_config(&config, GRAPH_FAMILY_NEGATIVE_CYCLE, 20, 0.2);
+    Graph *graph = graph_generate(&config);
+    FloydWarshallResult result = floyd_warshall_execute_distributed(graph, 4, TRANSPORT_SHM);
+    ASSERT(result.success && result.has_negative_cycle, "Distributed run detects negative cycle");
+    graph_destroy(graph);
+
+    graph = graph_create(4);
+    result = floyd_warshall_execute_distributed(graph, FW_DISTRIBUTED_MAX_PROCESSES + 1, TRANSPORT_SHM);
+    ASSERT(!result.success, "Distributed run rejects too many processes");
+    ASSERT(transport_kind_from_name("tcp") == TRANSPORT_TCP, "Transport name lookup");
+    graph_destroy(graph);
+}
+
+/* Progress callback for the context tests: counts calls, cancels at a pivot */
+typedef struct {
+    int calls;
+    int last_done;
+    int cancel_at;
+    ExecutionContext *context;
+} ProgressProbe;
+
+static void probe_progress(const ExecutionProgress *progress, void *user_data) {
+    ProgressProbe *probe = (ProgressProbe*)user_data;
+    probe->calls++;
+    probe->last_done = progress->pivots_done;
+    if (probe->cancel_at >= 0 && progress->pivots_done >= probe->cancel_at) {
+        execution_context_cancel(probe->context);
+    }
+}
+
+void test_execution_context(void) {
+    printf("\n=== Execution Context Tests ===\n");
+
+    GraphGeneratorConfig config;
+    graph_generator_default_config(&config, GRAPH_FAMILY_ERDOS_RENYI, 150, 0.05);
+    Graph *original = graph_generate(&config);
+
+    /* Every boundary reported with a zero interval, plus completion */
+    ExecutionContext context;
+    ProgressProbe probe = {0, -1, -1, &context};
+    execution_context_init(&context, probe_progress, &probe, 0);
+    Graph *graph = graph_copy(original);
+    FloydWarshallResult result = floyd_warshall_execute_context(graph, FW_ENGINE_STANDARD, &context);
+    ASSERT(result.success && context.status == EXECUTION_COMPLETE, "Context run completes");
+    ASSERT_EQUAL(151, probe.calls, "Progress reported per pivot and on completion");
+    ASSERT_EQUAL(150, probe.last_done, "Final progress covers all pivots");
+    ASSERT(execution_current == NULL, "Context detached after the run");
+    graph_destroy(graph);
+
+    /* Cancel at pivot 40: the matrices hold exactly pivots 0..39 */
+    probe.calls = 0;
+    probe.cancel_at = 40;
+    execution_context_init(&context, probe_progress, &probe, 0);
+    graph = graph_copy(original);
+    result = floyd_warshall_execute_context(graph, FW_ENGINE_STANDARD, &context);
+    ASSERT(result.success && context.status == EXECUTION_CANCELLED, "Cancelled run reports partial status");
+    ASSERT_EQUAL(40, context.pivots_done, "Cancelled at the requested pivot");
+
+    Graph *expected = graph_copy(original);
+    for (int k = 0; k < 40; k++) {
+        for (int i = 0; i < expected->vertices; i++) {
+            for (int j = 0; j < expected->vertices; j++) {
+                if (expected->distance[i][k] < INFINITY_VALUE && expected->distance[k][j] < INFINITY_VALUE &&
+                    expected->distance[i][k] + expected->distance[k][j] < expected->distance[i][j]) {
+                    expected->distance[i][j] = expected->distance[i][k] + expected->distance[k][j];
+                    expected->next[i][j] = expected->next[i][k];
+                }
+            }
+        }
+    }
+    int mismatches = 0;
+    for (int i = 0; i < expected->vertices; i++) {
+        for (int j = 0; j < expected->vertices; j++) {
+            mismatches += expected->distance[i][j] != graph->distance[i][j] ||
+                          expected->next[i][j] != graph->next[i][j];
+        }
+    }
+    ASSERT_EQUAL(0, mismatches, "Partial result is the state after the completed pivots");
+    graph_destroy(graph);
+
+    /* Distributed ranks agree on the round and gather the same partial state */
+    execution_context_init(&context, probe_progress, &probe, 0);
+    graph = graph_copy(original);
+    execution_begin(&context);
+    result = floyd_warshall_execute_distributed(graph, 4, TRANSPORT_SHM);
+    execution_end(&context, result.success, result.iterations);
+    mismatches = 0;
+    for (int i = 0; i < expected->vertices; i++) {
+        for (int j = 0; j < expected->vertices; j++) {
+            mismatches += expected->distance[i][j] != graph->distance[i][j] ||
+                          expected->next[i][j] != graph->next[i][j];
+        }
+    }
+    ASSERT(result.success && context.status == EXECUTION_CANCELLED && context.pivots_done == 40 &&
+           mismatches == 0, "Distributed run cancels at the same round on every rank");
+    graph_destroy(expected);
+    graph_destroy(graph);
+
+    /* The mixed engine stops between float pivots; every distance is still a real path length */
+    execution_context_init(&context, probe_progress, &probe, 0);
+    graph = graph_copy(original);
+    Graph *solved = graph_copy(original);
+    floyd_warshall_execute_engine(solved, FW_ENGINE_STANDARD);
+    result = floyd_warshall_execute_context(graph, FW_ENGINE_MIXED, &context);
+    int shorter = 0;
+    for (int i = 0; i < graph->vertices; i++) {
+        for (int j = 0; j < graph->vertices; j++) {
+            shorter += graph->distance[i][j] < solved->distance[i][j] - 1e-9;
+        }
+    }
+    ASSERT(result.success && context.status == EXECUTION_CANCELLED && context.pivots_done == 40 && shorter == 0,
+           "Mixed engine cancels between float pivots");
+    graph_destroy(solved);
+    graph_destroy(graph);
+
+    /* The blocked engine stops at a pivot tile boundary */
+    probe.cancel_at = 1;
+    execution_context_init(&context, probe_progress, &probe, 0);
+    graph = graph_copy(original);
+    result = floyd_warshall_execute_context(graph, FW_ENGINE_BLOCKED, &context);
+    ASSERT(context.status == EXECUTION_CANCELLED && context.pivots_done == FW_TILE_SIZE,
+           "Blocked engine cancels at a tile boundary");
+    graph_destroy(graph);
+
+    /* The recursive engine stops between its top-level k-blocks */
+    execution_context_init(&context, probe_progress, &probe, 0);
+    graph = graph_copy(original);
+    result = floyd_warshall_execute_context(graph, FW_ENGINE_RECURSIVE, &context);
+    ASSERT(context.status == EXECUTION_CANCELLED && context.pivots_done > 0 && context.pivots_done < 150,
+           "Recursive engine cancels at a k-block boundary");
+    graph_destroy(graph);
+
+    /* A flag set before the run stops it before the first pivot; no callback needed */
+    execution_context_init(&context, NULL, NULL, 0);
+    execution_context_cancel(&context);
+    graph = graph_copy(original);
+    result = floyd_warshall_execute_context(graph, FW_ENGINE_PRUNED, &context);
+    ASSERT(context.status == EXECUTION_CANCELLED && context.pivots_done == 0, "Pre-cancelled run does no pivots");
+    graph_destroy(graph);
+
+    /* Components follow the caller's cancellation; the graph is left as it was */
+    graph = graph_create(150);
+    for (int v = 0; v < 150; v++) {
+        graph_add_edge(graph, v, v < 75 ? (v + 1) % 75 : 75 + (v - 74) % 75, 1.0 + v % 3);
+    }
+    graph_add_edge(graph, 0, 75, 2.0);
+    execution_context_init(&context, NULL, NULL, 0);
+    execution_context_cancel(&context);
+    result = floyd_warshall_execute_context(graph, FW_ENGINE_SCC, &context);
+    ASSERT(result.success && context.status == EXECUTION_CANCELLED && context.pivots_done == 0 &&
+           graph->distance[0][2] >= INFINITY_VALUE, "Cancelled SCC run leaves the graph untouched");
+    graph_destroy(graph);
+
+    graph_destroy(original);
+}
+
+void test_solver(void) {
+    printf("\n=== Solver Tests ===\n");
+
+    Solver *small = solver_create(40, FW_ENGINE_COUNT);
+    Solver *blocked = solver_create(150, FW_ENGINE_COUNT);
+    ASSERT(small && small->engine == FW_ENGINE_SMALL, "Small graphs select the small kernel");
+    ASSERT(blocked && blocked->engine == FW_ENGINE_BLOCKED, "Larger graphs select the blocked kernel");
+    ASSERT(solver_create(40, FW_ENGINE_PRUNED) == NULL, "Engines with per-run scratch are rejected");
+    ASSERT(solver_create(0, FW_ENGINE_COUNT) == NULL, "Empty solver is rejected");
+
+    /* Repeated runs on different graphs: results match, nothing is reallocated */
+    double *block = blocked->distance_block;
+    double *packed = blocked->workspaces[0].packed_a;
+    size_t memory = get_memory_usage();
+    int mismatches = 0;
+    for (int run = 0; run < 3; run++) {
+        GraphGeneratorConfig config;
+        graph_generator_default_config(&config, GRAPH_FAMILY_ERDOS_RENYI, 150, 0.05);
+        config.seed += (uint64_t)run;
+        Graph *reference = graph_generate(&config);
+        ASSERT_EQUAL(SUCCESS, solver_load_graph(blocked, reference), "Load graph into solver");
+        FloydWarshallResult result = solver_run(blocked);
+        ASSERT(result.success, "Solver run succeeds");
+
+        floyd_warshall_execute_engine(reference, FW_ENGINE_STANDARD);
+        Graph *solved = solver_graph(blocked);
+        for (int i = 0; i < 150; i++) {
+            for (int j = 0; j < 150; j++) {
+                mismatches += fabs(reference->distance[i][j] - solved->distance[i][j]) > 1e-6;
+            }
+        }
+        graph_destroy(reference);
+    }
+    ASSERT_EQUAL(0, mismatches, "Solver results match the reference on every run");
+    ASSERT_EQUAL(3, blocked->runs, "Runs counted");
+    ASSERT(blocked->distance_block == block && blocked->workspaces[0].packed_a == packed,
+           "Matrices and packing buffers are reused");
+    ASSERT(get_memory_usage() == memory, "No tracked allocation between runs");
+
+    /* Reset-and-reload through edges and through a weight matrix */
+    Graph *graph = solver_reset(small);
+    graph_add_edge(graph, 0, 1, 2.0);
+    graph_add_edge(graph, 1, 2, 3.0);
+    solver_run(small);
+    ASSERT_DOUBLE_EQUAL(5.0, floyd_warshall_get_distance(solver_graph(small), 0, 2), EPSILON, "Solver after reset");
+
+    double *weights = (double*)malloc(40 * 40 * sizeof(double));
+    for (int i = 0; i < 40 * 40; i++) {
+        weights[i] = INFINITY_VALUE;
+    }
+    weights[0 * 40 + 2] = 7.0;
+    weights[2 * 40 + 39] = 1.5;
+    ASSERT_EQUAL(SUCCESS, solver_load_matrix(small, weights), "Load weight matrix");
+    solver_run(small);
+    ASSERT_DOUBLE_EQUAL(8.5, floyd_warshall_get_distance(solver_graph(small), 0, 39), EPSILON, "Solver after reload");
+    ASSERT(floyd_warshall_get_distance(solver_graph(small), 1, 2) >= INFINITY_VALUE, "Previous edges are gone");
+    free(weights);
+
+    Graph *wrong_size = graph_create(10);
+    ASSERT_EQUAL(ERROR_INVALID_INPUT, solver_load_graph(small, wrong_size), "Size mismatch rejected");
+    graph_destroy(wrong_size);
+
+    solver_destroy(small);
+    solver_destroy(blocked);
+}
+
+void test_batch_engine(void) {
+    printf("\n=== Batch Engine Tests ===\n");
+
+    /* 19 graphs: two full lane groups plus a padded one */
+    const int n = 24, count = 19;
+    GraphBatch *batch = graph_batch_create(n, count);
+    Graph **reference = (Graph**)malloc(count * sizeof(Graph*));
+    ASSERT(batch != NULL && batch->groups == (count + FW_BATCH_LANES - 1) / FW_BATCH_LANES,
+           "Batch creation with padded last group");
+
+    for (int g = 0; g < count; g++) {
+        GraphGeneratorConfig config;
+        graph_generator_default_config(&config, g == 5 ? GRAPH_FAMILY_NEGATIVE_CYCLE : GRAPH_FAMILY_ERDOS_RENYI,
+                                       n, 0.1 + 0.02 * g);
+        config.seed = 100 + g;
+        reference[g] = graph_generate(&config);
+        graph_batch_set_graph(batch, g, reference[g]);
+    }
+    ASSERT_EQUAL(ERROR_INVALID_INPUT, graph_batch_add_edge(batch, 0, 3, 3, 1.0), "Batch rejects self loops");
+    ASSERT_EQUAL(ERROR_INVALID_INPUT, graph_batch_add_edge(batch, count, 0, 1, 1.0), "Batch rejects bad graph index");
+
+    FloydWarshallBatchResult result = floyd_warshall_execute_batch(batch);
+    ASSERT(result.success && result.graphs_per_second > 0.0, "Batch execution reports throughput");
+    ASSERT_EQUAL(1, result.negative_cycle_graphs, "Only the planted negative cycle graph is flagged");
+    ASSERT(batch->negative_cycle[5], "Negative cycle flagged on the right graph");
+
+    int mismatches = 0;
+    int bad_paths = 0;
+    for (int g = 0; g < count; g++) {
+        if (g == 5) {
+            continue;
+        }
+        Graph *edges = graph_copy(reference[g]);
+        floyd_warshall_execute(reference[g]);
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                double expected = reference[g]->distance[i][j];
+                if (fabs(expected - graph_batch_get_distance(batch, g, i, j)) > 1e-6) {
+                    mismatches++;
+                }
+
+                int path_length;
+                int *path = floyd_warshall_get_path_batch(batch, g, i, j, &path_length);
+                if (expected < INFINITY_VALUE) {
+                    double cost = 0.0;
+                    for (int t = 0; path && t + 1 < path_length; t++) {
+                        cost += graph_get_edge(edges, path[t], path[t + 1]);
+                    }
+                    bad_paths += !path || path[path_length - 1] != j || fabs(cost - expected) > 1e-6;
+                }
+                free(path);
+            }
+        }
+        graph_destroy(edges);
+    }
+    ASSERT_EQUAL(0, mismatches, "Batch distances match per-graph reference");
+    ASSERT_EQUAL(0, bad_paths, "Batch paths are valid and shortest");
+
+    /* Array API: matrices in, matrices out */
+    double weights[3 * 3 * 2] = {
+        0.0, 4.0, INFINITY_VALUE,  INFINITY_VALUE, 0.0, 1.0,  2.0, INFINITY_VALUE, 0.0,
+        0.0, INFINITY_VALUE, 7.0,  1.0, 0.0, INFINITY_VALUE,  INFINITY_VALUE, 3.0, 0.0
+    };
+    double distances[9];
+    GraphBatch *small = graph_batch_from_matrices(3, 2, weights);
+    floyd_warshall_execute_batch(small);
+    ASSERT_EQUAL(SUCCESS, graph_batch_get_matrix(small, 0, distances), "Batch matrix readback");
+    ASSERT_DOUBLE_EQUAL(5.0, distances[0 * 3 + 2], EPSILON, "Array API graph 0 distance (0,2)");
+    ASSERT_DOUBLE_EQUAL(10.0, graph_batch_get_distance(small, 1, 0, 1), EPSILON, "Array API graph 1 distance (0,1)");
+    ASSERT_DOUBLE_EQUAL(INFINITY_VALUE, graph_batch_get_distance(small, 1, 0, 3), EPSILON, "Out of range vertex");
+
+    graph_batch_destroy(small);
+    for (int g = 0; g < count; g++) {
+        graph_destroy(reference[g]);
+    }
+    free(reference);
+    graph_batch_destroy(batch);
+}
+
 void run_floyd_warshall_tests(void) {
     printf("Starting Floyd-Warshall Algorithm Tests...\n");
     test_simple_graph_algorithm();
     test_negative_cycle_detection();
+    test_negative_cycle_extraction();
     test_path_reconstruction();
+    test_engine_registry();
+    test_pruned_engine();
+    test_blocked_engine();
+    test_recursive_engine();
+    test_squaring_engine();
+    test_small_engine();
+    test_mixed_engine();
+    test_integer_engine();
+    test_scc_engine();
+    test_dag_engine();
+    test_bfs_engine();
+    test_reduction();
+    test_vertex_order();
+    test_distributed_engine();
+    test_execution_context();
+    test_solver();
+    test_batch_engine();
 }
 
 /* Memory management tests */
@@ -188,13 +1641,553 @@ void test_file_operations(void) {
         graph_destroy(graph);
     }
 
+    /* Of parallel edges the last one in the file is kept, cheaper or not */
+    FILE *file = fopen(test_file, "w");
+    if (file) {
+        fprintf(file, "3\n4\n0 1 5.0\n0 1 2.0\n1 2 1.0\n1 2 4.0\n");
+        fclose(file);
+    }
+    graph = load_graph_from_file(test_file);
+    ASSERT(graph != NULL, "Graph with parallel edges loads");
+    if (graph) {
+        ASSERT_DOUBLE_EQUAL(2.0, graph_get_edge(graph, 0, 1), EPSILON, "Cheaper later edge kept");
+        ASSERT_DOUBLE_EQUAL(4.0, graph_get_edge(graph, 1, 2), EPSILON, "Dearer later edge kept");
+
+        /* The reduction works on the loaded matrix, so it solves the same graph */
+        Graph *reference = graph_copy(graph);
+        floyd_warshall_execute_engine(reference, FW_ENGINE_STANDARD);
+        GraphReduction *reduction = reduction_create(graph);
+        FloydWarshallResult reduced = floyd_warshall_execute_reduced(graph, reduction, FW_ENGINE_STANDARD);
+        ASSERT(reduced.success && fabs(graph->distance[0][2] - reference->distance[0][2]) < EPSILON &&
+               fabs(graph->distance[0][2] - 6.0) < EPSILON, "Reduced run of loaded duplicates matches reference");
+        reduction_destroy(reduction);
+        graph_destroy(reference);
+        graph_destroy(graph);
+    }
+
     /* Clean up test file */
     remove(test_file);
 }
 
+void test_binary_file_operations(void) {
+    printf("\n=== Binary File I/O Tests ===\n");
+
+    Graph *graph = graph_create(4);
+    graph_add_edge(graph, 0, 1, 1.5);
+    graph_add_edge(graph, 2, 3, -2.0);
+
+    const char *test_file = "test_graph.bin";
+    ASSERT_EQUAL(SUCCESS, save_graph_to_binary_file(graph, test_file), "Binary graph save");
+    ASSERT(is_binary_graph_file(test_file), "Binary format detected");
+    ASSERT_EQUAL(SUCCESS, validate_graph_file(test_file), "Binary file validation");
+
+    Graph *loaded = load_graph_from_file(test_file);
+    ASSERT(loaded != NULL, "Binary graph loading");
+    if (loaded) {
+        ASSERT_DOUBLE_EQUAL(1.5, graph_get_edge(loaded, 0, 1), EPSILON, "Binary edge (0,1) weight");
+        ASSERT_DOUBLE_EQUAL(-2.0, graph_get_edge(loaded, 2, 3), EPSILON, "Binary edge (2,3) weight");
+        ASSERT(!graph_has_edge(loaded, 1, 0), "Binary load adds no extra edges");
+        graph_destroy(loaded);
+    }
+
+    remove(test_file);
+    graph_destroy(graph);
+}
+
+void test_batch_file_operations(void) {
+    printf("\n=== Batch File I/O Tests ===\n");
+
+    GraphBatch *batch = graph_batch_create(4, 3);
+    graph_batch_add_edge(batch, 0, 0, 1, 2.0);
+    graph_batch_add_edge(batch, 1, 2, 3, -1.5);
+    graph_batch_add_edge(batch, 2, 3, 0, 4.0);
+    graph_batch_add_edge(batch, 2, 3, 0, 6.0);
+
+    const char *test_file = "test_batch.txt";
+    ASSERT_EQUAL(SUCCESS, save_graph_batch_to_file(batch, test_file), "Batch file save");
+    ASSERT(is_graph_batch_file(test_file), "Batch format detected");
+
+    GraphBatch *loaded = load_graph_batch_from_file(test_file);
+    ASSERT(loaded != NULL && loaded->count == 3 && loaded->vertices == 4, "Batch file loading");
+    if (loaded) {
+        ASSERT_DOUBLE_EQUAL(-1.5, graph_batch_get_distance(loaded, 1, 2, 3), EPSILON, "Batch edge round trip");
+        ASSERT_DOUBLE_EQUAL(4.0, graph_batch_get_distance(loaded, 2, 3, 0), EPSILON, "Parallel edge keeps lighter weight");
+        ASSERT_DOUBLE_EQUAL(INFINITY_VALUE, graph_batch_get_distance(loaded, 0, 1, 0), EPSILON, "Batch load adds no extra edges");
+
+        floyd_warshall_execute_batch(loaded);
+        ASSERT_EQUAL(SUCCESS, save_batch_result_to_file(loaded, test_file), "Batch result save");
+        graph_batch_destroy(loaded);
+    }
+    ASSERT(!is_graph_batch_file(test_file), "Result file is not a batch file");
+
+    remove(test_file);
+    graph_batch_destroy(batch);
+}
+
+void test_checkpoint_resume(void) {
+    printf("\n=== Checkpoint Tests ===\n");
+
+    const char *checkpoint_file = "test_checkpoint.bin";
+    GraphGeneratorConfig config;
+    graph_generator_default_config(&config, GRAPH_FAMILY_ERDOS_RENYI, 40, 0.08);
+    Graph *reference = graph_generate(&config);
+    Graph *graph = graph_copy(reference);
+    floyd_warshall_execute_engine(reference, FW_ENGINE_STANDARD);
+
+    CheckpointConfig checkpoint = {checkpoint_file, 7, 0.0, 0, checkpoint_input_hash(graph)};
+    int written = 0;
+    FloydWarshallResult result = floyd_warshall_execute_checkpointed(graph, &checkpoint, &written);
+    ASSERT(result.success && written >= 1, "Checkpointed run writes checkpoints");
+
+    int next_pivot = -1;
+    uint64_t input_hash = 0;
+    Graph *saved = load_checkpoint_from_file(checkpoint_file, &next_pivot, &input_hash);
+    ASSERT(saved != NULL && saved->vertices == 40, "Load checkpoint");
+    ASSERT(next_pivot > 0 && next_pivot < 40 && next_pivot % 7 == 0, "Checkpoint taken at a pivot boundary");
+    ASSERT(input_hash == checkpoint.input_hash, "Checkpoint records the input hash");
+
+    /* Another input of the same size hashes differently */
+    config.seed++;
+    Graph *other = graph_generate(&config);
+    ASSERT(other && checkpoint_input_hash(other) != input_hash, "Different input of the same size detected");
+    graph_destroy(other);
+
+    /* Resuming from the checkpoint gives the same matrices as a full run */
+    checkpoint.start_pivot = next_pivot;
+    checkpoint.interval_pivots = 0;
+    result = floyd_warshall_execute_checkpointed(saved, &checkpoint, &written);
+    ASSERT(result.success && written == 0, "Resume from checkpoint");
+    int mismatches = 0;
+    for (int i = 0; i < 40; i++) {
+        for (int j = 0; j < 40; j++) {
+            mismatches += saved->distance[i][j] != reference->distance[i][j] ||
+                          saved->next[i][j] != reference->next[i][j] ||
+                          graph->distance[i][j] != reference->distance[i][j];
+        }
+    }
+    ASSERT_EQUAL(0, mismatches, "Checkpointed and resumed runs match reference");
+
+    /* A flipped byte fails the checksum */
+    FILE *file = fopen(checkpoint_file, "r+b");
+    if (file) {
+        fseek(file, (long)sizeof(CheckpointHeader) + 100, SEEK_SET);
+        int byte = fgetc(file);
+        fseek(file, (long)sizeof(CheckpointHeader) + 100, SEEK_SET);
+        fputc(byte ^ 0x40, file);
+        fclose(file);
+    }
+    ASSERT(load_checkpoint_from_file(checkpoint_file, &next_pivot, NULL) == NULL, "Corrupt checkpoint rejected");
+    ASSERT(load_checkpoint_from_file("no_such_checkpoint.bin", &next_pivot, NULL) == NULL,
+           "Missing checkpoint rejected");
+
+    remove(checkpoint_file);
+    graph_destroy(saved);
+    graph_destroy(graph);
+    graph_destroy(reference);
+}
+
 void run_file_io_tests(void) {
     printf("Starting File I/O Tests...\n");
     test_file_operations();
+    test_binary_file_operations();
+    test_batch_file_operations();
+    test_checkpoint_resume();
+}
+
+/* Graph generator tests */
+void test_generator_families(void) {
+    printf("\n=== Graph Generator Tests ===\n");
+
+    GraphGeneratorConfig config;
+    EdgeList first, second;
+
+    /* Exact edge count, no duplicates, reproducible for a fixed seed */
+    graph_generator_default_config(&config, GRAPH_FAMILY_ERDOS_RENYI, 50, 0.3);
+    config.seed = 7;
+    ASSERT_EQUAL(SUCCESS, graph_generate_edges(&config, &first), "Erdos-Renyi generation");
+    ASSERT_EQUAL(735, (int)first.count, "Erdos-Renyi exact edge count");
+    ASSERT_EQUAL(SUCCESS, graph_generate_edges(&config, &second), "Erdos-Renyi regeneration");
+    ASSERT(first.count == second.count &&
+           memcmp(first.edges, second.edges, (size_t)first.count * sizeof(GeneratedEdge)) == 0,
+           "Same seed produces identical edges");
+
+    Graph *graph = graph_create(50);
+    int duplicates = 0;
+    for (int64_t e = 0; e < first.count; e++) {
+        if (graph_has_edge(graph, first.edges[e].from, first.edges[e].to) ||
+            first.edges[e].from == first.edges[e].to) {
+            duplicates++;
+        }
+        graph_add_edge(graph, first.edges[e].from, first.edges[e].to, first.edges[e].weight);
+    }
+    ASSERT_EQUAL(0, duplicates, "No duplicate edges or self loops");
+    graph_destroy(graph);
+    edge_list_free(&first);
+    edge_list_free(&second);
+
+    /* Dense request takes the complement path and still hits the count */
+    config.density = 0.9;
+    ASSERT_EQUAL(SUCCESS, graph_generate_edges(&config, &first), "Dense Erdos-Renyi generation");
+    ASSERT_EQUAL(2205, (int)first.count, "Dense Erdos-Renyi exact edge count");
+    edge_list_free(&first);
+
+    /* Layered DAG only links forward */
+    graph_generator_default_config(&config, GRAPH_FAMILY_LAYERED_DAG, 40, 0.5);
+    ASSERT_EQUAL(SUCCESS, graph_generate_edges(&config, &first), "Layered DAG generation");
+    int backward = 0;
+    for (int64_t e = 0; e < first.count; e++) {
+        if (first.edges[e].from >= first.edges[e].to) {
+            backward++;
+        }
+    }
+    ASSERT(first.count > 0 && backward == 0, "Layered DAG edges point forward");
+    edge_list_free(&first);
+
+    /* Planted negative cycle is found by the solver */
+    graph_generator_default_config(&config, GRAPH_FAMILY_NEGATIVE_CYCLE, 30, 0.1);
+    graph = graph_generate(&config);
+    ASSERT(graph != NULL, "Negative cycle graph generation");
+    if (graph) {
+        FloydWarshallResult result = floyd_warshall_execute(graph);
+        ASSERT(result.has_negative_cycle, "Planted negative cycle detected");
+        graph_destroy(graph);
+    }
+
+    ASSERT(graph_family_from_name("rmat") == GRAPH_FAMILY_RMAT, "Family name lookup");
+}
+
+void run_generator_tests(void) {
+    printf("Starting Graph Generator Tests...\n");
+    test_generator_families();
+}
+
+/* Tracing tests */
+void test_trace_recording(void) {
+    printf("\n=== Trace Recording Tests ===\n");
+
+    ASSERT(!trace_is_enabled(), "Tracing disabled by default");
+
+    Graph *graph = graph_create(4);
+    graph_add_edge(graph, 0, 1, 1.0);
+    graph_add_edge(graph, 1, 2, 1.0);
+    floyd_warshall_execute_engine(graph, FW_ENGINE_STANDARD);
+    ASSERT_EQUAL(0, trace_event_count(), "No events recorded while disabled");
+
+    ASSERT_EQUAL(SUCCESS, trace_enable(8), "Enable tracing");
+    floyd_warshall_execute_engine(graph, FW_ENGINE_STANDARD);
+    /* 4 pivots + negative cycle scan, ring keeps the last 8 */
+    ASSERT_EQUAL(5, trace_event_count(), "Per-pivot and scan spans recorded");
+
+    floyd_warshall_execute_engine(graph, FW_ENGINE_STANDARD);
+    ASSERT_EQUAL(8, trace_event_count(), "Ring buffer bounded by capacity");
+
+    const char *trace_file = "test_trace.json";
+    ASSERT_EQUAL(SUCCESS, trace_write_chrome_json(trace_file), "Write Chrome trace JSON");
+
+    char buffer[256] = {0};
+    FILE *file = fopen(trace_file, "r");
+    if (file) {
+        size_t read = fread(buffer, 1, sizeof(buffer) - 1, file);
+        buffer[read] = '\0';
+        fclose(file);
+    }
+    ASSERT(strstr(buffer, "\"traceEvents\"") != NULL, "Trace file contains traceEvents");
+    ASSERT(strstr(buffer, "\"ph\":\"X\"") != NULL, "Trace file contains complete events");
+    ASSERT(strstr(buffer, "\"args\":{\"k\":") != NULL, "Pivot spans carry their pivot as k");
+
+    /* Spans whose argument is not a pivot export it under their own key */
+    trace_reset();
+    floyd_warshall_execute_engine(graph, FW_ENGINE_SMALL);
+    trace_write_chrome_json(trace_file);
+    memset(buffer, 0, sizeof(buffer));
+    file = fopen(trace_file, "r");
+    if (file) {
+        size_t read = fread(buffer, 1, sizeof(buffer) - 1, file);
+        buffer[read] = '\0';
+        fclose(file);
+    }
+    ASSERT(strstr(buffer, "\"args\":{\"kernel_size\":8}") != NULL, "Small kernel span names its argument");
+    ASSERT(strstr(buffer, "\"k\":") == NULL, "Non-pivot spans do not export k");
+
+    trace_disable();
+    ASSERT_EQUAL(0, trace_event_count(), "Disable releases trace buffers");
+
+    remove(trace_file);
+    graph_destroy(graph);
+}
+
+void run_trace_tests(void) {
+    printf("Starting Trace Tests...\n");
+    test_trace_recording();
+}
+
+/* Transitive closure tests */
+void test_transitive_closure(void) {
+    printf("\n=== Transitive Closure Tests ===\n");
+
+    ReachabilityMatrix *matrix = reachability_create(5);
+    ASSERT(matrix != NULL, "Reachability matrix creation");
+    reachability_add_edge(matrix, 0, 1);
+    reachability_add_edge(matrix, 1, 2);
+    reachability_add_edge(matrix, 3, 4);
+    ASSERT_EQUAL(ERROR_INVALID_INPUT, reachability_add_edge(matrix, 0, 5), "Out of range edge rejected");
+
+    TransitiveClosureResult result = transitive_closure_execute(matrix);
+    ASSERT(result.success, "Transitive closure execution success");
+    ASSERT(reachability_is_reachable(matrix, 0, 2), "0 reaches 2 transitively");
+    ASSERT(reachability_is_reachable(matrix, 4, 4), "Vertex reaches itself");
+    ASSERT(!reachability_is_reachable(matrix, 2, 0), "2 does not reach 0");
+    ASSERT(!reachability_is_reachable(matrix, 0, 3), "No path across components");
+    /* 5 reflexive pairs + (0,1) (0,2) (1,2) (3,4) */
+    ASSERT_EQUAL(9, (int)result.reachable_pairs, "Reachable pair count");
+    reachability_destroy(matrix);
+
+    /* Agrees with the weighted kernel on a graph wider than one word */
+    GraphGeneratorConfig config;
+    graph_generator_default_config(&config, GRAPH_FAMILY_ERDOS_RENYI, 150, 0.01);
+    Graph *graph = graph_generate(&config);
+    matrix = reachability_from_graph(graph);
+
+    /* Streaming the file into bits gives the same matrix as the loaded graph */
+    const char *test_file = "test_reachability.bin";
+    save_graph_to_binary_file(graph, test_file);
+    ReachabilityMatrix *streamed = load_reachability_from_file(test_file);
+    ASSERT(streamed != NULL && streamed->vertices == matrix->vertices &&
+           memcmp(streamed->bits, matrix->bits,
+                  (size_t)matrix->vertices * matrix->words_per_row * sizeof(uint64_t)) == 0,
+           "Reachability streamed from file matches loaded graph");
+    reachability_destroy(streamed);
+    remove(test_file);
+    ASSERT(load_reachability_from_file("no_such_graph.txt") == NULL, "Missing reachability file rejected");
+
+    transitive_closure_execute(matrix);
+    floyd_warshall_execute(graph);
+
+    int mismatches = 0;
+    for (int i = 0; i < graph->vertices; i++) {
+        for (int j = 0; j < graph->vertices; j++) {
+            if (reachability_is_reachable(matrix, i, j) != graph_has_edge(graph, i, j)) {
+                mismatches++;
+            }
+        }
+    }
+    ASSERT_EQUAL(0, mismatches, "Closure matches Floyd-Warshall reachability");
+
+    reachability_destroy(matrix);
+    graph_destroy(graph);
+}
+
+void run_transitive_closure_tests(void) {
+    printf("Starting Transitive Closure Tests...\n");
+    test_transitive_closure();
+}
+
+/* Min-plus GEMM tests */
+void test_minplus_gemm(void) {
+    printf("\n=== Min-Plus GEMM Tests ===\n");
+
+    /* Sizes straddle the register and KC blocking; views start at offsets */
+    int m = 37, n = 53, k = MINPLUS_KC + 34;
+    int size = k + 8;
+    Graph *a = graph_create(size);
+    Graph *b = graph_create(size);
+    Graph *c = graph_create(size);
+    Graph *expected = graph_create(size);
+    ASSERT(a && b && c && expected, "GEMM operand creation");
+
+    unsigned int state = 12345;
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < size; j++) {
+            state = state * 1103515245u + 12345u;
+            int draw = (int)((state >> 16) % 100);
+            a->distance[i][j] = (draw < 20) ? INFINITY_VALUE : (double)(draw - 30);
+            a->next[i][j] = i * size + j;
+            state = state * 1103515245u + 12345u;
+            draw = (int)((state >> 16) % 100);
+            b->distance[i][j] = (draw < 20) ? INFINITY_VALUE : (double)(draw - 30);
+            c->distance[i][j] = (draw % 3 == 0) ? INFINITY_VALUE : (double)(draw * 2);
+            c->next[i][j] = -1;
+            expected->distance[i][j] = c->distance[i][j];
+            expected->next[i][j] = -1;
+        }
+    }
+
+    /* Reference: first strictly better pivot wins */
+    for (int i = 0; i < m; i++) {
+        for (int j = 0; j < n; j++) {
+            for (int p = 0; p < k; p++) {
+                double left = a->distance[3 + i][5 + p];
+                double right = b->distance[7 + p][2 + j];
+                if (left < INFINITY_VALUE && right < INFINITY_VALUE &&
+                    left + right < expected->distance[1 + i][4 + j]) {
+                    expected->distance[1 + i][4 + j] = left + right;
+                    expected->next[1 + i][4 + j] = a->next[3 + i][5 + p];
+                }
+            }
+        }
+    }
+
+    MinPlusView view_a = {a->distance, a->next, 3, 5};
+    MinPlusView view_b = {b->distance, NULL, 7, 2};
+    MinPlusView view_c = {c->distance, c->next, 1, 4};
+    ASSERT_EQUAL(SUCCESS, minplus_gemm(m, n, k, &view_a, &view_b, &view_c), "GEMM execution success");
+
+    int mismatches = 0;
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < size; j++) {
+            if (c->distance[i][j] != expected->distance[i][j] || c->next[i][j] != expected->next[i][j]) {
+                mismatches++;
+            }
+        }
+    }
+    ASSERT_EQUAL(0, mismatches, "GEMM matches naive min-plus product");
+
+    ASSERT_EQUAL(SUCCESS, minplus_gemm(0, n, k, &view_a, &view_b, &view_c), "Empty product is a no-op");
+    ASSERT_EQUAL(ERROR_NULL_POINTER, minplus_gemm(m, n, k, NULL, &view_b, &view_c), "NULL operand rejected");
+
+    graph_destroy(a);
+    graph_destroy(b);
+    graph_destroy(c);
+    graph_destroy(expected);
+}
+
+void run_minplus_gemm_tests(void) {
+    printf("Starting Min-Plus GEMM Tests...\n");
+    test_minplus_gemm();
+}
+
+/* Undirected (packed symmetric) tests */
+void test_symmetric_engine(void) {
+    printf("\n=== Symmetric Engine Tests ===\n");
+
+    const int n = 60;
+    GraphGeneratorConfig config;
+    EdgeList edges;
+    graph_generator_default_config(&config, GRAPH_FAMILY_ERDOS_RENYI, n, 0.05);
+    config.seed = 11;
+    ASSERT_EQUAL(SUCCESS, graph_generate_edges(&config, &edges), "Undirected edge generation");
+
+    /* The same edges both ways in a directed graph serve as the reference */
+    SymmetricGraph *packed = symmetric_graph_create(n);
+    SymmetricGraph *original = symmetric_graph_create(n);
+    Graph *reference = graph_create(n);
+    for (int64_t e = 0; e < edges.count; e++) {
+        int u = edges.edges[e].from, v = edges.edges[e].to;
+        double w = edges.edges[e].weight;
+        symmetric_graph_add_edge(packed, u, v, w);
+        symmetric_graph_add_edge(original, u, v, w);
+        if (w < graph_get_edge(reference, u, v)) {
+            graph_add_edge(reference, u, v, w);
+            graph_add_edge(reference, v, u, w);
+        }
+    }
+    edge_list_free(&edges);
+
+    ASSERT_DOUBLE_EQUAL(symmetric_graph_get_edge(packed, 3, 7), symmetric_graph_get_edge(packed, 7, 3),
+                        EPSILON, "Packed edge lookup is symmetric");
+
+    FloydWarshallResult result = floyd_warshall_execute_symmetric(packed);
+    floyd_warshall_execute(reference);
+    ASSERT(result.success && !result.has_negative_cycle, "Symmetric engine execution");
+
+    int mismatches = 0;
+    int bad_paths = 0;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            double expected = reference->distance[i][j];
+            if (fabs(expected - floyd_warshall_get_distance_symmetric(packed, i, j)) > 1e-6) {
+                mismatches++;
+            }
+
+            /* Each path must run i -> j over original edges and add up to the distance */
+            int path_length;
+            int *path = floyd_warshall_get_path_symmetric(packed, i, j, &path_length);
+            if (expected >= INFINITY_VALUE) {
+                bad_paths += path != NULL;
+            } else if (!path || path[0] != i || path[path_length - 1] != j) {
+                bad_paths++;
+            } else {
+                double weight = 0.0;
+                for (int t = 0; t + 1 < path_length; t++) {
+                    weight += symmetric_graph_get_edge(original, path[t], path[t + 1]);
+                }
+                bad_paths += fabs(weight - expected) > 1e-6;
+            }
+            free(path);
+        }
+    }
+    ASSERT_EQUAL(0, mismatches, "Symmetric distances match directed reference");
+    ASSERT_EQUAL(0, bad_paths, "Symmetric paths are valid and shortest");
+
+    /* Packed storage holds the triangle only */
+    ASSERT_EQUAL(n * (n + 1) / 2, (int)triangle_size(n), "Packed triangle entry count");
+
+    /* A negative undirected edge is a negative cycle */
+    SymmetricGraph *negative = symmetric_graph_create(3);
+    symmetric_graph_add_edge(negative, 0, 1, 2.0);
+    symmetric_graph_add_edge(negative, 1, 2, -1.0);
+    result = floyd_warshall_execute_symmetric(negative);
+    ASSERT(result.success && result.has_negative_cycle, "Negative undirected edge detected");
+
+    symmetric_graph_destroy(negative);
+    symmetric_graph_destroy(original);
+    symmetric_graph_destroy(packed);
+    graph_destroy(reference);
+}
+
+void test_symmetric_file_io(void) {
+    printf("\n=== Undirected File I/O Tests ===\n");
+
+    SymmetricGraph *graph = symmetric_graph_create(4);
+    symmetric_graph_add_edge(graph, 0, 1, 5.0);
+    symmetric_graph_add_edge(graph, 2, 1, 3.0);
+    symmetric_graph_add_edge(graph, 2, 3, 1.5);
+
+    GraphFileFormat formats[2] = {GRAPH_FORMAT_TEXT, GRAPH_FORMAT_BINARY};
+    const char *files[2] = {"test_undirected.txt", "test_undirected.bin"};
+    for (int f = 0; f < 2; f++) {
+        ASSERT_EQUAL(SUCCESS, save_symmetric_graph_to_file(graph, files[f], formats[f]), "Undirected graph save");
+        ASSERT(is_undirected_graph_file(files[f]), "Undirected flag detected");
+        ASSERT_EQUAL(SUCCESS, validate_graph_file(files[f]), "Undirected file validation");
+
+        SymmetricGraph *loaded = load_symmetric_graph_from_file(files[f]);
+        ASSERT(loaded != NULL, "Undirected graph loading");
+        if (loaded) {
+            ASSERT_DOUBLE_EQUAL(3.0, symmetric_graph_get_edge(loaded, 1, 2), EPSILON, "Undirected edge round trip");
+            ASSERT(!symmetric_graph_has_edge(loaded, 0, 3), "Undirected load adds no extra edges");
+            symmetric_graph_destroy(loaded);
+        }
+
+        /* The directed loader adds each undirected edge both ways */
+        Graph *directed = load_graph_from_file(files[f]);
+        ASSERT(directed != NULL && graph_has_edge(directed, 1, 0) && graph_has_edge(directed, 0, 1),
+               "Directed load of undirected file adds both directions");
+        graph_destroy(directed);
+        ReachabilityMatrix *reach = load_reachability_from_file(files[f]);
+        ASSERT(reach != NULL && reachability_is_reachable(reach, 1, 2) && reachability_is_reachable(reach, 2, 1) &&
+               !reachability_is_reachable(reach, 0, 3), "Reachability load of undirected file sets both directions");
+        reachability_destroy(reach);
+        remove(files[f]);
+    }
+
+    /* Directed files are not reported as undirected */
+    Graph *plain = graph_create(2);
+    graph_add_edge(plain, 0, 1, 1.0);
+    save_graph_to_binary_file(plain, files[1]);
+    ASSERT(!is_undirected_graph_file(files[1]), "Directed binary file has no undirected flag");
+    remove(files[1]);
+    graph_destroy(plain);
+
+    floyd_warshall_execute_symmetric(graph);
+    ASSERT_EQUAL(SUCCESS, save_symmetric_result_to_file(graph, files[0]), "Undirected result save");
+    remove(files[0]);
+    symmetric_graph_destroy(graph);
+}
+
+void run_symmetric_tests(void) {
+    printf("Starting Undirected Graph Tests...\n");
+    test_symmetric_engine();
+    test_symmetric_file_io();
 }
 
 /* Main test function */
@@ -207,6 +2200,11 @@ int main(void) {
     run_floyd_warshall_tests();
     run_memory_tests();
     run_file_io_tests();
+    run_trace_tests();
+    run_generator_tests();
+    run_transitive_closure_tests();
+    run_minplus_gemm_tests();
+    run_symmetric_tests();
 
     /* Print test summary */
     test_summary();